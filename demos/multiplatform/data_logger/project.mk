@@ -0,0 +1 @@
+PLATFORM = linux
@@ -0,0 +1,251 @@
+// Benchmarks the DataLogger against logging each record with its own
+// f_write() call. Intended to be run on the linux platform where the FAT
+// volume is stored in a file on the host.
+#include <ff.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+
+#include "L1_Peripheral/storage.hpp"
+#include "L3_Application/data_logger.hpp"
+#include "L3_Application/fatfs.hpp"
+#include "utility/log.hpp"
+#include "utility/stopwatch.hpp"
+
+namespace
+{
+/// Storage device with 512 byte blocks backed by a file on the host.
+class FileStorage final : public sjsu::Storage
+{
+ public:
+  static constexpr size_t kBlockSize = 512;
+
+  FileStorage(const char * path, size_t capacity)
+      : path_(path), capacity_(capacity)
+  {
+  }
+
+  Type GetMemoryType() override
+  {
+    return Type::kSD;
+  }
+
+  sjsu::Returns<void> Initialize() override
+  {
+    if (file_ != nullptr)
+    {
+      return {};
+    }
+
+    file_ = fopen(path_, "w+b");
+    if (file_ == nullptr)
+    {
+      return Error(sjsu::Status::kDeviceNotFound,
+                   "Could not create disk image file.");
+    }
+    return {};
+  }
+
+  sjsu::Returns<void> Enable() override
+  {
+    return {};
+  }
+
+  bool IsMediaPresent() override
+  {
+    return true;
+  }
+
+  bool IsReadOnly() override
+  {
+    return false;
+  }
+
+  units::data::byte_t GetCapacity() override
+  {
+    return units::data::byte_t(static_cast<double>(capacity_));
+  }
+
+  units::data::byte_t GetBlockSize() override
+  {
+    return units::data::byte_t(kBlockSize);
+  }
+
+  sjsu::Returns<void> Erase(uint32_t, size_t) override
+  {
+    return {};
+  }
+
+  sjsu::Returns<void> Write(uint32_t block_address,
+                            const void * data,
+                            size_t size) override
+  {
+    fseek(file_, static_cast<long>(block_address * kBlockSize), SEEK_SET);
+    if (fwrite(data, 1, size, file_) != size || fflush(file_) != 0)
+    {
+      return Error(sjsu::Status::kBusError, "Disk image write failed.");
+    }
+    return {};
+  }
+
+  sjsu::Returns<void> Read(uint32_t block_address,
+                           void * data,
+                           size_t size) override
+  {
+    fseek(file_, static_cast<long>(block_address * kBlockSize), SEEK_SET);
+    size_t bytes_read = fread(data, 1, size, file_);
+    // Unwritten parts of the image file read back as zeros.
+    std::fill(static_cast<uint8_t *>(data) + bytes_read,
+              static_cast<uint8_t *>(data) + size, 0);
+    return {};
+  }
+
+  sjsu::Returns<void> Disable() override
+  {
+    return {};
+  }
+
+ private:
+  const char * path_;
+  size_t capacity_;
+  FILE * file_ = nullptr;
+};
+
+/// A typical inertial measurement sample.
+struct Sample_t
+{
+  uint64_t timestamp;
+  std::array<int16_t, 3> acceleration;
+  std::array<int16_t, 3> gyroscope;
+  std::array<int16_t, 3> magnetometer;
+  uint16_t status;
+};
+
+constexpr size_t kClusterSize   = 32 * 1024;
+constexpr size_t kLogSize       = 32 * 1024 * 1024;
+constexpr uint32_t kSampleCount = kLogSize / sizeof(Sample_t);
+
+Sample_t MakeSample(uint32_t index)
+{
+  Sample_t sample     = {};
+  sample.timestamp    = index;
+  sample.status       = static_cast<uint16_t>(index);
+  sample.acceleration = { 1, 2, 3 };
+  return sample;
+}
+
+void PrintResult(const char * name,
+                 uint64_t bytes,
+                 std::chrono::nanoseconds total,
+                 std::chrono::nanoseconds worst)
+{
+  std::chrono::duration<float> seconds = total;
+  float megabytes_per_second =
+      (static_cast<float>(bytes) / seconds.count()) / 1'000'000.0f;
+
+  sjsu::LogInfo("%-24s %8.2f MB/s, worst write latency = %" PRId32 "us", name,
+                static_cast<double>(megabytes_per_second),
+                static_cast<int32_t>(worst.count() / 1000));
+}
+
+/// Log every sample with an individual f_write() call.
+void BenchmarkSmallWrites()
+{
+  FIL file;
+  f_open(&file, "SMALL.BIN", FA_WRITE | FA_CREATE_ALWAYS);
+
+  sjsu::StopWatch stopwatch;
+  std::chrono::nanoseconds total = 0ns;
+  std::chrono::nanoseconds worst = 0ns;
+
+  for (uint32_t i = 0; i < kSampleCount; i++)
+  {
+    Sample_t sample = MakeSample(i);
+    UINT written    = 0;
+
+    stopwatch.Start();
+    f_write(&file, &sample, sizeof(sample), &written);
+    auto latency = stopwatch.Stop();
+
+    total += latency;
+    worst = std::max(worst, latency);
+  }
+
+  f_close(&file);
+  f_unlink("SMALL.BIN");
+
+  PrintResult("f_write() per sample:", kSampleCount * sizeof(Sample_t), total,
+              worst);
+}
+
+/// Log every sample with the DataLogger.
+void BenchmarkDataLogger()
+{
+  static sjsu::DataLogger<kClusterSize> logger(
+      { .prefix = "IMU", .file_size = 8 * 1024 * 1024 });
+
+  if (!logger.Open())
+  {
+    sjsu::LogError("Failed to open data logger!");
+    return;
+  }
+
+  for (uint32_t i = 0; i < kSampleCount; i++)
+  {
+    Sample_t sample = MakeSample(i);
+    logger.Log(&sample, sizeof(sample));
+    if (auto result = logger.Service(); !result)
+    {
+      sjsu::LogError("%s", result.error()->message);
+      break;
+    }
+  }
+  logger.Close();
+
+  const auto & statistics = logger.GetStatistics();
+  PrintResult("DataLogger:", statistics.bytes_written, statistics.write_time,
+              statistics.worst_write_latency);
+  sjsu::LogInfo("DataLogger created %" PRIu32 " files and dropped %" PRIu32
+                " records",
+                statistics.files_created, statistics.dropped_records);
+}
+}  // namespace
+
+int main()
+{
+  sjsu::LogInfo("Data Logger Benchmark Starting...");
+
+  static FileStorage disk("data_logger.img", 128 * 1024 * 1024);
+  sjsu::RegisterFatFsDrive(&disk);
+
+  static std::array<uint8_t, FF_MAX_SS> work;
+  static FATFS fat_fs;
+
+  sjsu::LogInfo("Formatting 128 MB disk image...");
+  FRESULT result = f_mkfs("", FM_ANY, kClusterSize, work.data(), work.size());
+  if (result != FR_OK)
+  {
+    sjsu::LogError("f_mkfs(): %s", sjsu::Stringify(result));
+    return -1;
+  }
+
+  result = f_mount(&fat_fs, "", 1);
+  if (result != FR_OK)
+  {
+    sjsu::LogError("f_mount(): %s", sjsu::Stringify(result));
+    return -1;
+  }
+
+  sjsu::LogInfo("Logging %" PRIu32 " samples of %zu bytes each...",
+                kSampleCount, sizeof(Sample_t));
+
+  BenchmarkSmallWrites();
+  BenchmarkDataLogger();
+
+  f_mount(nullptr, "", 0);
+  return 0;
+}
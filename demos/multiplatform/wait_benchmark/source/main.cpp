@@ -0,0 +1,80 @@
+// Measures how many times per second a Wait() polling loop can check its
+// condition, comparing sjsu::Wait() against the previous implementation that
+// used std::function for both the uptime source and the condition. Intended to
+// be run on the linux platform.
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <functional>
+
+#include "utility/log.hpp"
+#include "utility/time.hpp"
+
+namespace
+{
+constexpr std::chrono::nanoseconds kPollDuration = 1s;
+
+/// Copy of the uptime function and Wait() that used std::function.
+std::function<std::chrono::nanoseconds(void)> legacy_uptime;
+
+sjsu::Status LegacyWait(std::chrono::nanoseconds timeout,
+                        std::function<bool()> is_done)
+{
+  std::chrono::nanoseconds timeout_time = legacy_uptime() + timeout;
+
+  sjsu::Status status = sjsu::Status::kTimedOut;
+  while (legacy_uptime() <= timeout_time)
+  {
+    if (is_done())
+    {
+      status = sjsu::Status::kSuccess;
+      break;
+    }
+  }
+  return status;
+}
+
+/// Simulates a peripheral status register that never becomes ready, so each
+/// wait polls for the whole duration.
+volatile uint32_t status_register = 0;
+
+void PrintResult(const char * name, uint64_t iterations)
+{
+  std::chrono::duration<float> seconds = kPollDuration;
+  float iterations_per_second = static_cast<float>(iterations) / seconds.count();
+
+  sjsu::LogInfo("%-32s %12.0f iterations/s", name,
+                static_cast<double>(iterations_per_second));
+}
+}  // namespace
+
+int main()
+{
+  sjsu::LogInfo("Wait() Benchmark Starting...");
+
+  legacy_uptime = sjsu::internal::uptime_function;
+
+  uint64_t legacy_iterations = 0;
+  LegacyWait(kPollDuration, [&legacy_iterations]() {
+    legacy_iterations++;
+    return (status_register & 1) != 0;
+  });
+
+  uint64_t iterations = 0;
+  sjsu::Wait(kPollDuration, [&iterations]() {
+    iterations++;
+    return (status_register & 1) != 0;
+  });
+
+  PrintResult("std::function Wait():", legacy_iterations);
+  PrintResult("sjsu::Wait():", iterations);
+
+  if (legacy_iterations != 0)
+  {
+    sjsu::LogInfo("Speed up = %.2fx",
+                  static_cast<double>(iterations) /
+                      static_cast<double>(legacy_iterations));
+  }
+
+  return 0;
+}
@@ -10,6 +10,7 @@
 #include "L3_Application/commands/common.hpp"
 #include "L3_Application/commands/i2c_command.hpp"
 #include "L3_Application/commands/arm_system_command.hpp"
+#include "L3_Application/commands/irq_command.hpp"
 #include "L3_Application/commands/rtos_command.hpp"
 #include "utility/log.hpp"
 #include "utility/rtos.hpp"
@@ -73,6 +74,14 @@ int main()
   sjsu::LogInfo("Adding sjsu::rtos command to command line...");
   ci.AddCommand(&rtos_command);
 
+  // The platform interrupt controller is only available once the platform
+  // startup code has run, so the irq command is created here rather than
+  // alongside the other commands.
+  sjsu::LogInfo("Adding irq command to command line...");
+  static sjsu::IrqCommand irq_command(
+      sjsu::InterruptController::GetPlatformController());
+  ci.AddCommand(&irq_command);
+
   sjsu::LogInfo("Initializing CommandLine object...");
   ci.Initialize();
 
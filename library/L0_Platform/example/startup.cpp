@@ -25,9 +25,9 @@ namespace
 
 // 6. Define an milliseconds Uptime function
 // ------------------------------------------
-std::chrono::microseconds ExampleUptime()
+std::chrono::nanoseconds ExampleUptime()
 {
-  return 0us;
+  return 0ns;
 }
 // 7. Define a function for stdout
 //    Typically uses UART0 or USB CDC
@@ -117,6 +117,15 @@ extern uint32_t ThreadRuntimeCounter();
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
 #define portGET_RUN_TIME_COUNTER_VALUE() (uint32_t)(ThreadRuntimeCounter())
 
+/* SJSU-Dev: Record task switches with the trace recorder. The hook is defined
+in freertos_common.cpp and does nothing unless SJ2_ENABLE_TRACE is true. */
+#ifdef __cplusplus
+extern "C"
+#endif
+void SjsuTraceTaskSwitchedIn(const char * task_name);
+#define traceTASK_SWITCHED_IN() \
+  SjsuTraceTaskSwitchedIn(pxCurrentTCB->pcTaskName)
+
 /*-----------------------------------------------------------
  * Macros required to setup the timer for the run time stats.
  *-----------------------------------------------------------*/
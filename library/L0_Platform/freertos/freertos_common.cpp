@@ -1,6 +1,8 @@
 #include <FreeRTOS.h>
 #include <task.h>
 #include <iterator>
+
+#include "utility/trace_recorder.hpp"
 // Implementation of vApplicationGetIdleTaskMemory required when
 // The function is called to statically create the idle task when
 // vTaskStartScheduler is invoked.
@@ -31,3 +33,10 @@ extern "C" void vApplicationGetTimerTaskMemory( // NOLINT
     *ppx_timer_task_stack_buffer = timer_task_stack;
     *pul_timer_task_stack_size = std::size(timer_task_stack);
 }
+// Called by the kernel through traceTASK_SWITCHED_IN() each time a task starts
+// running. The name lives in the task's control block, so tasks should not be
+// deleted while a trace is being recorded.
+extern "C" void SjsuTraceTaskSwitchedIn(const char * task_name)  // NOLINT
+{
+  sjsu::trace::Record(sjsu::trace::Type::kTaskSwitch, task_name);
+}
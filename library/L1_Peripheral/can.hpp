@@ -47,6 +47,42 @@ class Can
     bool is_remote_request = false;
   };
 
+  /// Types of bus error, as signalled by the error frames of the CAN
+  /// specification.
+  enum class BusError : uint8_t
+  {
+    /// A node read back a different bit than it sent.
+    kBit = 0,
+    /// A fixed format field, such as a delimiter, held an illegal bit.
+    kForm,
+    /// More than 5 consecutive bits had the same value.
+    kStuff,
+    /// CRC, acknowledge and every other error.
+    kOther,
+    kNumberOfErrors,
+  };
+
+  /// Number of bit positions in the arbitration field of an extended frame,
+  /// where arbitration can be lost.
+  static constexpr size_t kArbitrationBits = 32;
+
+  /// Error counters and error history of a CAN controller.
+  struct ErrorStatistics_t
+  {
+    /// Transmit error counter (TEC). The controller is error passive above 127.
+    uint8_t transmit_error_count = 0;
+    /// Receive error counter (REC). The controller is error passive above 127.
+    uint8_t receive_error_count = 0;
+    /// True if the controller is bus off.
+    bool bus_off = false;
+    /// Number of bus errors of each type, indexed by BusError.
+    std::array<uint32_t, static_cast<size_t>(BusError::kNumberOfErrors)>
+        bus_errors = {};
+    /// Number of times arbitration was lost at each bit of the arbitration
+    /// field, where 0 is the first (most significant) bit of the ID.
+    std::array<uint32_t, kArbitrationBits> arbitration_lost = {};
+  };
+
   /// Standard baud rate for most CANBUS networks
   static constexpr units::frequency::hertz_t kStandardBaudRate = 100'000_Hz;
 
@@ -94,6 +130,18 @@ class Can
   virtual void SetBaudRate(
       units::frequency::hertz_t baud = kStandardBaudRate) const = 0;
 
+  /// Bus errors and arbitration losses are counted from when the driver
+  /// starts counting them, which depends on the implementation.
+  ///
+  /// The default implementation only reports whether the controller is bus
+  /// off, for drivers that cannot read their controller's error state.
+  ///
+  /// @return the controller's error counters and error history.
+  virtual ErrorStatistics_t GetErrorStatistics() const
+  {
+    return ErrorStatistics_t{ .bus_off = IsBusOff() };
+  }
+
   // ===========================================================================
   // Utility Methods
   // ===========================================================================
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "L1_Peripheral/can.hpp"
+
+namespace sjsu
+{
+/// An inclusive range of CAN IDs. A single ID has equal low and high bounds.
+struct CanIdRange_t
+{
+  /// Lowest ID in the range.
+  uint32_t low;
+  /// Highest ID in the range.
+  uint32_t high;
+};
+
+/// A list of CAN IDs and ID ranges to accept, for each ID format.
+///
+/// Platforms with hardware acceptance filters, such as lpc40xx::Can, compile a
+/// CanFilter into their filter tables. Everywhere else, IsAccepted() filters
+/// messages in software: standard IDs with a bitset, extended IDs with a
+/// binary search of the sorted ranges.
+///
+/// Every method is constexpr, so a filter can be built at compile time:
+///
+///    constexpr auto kFilter = sjsu::CanFilter<4>()
+///                                 .Accept(0x100)
+///                                 .AcceptRange(0x200, 0x2FF)
+///                                 .AcceptExtended(0x18FF'5080);
+///    static_assert(kFilter.IsValid());
+///
+/// @tparam kCapacity - maximum number of IDs and ranges of each format.
+template <size_t kCapacity>
+class CanFilter
+{
+ public:
+  /// Largest standard (11-bit) ID.
+  static constexpr uint32_t kMaxStandardId = 0x7FF;
+  /// Largest extended (29-bit) ID.
+  static constexpr uint32_t kMaxExtendedId = 0x1FFF'FFFF;
+
+  /// An inclusive range of IDs.
+  using Range_t = CanIdRange_t;
+
+  /// Accept a standard ID.
+  ///
+  /// @param id - 11-bit ID to accept.
+  constexpr CanFilter & Accept(uint32_t id)
+  {
+    return AcceptRange(id, id);
+  }
+
+  /// Accept every standard ID from low to high, inclusive.
+  ///
+  /// @param low - lowest 11-bit ID to accept.
+  /// @param high - highest 11-bit ID to accept.
+  constexpr CanFilter & AcceptRange(uint32_t low, uint32_t high)
+  {
+    if (high > kMaxStandardId || !Insert(standard_, standard_count_, low, high))
+    {
+      valid_ = false;
+      return *this;
+    }
+    for (uint32_t id = low; id <= high; id++)
+    {
+      standard_bits_[id / 32] |= (1U << (id % 32));
+    }
+    return *this;
+  }
+
+  /// Accept an extended ID.
+  ///
+  /// @param id - 29-bit ID to accept.
+  constexpr CanFilter & AcceptExtended(uint32_t id)
+  {
+    return AcceptExtendedRange(id, id);
+  }
+
+  /// Accept every extended ID from low to high, inclusive.
+  ///
+  /// @param low - lowest 29-bit ID to accept.
+  /// @param high - highest 29-bit ID to accept.
+  constexpr CanFilter & AcceptExtendedRange(uint32_t low, uint32_t high)
+  {
+    if (high > kMaxExtendedId || !Insert(extended_, extended_count_, low, high))
+    {
+      valid_ = false;
+    }
+    return *this;
+  }
+
+  /// @return false if an ID was out of range, a range's low bound was above
+  ///         its high bound, or more than kCapacity IDs and ranges of a format
+  ///         were added. The invalid entries are not part of the filter.
+  constexpr bool IsValid() const
+  {
+    return valid_;
+  }
+
+  /// @param message - received message.
+  /// @return true if the message's ID is accepted by this filter.
+  constexpr bool IsAccepted(const Can::Message_t & message) const
+  {
+    if (message.format == Can::Message_t::Format::kStandard)
+    {
+      if (message.id > kMaxStandardId)
+      {
+        return false;
+      }
+      return standard_bits_[message.id / 32] & (1U << (message.id % 32));
+    }
+
+    // Binary search for the last range whose low bound is at or below the ID.
+    // Ranges may overlap, so check every earlier range that could still hold
+    // the ID.
+    size_t low  = 0;
+    size_t high = extended_count_;
+    while (low < high)
+    {
+      size_t middle = low + (high - low) / 2;
+      if (extended_[middle].low <= message.id)
+      {
+        low = middle + 1;
+      }
+      else
+      {
+        high = middle;
+      }
+    }
+    for (size_t i = low; i > 0; i--)
+    {
+      if (message.id <= extended_[i - 1].high)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// @return the accepted standard IDs and ranges, sorted by low bound.
+  constexpr std::span<const Range_t> GetStandard() const
+  {
+    return { standard_.data(), standard_count_ };
+  }
+
+  /// @return the accepted extended IDs and ranges, sorted by low bound.
+  constexpr std::span<const Range_t> GetExtended() const
+  {
+    return { extended_.data(), extended_count_ };
+  }
+
+ private:
+  /// Insert a range, keeping the list sorted by low bound, then by high
+  /// bound. Duplicates are only stored once.
+  ///
+  /// @return false if the range is invalid or the list is full.
+  static constexpr bool Insert(std::array<Range_t, kCapacity> & list,
+                               size_t & count,
+                               uint32_t low,
+                               uint32_t high)
+  {
+    if (low > high)
+    {
+      return false;
+    }
+
+    size_t position = 0;
+    while (position < count &&
+           (list[position].low < low ||
+            (list[position].low == low && list[position].high < high)))
+    {
+      position++;
+    }
+
+    if (position < count && list[position].low == low &&
+        list[position].high == high)
+    {
+      return true;
+    }
+
+    if (count == kCapacity)
+    {
+      return false;
+    }
+
+    for (size_t i = count; i > position; i--)
+    {
+      list[i] = list[i - 1];
+    }
+    list[position] = Range_t{ .low = low, .high = high };
+    count++;
+    return true;
+  }
+
+  std::array<uint32_t, (kMaxStandardId + 1) / 32> standard_bits_ = {};
+  std::array<Range_t, kCapacity> standard_                        = {};
+  std::array<Range_t, kCapacity> extended_                        = {};
+  size_t standard_count_                                          = 0;
+  size_t extended_count_                                          = 0;
+  bool valid_                                                     = true;
+};
+}  // namespace sjsu
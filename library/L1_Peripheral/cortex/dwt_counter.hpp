@@ -17,12 +17,17 @@ class DwtCounter
   static inline CoreDebug_Type * core = CoreDebug;
 
   /// Initialize the debug core to enable counting and then being counting on
-  /// the DWT.
+  /// the DWT. The counter is only cleared the first time it is enabled, as
+  /// the counter is shared by every DwtCounter and clearing it would make the
+  /// system uptime jump backwards.
   void Initialize()
   {
     core->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
-    dwt->CYCCNT = 0;
-    dwt->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    if (!(dwt->CTRL & DWT_CTRL_CYCCNTENA_Msk))
+    {
+      dwt->CYCCNT = 0;
+      dwt->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
   }
 
   /// Return the current number of ticks. Note that this is typically 2x the
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+
+#include "L1_Peripheral/cortex/interrupt.hpp"
+#include "L1_Peripheral/sampling_profiler.hpp"
+#include "L1_Peripheral/timer.hpp"
+#include "utility/status.hpp"
+#include "utility/units.hpp"
+
+namespace sjsu
+{
+namespace cortex
+{
+/// Sampling profiler for Cortex M processors. A hardware timer interrupts the
+/// processor at the sample rate, and the timer's handler reads the program
+/// counter of the interrupted code from its exception frame.
+///
+/// The timer interrupt is given the highest priority so that it also samples
+/// other interrupt handlers and code that masks interrupts with BASEPRI, such
+/// as FreeRTOS critical sections. Code that disables every interrupt is
+/// sampled at the instruction that re-enables them.
+///
+/// Usage:
+///
+///    sjsu::lpc40xx::Timer timer(sjsu::lpc40xx::Timer::Peripheral::kTimer3);
+///    sjsu::cortex::SamplingProfiler profiler(timer);
+///    profiler.Start(1_kHz);
+class SamplingProfiler final : public sjsu::SamplingProfiler
+{
+ public:
+  /// Frequency the timer counts at.
+  static constexpr units::frequency::hertz_t kTimerFrequency = 1_MHz;
+  /// Priority of the timer interrupt.
+  static constexpr int32_t kPriority = 0;
+
+  /// @param timer - timer dedicated to the profiler.
+  explicit constexpr SamplingProfiler(const sjsu::Timer & timer)
+      : timer_(timer)
+  {
+  }
+
+  Status Start(units::frequency::hertz_t sample_rate) override
+  {
+    if (sample_rate <= 0_Hz || sample_rate > kTimerFrequency / 2)
+    {
+      return Status::kInvalidParameters;
+    }
+
+    Status status =
+        timer_.Initialize(kTimerFrequency, [this]() { Sample(); }, kPriority);
+    if (!IsOk(status))
+    {
+      return status;
+    }
+
+    uint32_t period = kTimerFrequency / sample_rate;
+    timer_.SetMatchBehavior(period, Timer::MatchAction::kInterruptRestart, 0);
+
+    capture_interrupted_frame = true;
+    timer_.Start();
+    return Status::kSuccess;
+  }
+
+  void Stop() override
+  {
+    timer_.Stop();
+    capture_interrupted_frame = false;
+  }
+
+ private:
+  void Sample()
+  {
+    const ExceptionFrame_t * frame = interrupted_frame;
+    if (frame != nullptr)
+    {
+      samples_.Record(frame->pc);
+    }
+  }
+
+  const sjsu::Timer & timer_;
+};
+}  // namespace cortex
+}  // namespace sjsu
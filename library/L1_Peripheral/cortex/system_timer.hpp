@@ -2,6 +2,10 @@
 // up the SystemTimer.
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <functional>
 
 #include "L0_Platform/arm_cortex/m4/core_cm4.h"
@@ -49,15 +53,55 @@ class SystemTimer final : public sjsu::SystemTimer
   /// Higher precision counter that counts on every system clock cycle
   inline static DwtCounter dwt_counter;
 
-  /// Holds the converstion from ticks to nanoseconds
-  inline static std::chrono::nanoseconds nanoseconds_per_tick = 1us;
+  /// The 64-bit cycle count at the moment the 32-bit DWT cycle counter held
+  /// `dwt_count`.
+  struct CycleSnapshot_t
+  {
+    /// Number of cycles counted since the DWT counter was started.
+    uint64_t cycles;
+    /// Value of the DWT cycle counter when the snapshot was taken.
+    uint32_t dwt_count;
+  };
+
+  /// The DWT cycle counter is only 32-bits wide and wraps every few seconds,
+  /// so it is extended to 64-bits by taking a snapshot on every SysTick
+  /// interrupt. The interrupt fills in the unpublished snapshot and then
+  /// publishes it by incrementing `snapshot_generation`, so readers never see
+  /// a partially written snapshot, even when they interrupt the SysTick
+  /// handler.
+  inline static std::array<CycleSnapshot_t, 2> cycle_snapshots = {};
+
+  /// Incremented each time a new snapshot is published. The lowest bit selects
+  /// the published snapshot.
+  inline static std::atomic<uint32_t> snapshot_generation = 0;
+
+  /// Frequency of the DWT cycle counter, used to convert cycles to time. Set
+  /// with SetCyclesPerSecond().
+  inline static uint32_t cycles_per_second = 1'000'000;
+
+  /// Whole nanoseconds in each cycle of the DWT cycle counter.
+  inline static uint32_t nanoseconds_per_cycle = 1'000;
 
-  /// Holds the conversion from ticks to milliseconds
-  inline static uint32_t ticks_per_millisecond = 1;
+  /// Fractional nanoseconds in each cycle, in units of 2^-32 nanoseconds.
+  inline static uint32_t nanoseconds_per_cycle_fraction = 0;
 
-  /// Fixed point scale in order to boost the precision of GetCount() method
-  /// while also keeping most of the arithmetic as integer math.
-  static constexpr uint32_t kFixedPointScaling = 1'000'000;
+  /// Set the frequency of the DWT cycle counter and precompute the fixed point
+  /// cycle period used by GetCount(), so that converting cycles to time needs
+  /// no division.
+  ///
+  /// @param frequency - cycles per second of the DWT cycle counter.
+  static void SetCyclesPerSecond(uint32_t frequency)
+  {
+    constexpr uint64_t kNanosecondsPerSecond = 1'000'000'000;
+
+    const uint64_t kRemainder = kNanosecondsPerSecond % frequency;
+
+    cycles_per_second     = frequency;
+    nanoseconds_per_cycle = static_cast<uint32_t>(kNanosecondsPerSecond /
+                                                  frequency);
+    nanoseconds_per_cycle_fraction =
+        static_cast<uint32_t>((kRemainder << 32) / frequency);
+  }
 
   /// Disables this system timer.
   /// @warning: Calling this function so will disable FreeRTOS.
@@ -74,33 +118,65 @@ class SystemTimer final : public sjsu::SystemTimer
     // This assumes that SysTickHandler is called every millisecond.
     // Changing that frequency will distort the milliseconds time.
     millisecond_count += 1ms;
+    UpdateCycleCount();
     if (callback)
     {
       callback();
     }
   }
 
-  /// @return returns the current system_timer counter value.
+  /// Publish a new snapshot of the 64-bit cycle count. Called from the SysTick
+  /// handler, which is guaranteed to run at least once before the 32-bit DWT
+  /// counter can wrap, as the SysTick reload value is only 24-bits wide.
+  static void UpdateCycleCount()
+  {
+    uint32_t generation = snapshot_generation.load(std::memory_order_relaxed);
+    const CycleSnapshot_t & current = cycle_snapshots[generation & 1];
+    uint32_t dwt_count              = dwt_counter.GetCount();
+
+    // Unsigned subtraction yields the elapsed cycles even if the DWT counter
+    // wrapped since the last snapshot.
+    cycle_snapshots[(generation + 1) & 1] = {
+      .cycles    = current.cycles + (dwt_count - current.dwt_count),
+      .dwt_count = dwt_count,
+    };
+    snapshot_generation.store(generation + 1);
+  }
+
+  /// @return the number of cycles counted since the DWT counter was started as
+  ///         a monotonic 64-bit value.
+  static uint64_t GetCycleCount()
+  {
+    uint32_t generation;
+    CycleSnapshot_t snapshot;
+    uint32_t dwt_count;
+
+    // Retry if a new snapshot was published while this one was being read.
+    do
+    {
+      generation = snapshot_generation.load();
+      snapshot   = cycle_snapshots[generation & 1];
+      dwt_count  = dwt_counter.GetCount();
+    } while (generation != snapshot_generation.load());
+
+    return snapshot.cycles + (dwt_count - snapshot.dwt_count);
+  }
+
+  /// @return returns the current system uptime with the resolution of a single
+  ///         CPU cycle.
   static std::chrono::nanoseconds GetCount()
   {
-    // Capture all count variables at this instant.
-    uint32_t high_speed_ticks = dwt_counter.GetCount();
-    auto current_millis_count = millisecond_count;
-
-    // Get rid of the portion of the dwt tick count that is above 1ms.
-    // We only want the information about the ticks that is below 1ms, since we
-    // get the 1ms count from the SysTick timer interrupt.
-    uint32_t sub_millis_ticks = (high_speed_ticks % ticks_per_millisecond);
-    // Perform the conversion from ticks to nanoseconds
-    auto nanoseconds_unscaled = (sub_millis_ticks * nanoseconds_per_tick);
-    // Nanoseconds per tick is actually scaled up by the kFixedPointScaling
-    // factor, meaning it needs to be divided by that value to get the correct
-    // nanosecond_uptime.
-    auto nanoseconds_uptime_scaled = nanoseconds_unscaled / kFixedPointScaling;
-
-    // Result is simply the uptime milliseconds (represented in nanoseconds) +
-    // the added nanoseconds
-    return current_millis_count + nanoseconds_uptime_scaled;
+    // Multiply by the 32.32 fixed point cycle period. The fractional part is
+    // applied to the upper and lower 32 bits of the cycle count separately so
+    // that no product needs more than 64 bits.
+    const uint64_t kCycles  = GetCycleCount();
+    const uint64_t kUpper   = kCycles >> 32;
+    const uint64_t kLower   = kCycles & 0xFFFF'FFFF;
+    const uint64_t kWhole   = kCycles * nanoseconds_per_cycle;
+    const uint64_t kPartial = kUpper * nanoseconds_per_cycle_fraction +
+                              ((kLower * nanoseconds_per_cycle_fraction) >> 32);
+
+    return std::chrono::nanoseconds(kWhole + kPartial);
   }
 
   /// Constructor for ARM Cortex M system timer.
@@ -118,13 +194,12 @@ class SystemTimer final : public sjsu::SystemTimer
   {
     dwt_counter.Initialize();
 
-    auto system_frequency = SystemController::GetPlatformController()
-                                .GetClockRate(id_)
-                                .to<uint32_t>();
-
-    ticks_per_millisecond = system_frequency / 1000 /* ms/s */;
-    nanoseconds_per_tick =
-        (kFixedPointScaling * 1'000'000'000ns) / system_frequency;
+    // Take a snapshot so the cycle count continues from its current value if
+    // the timer is initialized again.
+    UpdateCycleCount();
+    SetCyclesPerSecond(SystemController::GetPlatformController()
+                           .GetClockRate(id_)
+                           .to<uint32_t>());
   }
 
   void SetCallback(InterruptCallback isr) const override
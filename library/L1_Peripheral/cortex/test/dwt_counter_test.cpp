@@ -31,6 +31,20 @@ TEST_CASE("Testing ARM Cortex Data Watchdog Trace Counter")
     CHECK(0 == local_dwt.CYCCNT);
     CHECK(DWT_CTRL_CYCCNTENA_Msk == local_dwt.CTRL);
   }
+  SECTION("Initialize does not clear a running counter")
+  {
+    // Setup
+    local_dwt.CTRL   = DWT_CTRL_CYCCNTENA_Msk;
+    local_dwt.CYCCNT = 1234;
+
+    // Exercise
+    test_subject.Initialize();
+
+    // Verify
+    CHECK(CoreDebug_DEMCR_TRCENA_Msk == local_core.DEMCR);
+    CHECK(1234 == local_dwt.CYCCNT);
+    CHECK(DWT_CTRL_CYCCNTENA_Msk == local_dwt.CTRL);
+  }
   SECTION("Get Count")
   {
     local_dwt.CYCCNT = 0;
@@ -0,0 +1,78 @@
+#include <array>
+#include <cstdint>
+#include <functional>
+
+#include "L1_Peripheral/cortex/interrupt.hpp"
+#include "L4_Testing/benchmark.hpp"
+
+namespace sjsu::cortex
+{
+namespace
+{
+constexpr size_t kNumberOfInterrupts = 16;
+constexpr int kIrq                   = 5;
+
+using Controller = InterruptController<kNumberOfInterrupts, 5>;
+
+SCB_Type local_scb = {
+  // This field must be defined otherwise compiler will complain
+  .CPUID = 0,
+};
+NVIC_Type local_nvic;
+uint32_t interrupt_count = 0;
+
+/// Copy of LookupHandler() from before interrupt handlers were Delegates.
+std::array<std::function<void(void)>,
+           kNumberOfInterrupts + Controller::kArmExceptionOffset>
+    legacy_table;
+
+void LegacyLookupHandler()
+{
+  int active_interrupt              = (local_scb.ICSR & 0xFF);
+  Controller::current_vector        = Controller::IndexToIRQ(active_interrupt);
+  std::function<void(void)> handler = legacy_table[active_interrupt];
+  handler();
+}
+
+/// Typical driver handler, which captures the driver's address.
+auto MakeHandler()
+{
+  return [count = &interrupt_count]() { (*count)++; };
+}
+
+void SetupController()
+{
+  Controller::scb  = &local_scb;
+  Controller::nvic = &local_nvic;
+  local_scb.ICSR   = Controller::IRQToIndex(kIrq);
+}
+}  // namespace
+
+BENCHMARK("LookupHandler() std::function table")
+{
+  SetupController();
+  legacy_table[Controller::IRQToIndex(kIrq)] = MakeHandler();
+
+  for (auto _ : state)
+  {
+    LegacyLookupHandler();
+    benchmark::ClobberMemory();
+  }
+}
+
+BENCHMARK("LookupHandler() Delegate table")
+{
+  SetupController();
+  Controller controller;
+  controller.Enable({
+      .interrupt_request_number = kIrq,
+      .interrupt_handler        = MakeHandler(),
+  });
+
+  for (auto _ : state)
+  {
+    Controller::LookupHandler();
+    benchmark::ClobberMemory();
+  }
+}
+}  // namespace sjsu::cortex
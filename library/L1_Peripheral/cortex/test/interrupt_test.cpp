@@ -1,4 +1,5 @@
 #include "L1_Peripheral/cortex/interrupt.hpp"
+#include "L1_Peripheral/cortex/dwt_counter.hpp"
 #include "L4_Testing/testing_frameworks.hpp"
 
 namespace sjsu::cortex
@@ -72,5 +73,180 @@ TEST_CASE("Testing cortex interrupt")
     test_subject.Disable(kIRQ);
     CHECK(local_nvic.ICER[(kIRQ >> 5)] == (1 << (kIRQ & 0x1F)));
   }
+
+  SECTION("Trace")
+  {
+    // Setup
+    test_subject.Enable({
+        .interrupt_request_number = kIRQ,
+        .interrupt_handler        = []() {},
+    });
+    local_scb.ICSR = test_subject.IRQToIndex(kIRQ);
+    trace::recorder.Clear();
+    trace::recorder.Start();
+
+    // Exercise
+    test_subject.LookupHandler();
+    trace::recorder.Stop();
+
+    // Verify
+    REQUIRE(2 == trace::recorder.Size());
+    CHECK(trace::Type::kInterruptEnter == trace::recorder.GetEvent(0).type);
+    CHECK(kIRQ == trace::recorder.GetEvent(0).argument);
+    CHECK(trace::Type::kInterruptExit == trace::recorder.GetEvent(1).type);
+    CHECK(kIRQ == trace::recorder.GetEvent(1).argument);
+
+    // Cleanup
+    trace::recorder.Clear();
+  }
+
+  SECTION("Profiling")
+  {
+    // Setup
+    using Controller         = decltype(test_subject);
+    constexpr int kNestedIRQ = 3;
+
+    DWT_Type local_dwt = {
+      .PCSR = 0,
+    };
+    CoreDebug_Type local_core;
+    testing::ClearStructure(&local_dwt);
+    testing::ClearStructure(&local_core);
+    DwtCounter::dwt  = &local_dwt;
+    DwtCounter::core = &local_core;
+
+    // Setup: Each handler advances the cycle counter to simulate the time it
+    //        takes to run. kIRQ's handler is preempted by kNestedIRQ.
+    test_subject.Enable({
+        .interrupt_request_number = kNestedIRQ,
+        .interrupt_handler        = [&local_dwt]() { local_dwt.CYCCNT += 50; },
+    });
+    test_subject.Enable({
+        .interrupt_request_number = kIRQ,
+        .interrupt_handler =
+            [&local_dwt, &local_scb]() {
+              local_dwt.CYCCNT += 100;
+              local_scb.ICSR = Controller::IRQToIndex(kNestedIRQ);
+              Controller::LookupHandler();
+              local_dwt.CYCCNT += 20;
+            },
+    });
+
+    test_subject.ResetProfiles();
+
+    SECTION("Disabled by default")
+    {
+      // Exercise
+      local_scb.ICSR = test_subject.IRQToIndex(kIRQ);
+      test_subject.LookupHandler();
+
+      // Verify
+      CHECK(0 == test_subject.GetProfile(kIRQ)->count);
+      CHECK(0 == test_subject.GetProfile(kNestedIRQ)->count);
+    }
+
+    SECTION("Records count, cycles and nesting")
+    {
+      // Exercise
+      test_subject.EnableProfiling(true);
+      for (int i = 0; i < 2; i++)
+      {
+        local_scb.ICSR = test_subject.IRQToIndex(kIRQ);
+        test_subject.LookupHandler();
+      }
+      local_scb.ICSR = test_subject.IRQToIndex(kNestedIRQ);
+      test_subject.LookupHandler();
+      test_subject.EnableProfiling(false);
+
+      // Verify
+      const auto * outer = test_subject.GetProfile(kIRQ);
+      const auto * inner = test_subject.GetProfile(kNestedIRQ);
+      REQUIRE(outer != nullptr);
+      REQUIRE(inner != nullptr);
+
+      CHECK(0 != (local_dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk));
+      CHECK(2 == outer->count);
+      CHECK(240 == outer->total_cycles);
+      CHECK(120 == outer->max_cycles);
+      CHECK(1 == outer->max_nesting);
+
+      CHECK(3 == inner->count);
+      CHECK(150 == inner->total_cycles);
+      CHECK(50 == inner->max_cycles);
+      CHECK(2 == inner->max_nesting);
+    }
+
+    SECTION("Nested time outside of the measurement does not wrap around")
+    {
+      // Setup: Rewinding the counter once kNestedIRQ returns leaves its
+      //        cycles out of kIRQ's measurement, as happens when it fires
+      //        just before kIRQ reads the counter.
+      test_subject.Enable({
+          .interrupt_request_number = kIRQ,
+          .interrupt_handler =
+              [&local_dwt, &local_scb]() {
+                local_dwt.CYCCNT += 10;
+                local_scb.ICSR = Controller::IRQToIndex(kNestedIRQ);
+                Controller::LookupHandler();
+                local_dwt.CYCCNT -= 50;
+              },
+      });
+
+      // Exercise
+      test_subject.EnableProfiling(true);
+      local_scb.ICSR = test_subject.IRQToIndex(kIRQ);
+      test_subject.LookupHandler();
+      test_subject.EnableProfiling(false);
+
+      // Verify
+      const auto * outer = test_subject.GetProfile(kIRQ);
+      CHECK(1 == outer->count);
+      CHECK(0 == outer->total_cycles);
+      CHECK(0 == outer->max_cycles);
+      CHECK(50 == test_subject.GetProfile(kNestedIRQ)->max_cycles);
+    }
+
+    SECTION("ResetProfiles()")
+    {
+      // Setup
+      test_subject.EnableProfiling(true);
+      local_scb.ICSR = test_subject.IRQToIndex(kIRQ);
+      test_subject.LookupHandler();
+      test_subject.EnableProfiling(false);
+
+      // Exercise
+      test_subject.ResetProfiles();
+
+      // Verify
+      CHECK(0 == test_subject.GetProfile(kIRQ)->count);
+      CHECK(0 == test_subject.GetProfile(kIRQ)->total_cycles);
+    }
+
+    SECTION("GetProfile() out of range")
+    {
+      // Verify
+      CHECK(nullptr == test_subject.GetProfile(kNumberOfVectors));
+      CHECK(nullptr ==
+            test_subject.GetProfile(-Controller::kArmExceptionOffset - 1));
+      CHECK(nullptr != test_subject.GetProfile(cortex::SysTick_IRQn));
+    }
+
+    DwtCounter::dwt  = DWT;
+    DwtCounter::core = CoreDebug;
+  }
+  SECTION("FindExceptionFrame()")
+  {
+    // Setup
+    constexpr uintptr_t kReturnToHandler = 0xFFFF'FFF1;
+    constexpr uintptr_t kReturnToThread  = 0xFFFF'FFF9;
+    constexpr uintptr_t kReturnToTask    = 0xFFFF'FFFD;
+    ExceptionFrame_t frame               = {};
+
+    // Exercise & Verify
+    CHECK(&frame == test_subject.FindExceptionFrame(kReturnToHandler, &frame));
+    CHECK(&frame == test_subject.FindExceptionFrame(kReturnToThread, &frame));
+    // The host has no process stack to read the frame from.
+    CHECK(nullptr == test_subject.FindExceptionFrame(kReturnToTask, &frame));
+  }
 }
 }  // namespace sjsu::cortex
@@ -0,0 +1,81 @@
+#include "L1_Peripheral/cortex/sampling_profiler.hpp"
+#include "L4_Testing/testing_frameworks.hpp"
+
+namespace sjsu::cortex
+{
+TEST_CASE("Testing cortex SamplingProfiler")
+{
+  Mock<sjsu::Timer> mock_timer;
+  InterruptCallback timer_callback;
+  When(Method(mock_timer, Initialize))
+      .AlwaysDo([&timer_callback](units::frequency::hertz_t,
+                                  InterruptCallback callback,
+                                  int32_t) -> Status {
+        timer_callback = callback;
+        return Status::kSuccess;
+      });
+  Fake(Method(mock_timer, SetMatchBehavior));
+  Fake(Method(mock_timer, Start));
+  Fake(Method(mock_timer, Stop));
+
+  SamplingProfiler test_subject(mock_timer.get());
+
+  SECTION("Start()")
+  {
+    // Exercise
+    Status status = test_subject.Start(1_kHz);
+
+    // Verify
+    CHECK(Status::kSuccess == status);
+    CHECK(capture_interrupted_frame);
+    Verify(Method(mock_timer, Initialize)
+               .Using(SamplingProfiler::kTimerFrequency, _,
+                      SamplingProfiler::kPriority),
+           Method(mock_timer, SetMatchBehavior)
+               .Using(1000, Timer::MatchAction::kInterruptRestart, 0),
+           Method(mock_timer, Start));
+  }
+
+  SECTION("Start() with an unsupported sample rate")
+  {
+    // Exercise & Verify
+    CHECK(Status::kInvalidParameters == test_subject.Start(0_Hz));
+    CHECK(Status::kInvalidParameters == test_subject.Start(1_MHz));
+    Verify(Method(mock_timer, Initialize)).Never();
+  }
+
+  SECTION("Samples the interrupted program counter")
+  {
+    // Setup
+    ExceptionFrame_t frame = { .pc = 0x1234 };
+    test_subject.Start(1_kHz);
+
+    // Exercise
+    interrupted_frame = &frame;
+    timer_callback();
+    timer_callback();
+    interrupted_frame = nullptr;
+    timer_callback();
+
+    // Verify
+    CHECK(2 == test_subject.GetSamples().GetTotal());
+    CHECK(2 == test_subject.GetSamples().GetCount(0x1234));
+  }
+
+  SECTION("Stop()")
+  {
+    // Setup
+    test_subject.Start(1_kHz);
+
+    // Exercise
+    test_subject.Stop();
+
+    // Verify
+    CHECK(!capture_interrupted_frame);
+    Verify(Method(mock_timer, Stop)).Once();
+  }
+
+  capture_interrupted_frame = false;
+  interrupted_frame         = nullptr;
+}
+}  // namespace sjsu::cortex
@@ -22,6 +22,9 @@ TEST_CASE("Testing ARM Cortex SystemTimer")
   DwtCounter::dwt  = &local_dwt;
   DwtCounter::core = &local_core;
 
+  SystemTimer::cycle_snapshots     = {};
+  SystemTimer::snapshot_generation = 0;
+
   // Simulated local version of SysTick register to verify register
   // manipulation by side effect of Pin method calls
   // Default figure 552 page 703
@@ -52,14 +55,6 @@ TEST_CASE("Testing ARM Cortex SystemTimer")
 
   SECTION("Initialize()")
   {
-    // Setup
-    constexpr uint32_t kClockFrequencyInt = kClockFrequency.to<uint32_t>();
-    constexpr auto kExpectedTicksPerMillisecond =
-        kClockFrequencyInt / 1000 /* ms/s */;
-    constexpr auto kExpectedNanosecondsPerTick =
-        (SystemTimer::kFixedPointScaling * 1'000'000'000ns) /
-        kClockFrequencyInt;
-
     // Exercise
     test_subject.Initialize();
 
@@ -68,8 +63,7 @@ TEST_CASE("Testing ARM Cortex SystemTimer")
     CHECK(0 == local_dwt.CYCCNT);
     CHECK(DWT_CTRL_CYCCNTENA_Msk == local_dwt.CTRL);
 
-    CHECK(kExpectedTicksPerMillisecond == SystemTimer::ticks_per_millisecond);
-    CHECK(kExpectedNanosecondsPerTick == SystemTimer::nanoseconds_per_tick);
+    CHECK(kClockFrequency.to<uint32_t>() == SystemTimer::cycles_per_second);
   }
 
   SECTION("SetTickFrequency generate desired frequency")
@@ -176,18 +170,99 @@ TEST_CASE("Testing ARM Cortex SystemTimer")
   SECTION("GetCount()")
   {
     // Setup
-    constexpr uint32_t kDebugCountTicks = 128;
-    constexpr auto kMilliseconds        = 1ms;
-    SystemTimer::millisecond_count      = kMilliseconds;
-    constexpr auto kExpectedUptime = kMilliseconds + (kDebugCountTicks * 100ns);
+    test_subject.Initialize();
+
+    // Exercise
+    local_dwt.CYCCNT = 128;
+    auto uptime      = test_subject.GetCount();
+
+    // Verify: Each cycle of the 10 MHz clock is 100ns
+    CHECK(128 * 100ns == uptime);
 
     // Exercise
+    local_dwt.CYCCNT = 25'000'003;
+    uptime           = test_subject.GetCount();
+
+    // Verify
+    CHECK(2'500'000'300ns == uptime);
+  }
+
+  SECTION("GetCount() with a period that is not a whole nanosecond")
+  {
+    // Setup: Each cycle of a 12 MHz clock is 83.333... ns
     test_subject.Initialize();
-    local_dwt.CYCCNT = kDebugCountTicks;
+    SystemTimer::SetCyclesPerSecond(12'000'000);
+
+    // Exercise
+    local_dwt.CYCCNT = 36'000'007;
     auto uptime      = test_subject.GetCount();
 
     // Verify
-    CHECK(kExpectedUptime == uptime);
+    CHECK(3'000'000'583ns == uptime);
+
+    // Exercise: Cycle counts wider than 32-bits
+    local_dwt.CYCCNT = 0xFFFF'FF00;
+    test_subject.SystemTimerHandler();
+    local_dwt.CYCCNT = 0;
+    uptime           = test_subject.GetCount();
+
+    // Verify
+    CHECK(357'913'941'333ns == uptime);
+  }
+
+  SECTION("GetCount() continues past DWT counter wrap around")
+  {
+    // Setup
+    constexpr uint64_t kCyclesPerWrap = 1ULL << 32;
+    constexpr auto kTimePerWrap       = kCyclesPerWrap * 100ns;
+    test_subject.Initialize();
+
+    // Setup: SysTick handler runs shortly before the counter wraps
+    local_dwt.CYCCNT = 0xFFFF'FF00;
+    test_subject.SystemTimerHandler();
+
+    // Exercise: Counter wraps before the next SysTick interrupt
+    local_dwt.CYCCNT = 0x10;
+    auto before_tick = test_subject.GetCount();
+    test_subject.SystemTimerHandler();
+    auto after_tick = test_subject.GetCount();
+
+    // Verify
+    CHECK(kTimePerWrap + (0x10 * 100ns) == before_tick);
+    CHECK(before_tick == after_tick);
+
+    // Exercise: Wrap a few more times with SysTick running in between
+    for (uint32_t i = 0; i < 3; i++)
+    {
+      local_dwt.CYCCNT = 0x8000'0000;
+      test_subject.SystemTimerHandler();
+      local_dwt.CYCCNT = 0x20;
+      test_subject.SystemTimerHandler();
+    }
+
+    // Verify
+    CHECK(4 * kTimePerWrap + (0x20 * 100ns) == test_subject.GetCount());
+    CHECK(4 * kCyclesPerWrap + 0x20 == test_subject.GetCycleCount());
+  }
+
+  SECTION("GetCount() is monotonic")
+  {
+    // Setup
+    test_subject.Initialize();
+    auto previous = test_subject.GetCount();
+
+    // Exercise + Verify
+    for (uint64_t cycles = 0; cycles < 3 * (1ULL << 32); cycles += 77'777'777)
+    {
+      local_dwt.CYCCNT = static_cast<uint32_t>(cycles);
+      if (cycles % 2 == 0)
+      {
+        test_subject.SystemTimerHandler();
+      }
+      auto uptime = test_subject.GetCount();
+      CHECK(previous <= uptime);
+      previous = uptime;
+    }
   }
 
   // Cleanup
@@ -5,6 +5,7 @@
 #include <span>
 
 #include "config.hpp"
+#include "utility/delegate.hpp"
 #include "utility/status.hpp"
 #include "utility/units.hpp"
 
@@ -32,6 +33,10 @@ class I2c
   /// time.
   static constexpr std::chrono::milliseconds kI2cTimeout = 100ms;
 
+  /// Called when an asynchronous transaction has finished, with the status of
+  /// the transaction. May be called from within an interrupt service routine.
+  using CompletionHandler = Delegate<void(Status)>;
+
   /// Namespace of common I2C transaction errors
   class CommonErrors
   {
@@ -110,6 +115,10 @@ class I2c
     /// The status of the transaction after it is completed, fails, or times
     /// out.
     Status status = Status::kSuccess;
+
+    /// Called when the transaction finishes, if it was started by
+    /// TransactionAsync(). Set by TransactionAsync().
+    CompletionHandler on_complete = nullptr;
   };
 
   // ===========================================================================
@@ -130,6 +139,51 @@ class I2c
   ///         Status::kSuccess if transaction was fulfilled.
   virtual Returns<void> Transaction(Transaction_t transaction) const = 0;
 
+  /// Start an I2C transaction and return without waiting for it to finish, so
+  /// that the caller can do other work while the bytes are on the bus.
+  ///
+  /// The transaction's buffers must remain valid until `on_complete` is
+  /// called. The transaction's timeout is not applied, so callers waiting for
+  /// the result must apply their own, for example by giving a semaphore from
+  /// `on_complete` and taking it with a timeout. When that timeout expires,
+  /// the caller must call CancelTransactionAsync() so that a stuck
+  /// transaction does not hold the bus forever.
+  ///
+  /// The default implementation performs the transaction with Transaction()
+  /// and calls `on_complete` before returning, for drivers that cannot
+  /// perform transactions in the background.
+  ///
+  /// @param transaction - transaction to perform.
+  /// @param on_complete - called with the status of the transaction when it
+  ///        has finished. May be called from within an interrupt service
+  ///        routine, so it must be short and must not block.
+  /// @return an error if the transaction could not be started, in which case
+  ///         `on_complete` is not called.
+  virtual Returns<void> TransactionAsync(Transaction_t transaction,
+                                         CompletionHandler on_complete) const
+  {
+    auto result = Transaction(transaction);
+    on_complete(result ? Status::kSuccess : result.error()->status);
+    return {};
+  }
+
+  /// Abandon the transaction started by TransactionAsync(), release the bus
+  /// and call its `on_complete` with Status::kTimedOut. Once this returns, the
+  /// transaction's buffers are no longer used and TransactionAsync() may be
+  /// called again.
+  ///
+  /// The default implementation does nothing, as the default
+  /// TransactionAsync() has finished before it returns. Drivers that override
+  /// TransactionAsync() must override this as well.
+  ///
+  /// @return true if a transaction was in progress and has been cancelled,
+  ///         false if there was nothing to cancel, in which case
+  ///         `on_complete` has already been called.
+  virtual bool CancelTransactionAsync() const
+  {
+    return false;
+  }
+
   // ===========================================================================
   // Utility Methods
   // ===========================================================================
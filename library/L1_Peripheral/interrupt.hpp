@@ -1,16 +1,19 @@
 #pragma once
 
 #include <cstdint>
-#include <functional>
+
+#include "utility/delegate.hpp"
 
 namespace sjsu
 {
 /// Used specifically for defining an interrupt vector table of addresses.
 using InterruptVectorAddress = void (*)(void);
-/// Define an alias for an interrupt service routine callable object.
-using InterruptHandler = std::function<void(void)>;
+/// Define an alias for an interrupt service routine callable object. Uses a
+/// Delegate rather than std::function so that registering and dispatching a
+/// handler never allocates and dispatch is a single indirect call.
+using InterruptHandler = Delegate<void(void)>;
 /// Standard callback that should be executed when interrupts fire.
-using InterruptCallback = std::function<void(void)>;
+using InterruptCallback = Delegate<void(void)>;
 /// An abstract interface for a platforms interrupt controller. This allows a
 /// developer to enable and disable interrupts as well as assign handlers for
 /// each.
@@ -75,6 +78,44 @@ class InterruptController
   /// @param interrupt_request_number - the interrupt request number to be
   ///        disabled.
   virtual void Disable(int interrupt_request_number) = 0;
+
+  // ===========================================================================
+  // Optional Profiling Interface
+  // ===========================================================================
+
+  /// Statistics collected for each interrupt while profiling is enabled.
+  struct Profile_t
+  {
+    /// Number of times the interrupt's handler has been called.
+    uint32_t count = 0;
+    /// Longest time spent in a single call of the handler in cycles.
+    uint32_t max_cycles = 0;
+    /// Total time spent in the handler in cycles. Time spent in interrupts
+    /// that preempted the handler is not included.
+    uint64_t total_cycles = 0;
+    /// Deepest level of interrupt nesting the handler was called at. A handler
+    /// that has only ever preempted application code has a depth of 1.
+    uint32_t max_nesting = 0;
+  };
+
+  /// Start or stop collecting a Profile_t for every interrupt. Profiling is
+  /// disabled by default. Platforms that cannot profile their interrupts
+  /// ignore this.
+  ///
+  /// @param enable - true to start profiling, false to stop.
+  virtual void EnableProfiling([[maybe_unused]] bool enable) {}
+
+  /// @param interrupt_request_number - interrupt to get the profile of.
+  /// @return the profile of the interrupt, or nullptr if the interrupt does not
+  ///         exist or the platform cannot profile its interrupts.
+  virtual const Profile_t * GetProfile(
+      [[maybe_unused]] int interrupt_request_number)
+  {
+    return nullptr;
+  }
+
+  /// Clear the profile of every interrupt.
+  virtual void ResetProfiles() {}
 };
 
 /// Compare operator between two InterruptController::RegistrationInfo_t
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <signal.h>
+#include <sys/time.h>
+#include <ucontext.h>
+
+#include <atomic>
+#include <cstdint>
+
+#include "L1_Peripheral/sampling_profiler.hpp"
+#include "utility/status.hpp"
+#include "utility/units.hpp"
+
+namespace sjsu
+{
+namespace linux
+{
+/// Sampling profiler for the linux platform. The kernel's profiling timer
+/// (ITIMER_PROF) sends SIGPROF at the sample rate, measured in CPU time used by
+/// the process, and the signal handler reads the program counter of the
+/// interrupted code from the signal's context.
+///
+/// Only one profiler can run at a time, as there is a single SIGPROF handler.
+/// Sample rates are limited by the kernel's timer resolution.
+class SamplingProfiler final : public sjsu::SamplingProfiler
+{
+ public:
+  Status Start(units::frequency::hertz_t sample_rate) override
+  {
+    if (sample_rate <= 0_Hz || sample_rate > 1_MHz)
+    {
+      return Status::kInvalidParameters;
+    }
+
+    SamplingProfiler * expected = nullptr;
+    if (!active_profiler.compare_exchange_strong(expected, this) &&
+        expected != this)
+    {
+      return Status::kNotReadyYet;
+    }
+
+    struct sigaction action = {};
+    action.sa_sigaction     = SignalHandler;
+    action.sa_flags         = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGPROF, &action, nullptr) != 0)
+    {
+      active_profiler = nullptr;
+      return Status::kBusError;
+    }
+
+    uint32_t period_us = 1_MHz / sample_rate;
+    timeval period     = {
+      .tv_sec  = static_cast<time_t>(period_us / 1'000'000),
+      .tv_usec = static_cast<suseconds_t>(period_us % 1'000'000),
+    };
+    itimerval timer = { .it_interval = period, .it_value = period };
+    if (setitimer(ITIMER_PROF, &timer, nullptr) != 0)
+    {
+      active_profiler = nullptr;
+      return Status::kBusError;
+    }
+
+    return Status::kSuccess;
+  }
+
+  void Stop() override
+  {
+    itimerval disabled = {};
+    setitimer(ITIMER_PROF, &disabled, nullptr);
+
+    SamplingProfiler * expected = this;
+    active_profiler.compare_exchange_strong(expected, nullptr);
+  }
+
+ private:
+  static void SignalHandler(int, siginfo_t *, void * context)
+  {
+    SamplingProfiler * profiler = active_profiler.load();
+    if (profiler != nullptr)
+    {
+      profiler->samples_.Record(
+          ProgramCounter(static_cast<const ucontext_t *>(context)));
+    }
+  }
+
+  static uintptr_t ProgramCounter(const ucontext_t * context)
+  {
+#if defined(__x86_64__)
+    return static_cast<uintptr_t>(context->uc_mcontext.gregs[REG_RIP]);
+#elif defined(__i386__)
+    return static_cast<uintptr_t>(context->uc_mcontext.gregs[REG_EIP]);
+#elif defined(__aarch64__)
+    return static_cast<uintptr_t>(context->uc_mcontext.pc);
+#elif defined(__arm__)
+    return static_cast<uintptr_t>(context->uc_mcontext.arm_pc);
+#else
+    static_cast<void>(context);
+    return 0;
+#endif
+  }
+
+  /// Profiler that SIGPROF samples are recorded into.
+  inline static std::atomic<SamplingProfiler *> active_profiler = nullptr;
+};
+}  // namespace linux
+}  // namespace sjsu
@@ -0,0 +1,52 @@
+#include <chrono>
+
+#include "L1_Peripheral/linux/sampling_profiler.hpp"
+#include "L4_Testing/testing_frameworks.hpp"
+
+namespace sjsu::linux
+{
+TEST_CASE("Testing linux SamplingProfiler")
+{
+  SamplingProfiler test_subject;
+
+  SECTION("Samples the process while it uses the CPU")
+  {
+    // Setup
+    constexpr auto kTimeout = std::chrono::seconds(2);
+    auto start              = std::chrono::steady_clock::now();
+    volatile uint32_t work  = 0;
+
+    // Exercise
+    REQUIRE(Status::kSuccess == test_subject.Start(1_kHz));
+    while (test_subject.GetSamples().GetTotal() < 5 &&
+           std::chrono::steady_clock::now() - start < kTimeout)
+    {
+      work = work + 1;
+    }
+    test_subject.Stop();
+
+    // Verify
+    CHECK(5 <= test_subject.GetSamples().GetTotal());
+    CHECK(0 != test_subject.GetSamples().GetTop(0).address);
+  }
+
+  SECTION("Only one profiler can run at a time")
+  {
+    // Setup
+    SamplingProfiler other_profiler;
+    REQUIRE(Status::kSuccess == test_subject.Start(1_kHz));
+
+    // Exercise & Verify
+    CHECK(Status::kNotReadyYet == other_profiler.Start(1_kHz));
+    test_subject.Stop();
+    CHECK(Status::kSuccess == other_profiler.Start(1_kHz));
+    other_profiler.Stop();
+  }
+
+  SECTION("Start() with an unsupported sample rate")
+  {
+    // Exercise & Verify
+    CHECK(Status::kInvalidParameters == test_subject.Start(0_Hz));
+  }
+}
+}  // namespace sjsu::linux
@@ -1,15 +1,20 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <initializer_list>
 #include <string_view>
 
 #include "L1_Peripheral/can.hpp"
+#include "L1_Peripheral/can_filter.hpp"
 
 #include "L0_Platform/lpc40xx/LPC40xx.h"
 #include "L1_Peripheral/cortex/interrupt.hpp"
 #include "L1_Peripheral/inactive.hpp"
 #include "L1_Peripheral/lpc40xx/pin.hpp"
 #include "L1_Peripheral/lpc40xx/system_controller.hpp"
+#include "config.hpp"
+#include "utility/containers/mpsc_queue.hpp"
 #include "utility/macros.hpp"
 #include "utility/status.hpp"
 #include "utility/enum.hpp"
@@ -19,6 +24,11 @@ namespace sjsu
 namespace lpc40xx
 {
 /// CANBUS implemenation for the LPC40xx series of devices.
+///
+/// By default, Send() waits for a free transmit buffer and Receive() reads the
+/// single hardware receive buffer, which can overrun if it is not polled often
+/// enough. Call EnableInterruptMode() to have the CAN interrupt queue received
+/// messages and send queued messages instead.
 class Can final : public sjsu::Can
 {
  public:
@@ -124,9 +134,20 @@ class Can final : public sjsu::Can
     /// If 1, receive buffer has at least 1 complete message stored
     static constexpr bit::Mask kReceiveBuffer = bit::MaskFromRange(0);
 
+    /// If 1, a message was lost because the receive buffer was full.
+    static constexpr bit::Mask kDataOverrun = bit::MaskFromRange(1);
+
     /// Bus status bit. If this is '1' then the bus is active, otherwise the bus
     /// is bus off.
     static constexpr bit::Mask kBusError = bit::MaskFromRange(7);
+
+    /// Receive error counter (REC).
+    static constexpr bit::Mask kReceiveErrorCounter =
+        bit::MaskFromRange(16, 23);
+
+    /// Transmit error counter (TEC).
+    static constexpr bit::Mask kTransmitErrorCounter =
+        bit::MaskFromRange(24, 31);
   };
 
   /// This struct holds CAN controller status information. It is HW mapped to a
@@ -190,6 +211,7 @@ class Can final : public sjsu::Can
   enum class Commands : uint32_t
   {
     kReleaseRxBuffer            = 0x04,
+    kClearDataOverrun           = 0x08,
     kSendTxBuffer1              = 0x21,
     kSendTxBuffer2              = 0x41,
     kSendTxBuffer3              = 0x81,
@@ -285,6 +307,56 @@ class Can final : public sjsu::Can
     uint32_t data_b = 0;
   };
 
+  /// Number of hardware transmit buffers in each CAN controller.
+  static constexpr size_t kTransmitBufferCount = 3;
+
+  /// Counters of messages lost while interrupt driven.
+  struct Statistics_t
+  {
+    /// Messages lost by the hardware because the interrupt did not read the
+    /// receive buffer in time.
+    uint32_t receive_overruns = 0;
+    /// Received messages dropped because the receive queue was full.
+    uint32_t receive_dropped = 0;
+    /// Messages dropped by TrySend() because the transmit queue was full.
+    uint32_t transmit_dropped = 0;
+  };
+
+  /// Called by Send() in interrupt mode while the transmit queue is full and
+  /// no progress can be made. See EnableInterruptMode().
+  using WaitFunction = void (*)();
+
+  /// Software queues of an interrupt driven CAN channel. Must outlive the Can
+  /// object it is given to with EnableInterruptMode(). Their contents are
+  /// private to the driver.
+  struct Queues_t
+  {
+    //! @cond Doxygen_Suppress
+    struct PendingMessage_t
+    {
+      Message_t message;
+      uint32_t order;
+    };
+
+    MpscQueue<Message_t, config::kCanReceiveQueueSize> receive;
+    MpscQueue<Message_t, config::kCanTransmitQueueSize> submitted;
+    std::array<PendingMessage_t, config::kCanTransmitQueueSize> transmit;
+    size_t transmit_size                                     = 0;
+    uint32_t transmit_order                                  = 0;
+    std::array<bool, kTransmitBufferCount> in_flight         = {};
+    std::array<uint32_t, kTransmitBufferCount> in_flight_key = {};
+    std::atomic<bool> transmit_lock                          = false;
+    std::atomic<bool> transmit_pending                       = false;
+    std::atomic<uint32_t> receive_overruns                   = 0;
+    std::atomic<uint32_t> receive_dropped                    = 0;
+    std::atomic<uint32_t> transmit_dropped                   = 0;
+    std::array<std::atomic<uint32_t>,
+               static_cast<size_t>(BusError::kNumberOfErrors)>
+        bus_errors = {};
+    std::array<std::atomic<uint32_t>, kArbitrationBits> arbitration_lost = {};
+    //! @endcond
+  };
+
   /// List of supported CANBUS channels
   struct Channel  // NOLINT
   {
@@ -316,9 +388,213 @@ class Can final : public sjsu::Can
     };
   };
 
+  /// Acceptance filter mode register (AFMR) flags (pg. 566)
+  struct AcceptanceFilterMode  // NOLINT
+  {
+    /// Reject every message. Must be set while the lookup table is written.
+    static constexpr bit::Mask kOff = bit::MaskFromRange(0);
+
+    /// Accept every message, ignoring the lookup table.
+    static constexpr bit::Mask kBypass = bit::MaskFromRange(1);
+  };
+
+  /// Number of 32-bit words in the acceptance filter lookup table RAM.
+  static constexpr size_t kAcceptanceTableWords = 512;
+
+  /// Contents of the acceptance filter lookup table RAM and the byte offset of
+  /// each of its sections, as written to the acceptance filter registers.
+  /// Build with BuildAcceptanceTable().
+  ///
+  /// @tparam kWords - maximum number of words the table needs.
+  template <size_t kWords>
+  struct AcceptanceTable_t
+  {
+    /// Lookup table words, from the start of the acceptance filter RAM.
+    std::array<uint32_t, kWords> ram = {};
+    /// SFF_sa: start of the sorted standard ID section.
+    uint32_t standard_start = 0;
+    /// SFF_GRP_sa: start of the sorted standard ID range section.
+    uint32_t standard_group_start = 0;
+    /// EFF_sa: start of the sorted extended ID section.
+    uint32_t extended_start = 0;
+    /// EFF_GRP_sa: start of the sorted extended ID range section.
+    uint32_t extended_group_start = 0;
+    /// ENDofTable: end of the table.
+    uint32_t end = 0;
+    /// False if a filter was invalid or the table does not fit in the
+    /// acceptance filter RAM.
+    bool valid = true;
+  };
+
+  /// Compile the filters of CAN1 and CAN2 into the layout of the acceptance
+  /// filter lookup table. The table is shared by both channels, and each
+  /// entry holds the number of the channel it applies to.
+  ///
+  /// Single IDs go into the explicit sections and ranges into the group
+  /// sections. Standard IDs take half a word each, so an odd number of them
+  /// is padded with a disabled entry. Every section is sorted by channel, then
+  /// by ID, as the hardware's binary search requires.
+  ///
+  /// @param can1 - IDs that CAN1 accepts.
+  /// @param can2 - IDs that CAN2 accepts.
+  /// @return the table to pass to ProgramAcceptanceFilter().
+  template <size_t kCan1Capacity, size_t kCan2Capacity>
+  static constexpr auto BuildAcceptanceTable(
+      const CanFilter<kCan1Capacity> & can1,
+      const CanFilter<kCan2Capacity> & can2)
+  {
+    // Each standard ID or range takes at most one word, and each extended
+    // ID or range at most two.
+    constexpr size_t kWords = 3 * (kCan1Capacity + kCan2Capacity);
+    AcceptanceTable_t<kWords> table;
+    table.valid = can1.IsValid() && can2.IsValid();
+
+    const std::array<std::span<const CanIdRange_t>, 2> standard = {
+      can1.GetStandard(),
+      can2.GetStandard(),
+    };
+    const std::array<std::span<const CanIdRange_t>, 2> extended = {
+      can1.GetExtended(),
+      can2.GetExtended(),
+    };
+
+    size_t word = 0;
+
+    // Standard IDs, two per word, the first in the upper half.
+    table.standard_start = 0;
+    size_t halves        = 0;
+    for (uint32_t channel = 0; channel < 2; channel++)
+    {
+      for (const auto & range : standard[channel])
+      {
+        if (range.low == range.high)
+        {
+          uint32_t entry = StandardEntry(channel, range.low);
+          if (halves++ % 2 == 0)
+          {
+            table.ram[word] = entry << 16;
+          }
+          else
+          {
+            table.ram[word++] |= entry;
+          }
+        }
+      }
+    }
+    if (halves % 2 != 0)
+    {
+      table.ram[word++] |= kDisabledStandardEntry;
+    }
+
+    // Standard ranges, one per word, the lower bound in the upper half.
+    table.standard_group_start = static_cast<uint32_t>(word * 4);
+    for (uint32_t channel = 0; channel < 2; channel++)
+    {
+      for (const auto & range : standard[channel])
+      {
+        if (range.low != range.high)
+        {
+          table.ram[word++] = (StandardEntry(channel, range.low) << 16) |
+                              StandardEntry(channel, range.high);
+        }
+      }
+    }
+
+    // Extended IDs, one per word.
+    table.extended_start = static_cast<uint32_t>(word * 4);
+    for (uint32_t channel = 0; channel < 2; channel++)
+    {
+      for (const auto & range : extended[channel])
+      {
+        if (range.low == range.high)
+        {
+          table.ram[word++] = ExtendedEntry(channel, range.low);
+        }
+      }
+    }
+
+    // Extended ranges, the lower bound word followed by the upper bound word.
+    table.extended_group_start = static_cast<uint32_t>(word * 4);
+    for (uint32_t channel = 0; channel < 2; channel++)
+    {
+      for (const auto & range : extended[channel])
+      {
+        if (range.low != range.high)
+        {
+          table.ram[word++] = ExtendedEntry(channel, range.low);
+          table.ram[word++] = ExtendedEntry(channel, range.high);
+        }
+      }
+    }
+
+    table.end = static_cast<uint32_t>(word * 4);
+    if (word > kAcceptanceTableWords)
+    {
+      table.valid = false;
+    }
+    return table;
+  }
+
+  /// Compile the filter of CAN1 into the layout of the acceptance filter
+  /// lookup table, rejecting every message on CAN2.
+  ///
+  /// @param can1 - IDs that CAN1 accepts.
+  /// @return the table to pass to ProgramAcceptanceFilter().
+  template <size_t kCan1Capacity>
+  static constexpr auto BuildAcceptanceTable(
+      const CanFilter<kCan1Capacity> & can1)
+  {
+    return BuildAcceptanceTable(can1, CanFilter<1>());
+  }
+
+  /// Write a lookup table into the acceptance filter and switch the filter
+  /// from accepting every message to using the table. Affects both CAN1 and
+  /// CAN2. Call after Initialize(), which makes every channel accept every
+  /// message.
+  ///
+  /// Usage:
+  ///
+  ///    using sjsu::lpc40xx::Can;
+  ///    constexpr auto kFilter = sjsu::CanFilter<2>().Accept(0x100).Accept(5);
+  ///    constexpr auto kTable  = Can::BuildAcceptanceTable(kFilter);
+  ///    static_assert(kTable.valid);
+  ///    Can::ProgramAcceptanceFilter(kTable);
+  ///
+  /// @param table - table built by BuildAcceptanceTable().
+  /// @return Status::kInvalidParameters if the table is not valid.
+  template <size_t kWords>
+  static Status ProgramAcceptanceFilter(const AcceptanceTable_t<kWords> & table)
+  {
+    if (!table.valid)
+    {
+      return Status::kInvalidParameters;
+    }
+
+    // The table may only be written while the filter is off.
+    can_acceptance_filter_register->AFMR =
+        bit::Set(0, AcceptanceFilterMode::kOff);
+
+    for (size_t word = 0; word < table.end / 4; word++)
+    {
+      can_acceptance_filter_ram->mask[word] = table.ram[word];
+    }
+    can_acceptance_filter_register->SFF_sa     = table.standard_start;
+    can_acceptance_filter_register->SFF_GRP_sa = table.standard_group_start;
+    can_acceptance_filter_register->EFF_sa     = table.extended_start;
+    can_acceptance_filter_register->EFF_GRP_sa = table.extended_group_start;
+    can_acceptance_filter_register->ENDofTable = table.end;
+
+    can_acceptance_filter_register->AFMR = 0;
+    return Status::kSuccess;
+  }
+
   /// Pointer to the LPC CANBUS acceptance filter peripheral in memory
   inline static LPC_CANAF_TypeDef * can_acceptance_filter_register = LPC_CANAF;
 
+  /// Pointer to the LPC CANBUS acceptance filter lookup table RAM in memory
+  inline static LPC_CANAF_RAM_TypeDef * can_acceptance_filter_ram =
+      LPC_CANAF_RAM;
+
   /// @param channel - Which CANBUS channel to use
   explicit constexpr Can(const Channel_t & channel) : channel_(channel) {}
 
@@ -338,8 +614,7 @@ class Can final : public sjsu::Can
     // CAN bus clock (on the wire)
     SetBaudRate(kStandardBaudRate);
 
-    // Accept all messages
-    // TODO(#343): Allow the user to configure their own filter.
+    // Accept all messages until ProgramAcceptanceFilter() is called.
     EnableAcceptanceFilter();
 
     // Disable reset mode and enter operating mode.
@@ -353,86 +628,222 @@ class Can final : public sjsu::Can
     SetMode(Mode::kReset, false);
   }
 
+  /// Send a message. If interrupt mode is disabled, this waits for a transmit
+  /// buffer to be free. Otherwise the message is queued and sent by the
+  /// interrupt in order of CAN priority, waiting for space if the transmit
+  /// queue is full. Either way, no message is lost, so callers that must not
+  /// block, such as interrupt service routines, should use TrySend() instead.
+  ///
+  /// In interrupt mode, a full queue can only be drained by whichever task is
+  /// servicing it. If that task was preempted by the caller, spinning here
+  /// would keep it from ever running again, so the wait function given to
+  /// EnableInterruptMode() is called to let it run. Without a wait function,
+  /// Send() must not be called from tasks of different priorities.
+  ///
+  /// @param message - Message containing the CANBUS contents.
   void Send(const Message_t & message) const override
   {
+    if (queues_ != nullptr)
+    {
+      // Move queued messages into free transmit buffers until there is room.
+      while (!queues_->submitted.Push(message))
+      {
+        if (!ServiceTransmitQueue() && wait_function_ != nullptr)
+        {
+          wait_function_();
+        }
+      }
+      ServiceTransmitQueue();
+      return;
+    }
+
     LpcRegisters_t registers = ConvertMessageToRegisters(message);
 
     // Wait for one of the buffers to be free so we can transmit a message
     // through it.
-    bool sent = false;
-    while (!sent)
+    while (true)
     {
       uint32_t status_register = channel_.registers->SR;
       // Check if any buffer is available.
-      if (bit::Read(status_register, BufferStatus::kTx1Released))
+      for (size_t buffer = 0; buffer < kTransmitBufferCount; buffer++)
       {
-        channel_.registers->TFI1 = registers.frame;
-        channel_.registers->TID1 = registers.id;
-        channel_.registers->TDA1 = registers.data_a;
-        channel_.registers->TDB1 = registers.data_b;
-        channel_.registers->CMR  = Value(Commands::kSendTxBuffer1);
-        sent                     = true;
+        if (bit::Read(status_register, kTransmitReleased[buffer]))
+        {
+          WriteTransmitBuffer(buffer, registers);
+          return;
+        }
       }
-      else if (bit::Read(status_register, BufferStatus::kTx2Released))
+    }
+  }
+
+  /// Send a message without waiting. If interrupt mode is enabled, the message
+  /// is queued like Send(), but is dropped and counted in GetStatistics() if
+  /// the transmit queue is full. Otherwise it is written to a free transmit
+  /// buffer, if there is one.
+  ///
+  /// @param message - Message containing the CANBUS contents.
+  /// @return false if the message was dropped.
+  bool TrySend(const Message_t & message) const
+  {
+    if (queues_ != nullptr)
+    {
+      if (!queues_->submitted.Push(message))
       {
-        channel_.registers->TFI2 = registers.frame;
-        channel_.registers->TID2 = registers.id;
-        channel_.registers->TDA2 = registers.data_a;
-        channel_.registers->TDB2 = registers.data_b;
-        channel_.registers->CMR  = Value(Commands::kSendTxBuffer2);
-        sent                     = true;
+        queues_->transmit_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
       }
-      else if (bit::Read(status_register, BufferStatus::kTx3Released))
+      ServiceTransmitQueue();
+      return true;
+    }
+
+    uint32_t status_register = channel_.registers->SR;
+    for (size_t buffer = 0; buffer < kTransmitBufferCount; buffer++)
+    {
+      if (bit::Read(status_register, kTransmitReleased[buffer]))
       {
-        channel_.registers->TFI3 = registers.frame;
-        channel_.registers->TID3 = registers.id;
-        channel_.registers->TDA3 = registers.data_a;
-        channel_.registers->TDB3 = registers.data_b;
-        channel_.registers->CMR  = Value(Commands::kSendTxBuffer3);
-        sent                     = true;
+        WriteTransmitBuffer(buffer, ConvertMessageToRegisters(message));
+        return true;
       }
     }
+    return false;
   }
 
   bool HasData() const override
   {
+    if (queues_ != nullptr)
+    {
+      return !queues_->receive.IsEmpty();
+    }
     // GlobalStatus::kReceiveBuffer returns 1 (true) if it has data.
     return bit::Read(channel_.registers->GSR, GlobalStatus::kReceiveBuffer);
   }
 
   Message_t Receive() const override
   {
-    Message_t message;
-
-    uint32_t frame = channel_.registers->RFS;
+    if (queues_ != nullptr)
+    {
+      Message_t message;
+      if (!queues_->receive.Pop(message))
+      {
+        message.length = 0;
+      }
+      return message;
+    }
+    return ReadReceiveBuffer();
+  }
 
-    // Extract all of the information from the message frame
-    bool is_remote_request = bit::Extract(frame, FrameInfo::kRemoteRequest);
-    uint32_t length        = bit::Extract(frame, FrameInfo::kLength);
-    uint32_t format        = bit::Extract(frame, FrameInfo::kFormat);
+  /// Switch the driver to interrupt mode. The CAN interrupt moves each
+  /// received message into a receive queue, so Receive() and HasData() no
+  /// longer touch the hardware, and feeds queued Send() messages into
+  /// whichever transmit buffer frees up, highest CAN priority first. It also
+  /// counts the bus errors and arbitration losses reported by
+  /// GetErrorStatistics().
+  ///
+  /// CAN1 and CAN2 share a single interrupt, so both may be in interrupt mode
+  /// at the same time, each with its own queues.
+  ///
+  /// @param queues - queues for this channel. Must outlive the driver, or
+  ///        DisableInterruptMode() must be called before they are destroyed.
+  /// @param wait_function - called by Send() while the transmit queue is full
+  ///        and cannot be drained, such as when the task servicing it has been
+  ///        preempted. Should block the calling task for a short time, for
+  ///        example `[]() { vTaskDelay(1); }` with FreeRTOS. Required if Send()
+  ///        is called from tasks of different priorities.
+  void EnableInterruptMode(Queues_t & queues,
+                           WaitFunction wait_function = nullptr) const
+  {
+    queues_                                   = &queues;
+    wait_function_                            = wait_function;
+    interrupt_driven_channels[ChannelIndex()] = this;
+
+    sjsu::InterruptController::GetPlatformController().Enable({
+        .interrupt_request_number = lpc40xx::CAN_IRQn,
+        .interrupt_handler        = InterruptHandler,
+    });
+
+    uint32_t enabled = 0;
+    enabled          = bit::Set(enabled, Interrupts::kRxBufferFull);
+    enabled          = bit::Set(enabled, Interrupts::kDataOverrun);
+    enabled          = bit::Set(enabled, Interrupts::kTx1Ready);
+    enabled          = bit::Set(enabled, Interrupts::kTx2Ready);
+    enabled          = bit::Set(enabled, Interrupts::kTx3Ready);
+    enabled          = bit::Set(enabled, Interrupts::kArbitrationLost);
+    enabled          = bit::Set(enabled, Interrupts::kBusError);
+
+    channel_.registers->IER = enabled;
+  }
 
-    message.is_remote_request = is_remote_request;
-    message.length            = static_cast<uint8_t>(length);
-    message.format            = static_cast<Message_t::Format>(format);
+  /// Return the driver to polled mode. Messages left in the receive queue and
+  /// messages not yet loaded into a transmit buffer are discarded.
+  void DisableInterruptMode() const
+  {
+    channel_.registers->IER                   = 0;
+    interrupt_driven_channels[ChannelIndex()] = nullptr;
+    queues_                                   = nullptr;
+    wait_function_                            = nullptr;
+  }
 
-    // Get the frame ID
-    message.id = channel_.registers->RID;
+  /// @return the number of messages lost since interrupt mode was enabled.
+  Statistics_t GetStatistics() const
+  {
+    if (queues_ == nullptr)
+    {
+      return Statistics_t{};
+    }
+    return Statistics_t{
+      .receive_overruns =
+          queues_->receive_overruns.load(std::memory_order_relaxed),
+      .receive_dropped =
+          queues_->receive_dropped.load(std::memory_order_relaxed),
+      .transmit_dropped =
+          queues_->transmit_dropped.load(std::memory_order_relaxed),
+    };
+  }
 
-    // Pull the bytes from RDA into the payload array
-    message.payload[0] = (channel_.registers->RDA >> (0 * 8)) & 0xFF;
-    message.payload[1] = (channel_.registers->RDA >> (1 * 8)) & 0xFF;
-    message.payload[2] = (channel_.registers->RDA >> (2 * 8)) & 0xFF;
-    message.payload[3] = (channel_.registers->RDA >> (3 * 8)) & 0xFF;
-    // Pull the bytes from RDB into the payload array
-    message.payload[4] = (channel_.registers->RDB >> (0 * 8)) & 0xFF;
-    message.payload[5] = (channel_.registers->RDB >> (1 * 8)) & 0xFF;
-    message.payload[6] = (channel_.registers->RDB >> (2 * 8)) & 0xFF;
-    message.payload[7] = (channel_.registers->RDB >> (3 * 8)) & 0xFF;
+  /// The error counters are read in any mode, but bus errors and arbitration
+  /// losses are only counted while in interrupt mode, as the controller only
+  /// captures them for enabled interrupts.
+  ///
+  /// @return the controller's error counters and the bus errors and
+  ///         arbitration losses since interrupt mode was enabled.
+  ErrorStatistics_t GetErrorStatistics() const override
+  {
+    uint32_t global_status       = channel_.registers->GSR;
+    ErrorStatistics_t statistics = {
+      .transmit_error_count = static_cast<uint8_t>(
+          bit::Extract(global_status, GlobalStatus::kTransmitErrorCounter)),
+      .receive_error_count = static_cast<uint8_t>(
+          bit::Extract(global_status, GlobalStatus::kReceiveErrorCounter)),
+      .bus_off = bit::Read(global_status, GlobalStatus::kBusError),
+    };
 
-    // Release the RX buffer and allow another buffer to be read.
-    channel_.registers->CMR = Value(Commands::kReleaseRxBuffer);
+    if (queues_ != nullptr)
+    {
+      for (size_t i = 0; i < statistics.bus_errors.size(); i++)
+      {
+        statistics.bus_errors[i] =
+            queues_->bus_errors[i].load(std::memory_order_relaxed);
+      }
+      for (size_t i = 0; i < statistics.arbitration_lost.size(); i++)
+      {
+        statistics.arbitration_lost[i] =
+            queues_->arbitration_lost[i].load(std::memory_order_relaxed);
+      }
+    }
+    return statistics;
+  }
 
-    return message;
+  /// Handler for the interrupt shared by CAN1 and CAN2. Services every channel
+  /// in interrupt mode.
+  static void InterruptHandler()
+  {
+    for (const Can * can : interrupt_driven_channels)
+    {
+      if (can != nullptr)
+      {
+        can->ServiceInterrupt();
+      }
+    }
   }
 
   bool SelfTest(uint32_t id) const override
@@ -559,6 +970,277 @@ class Can final : public sjsu::Can
   }
 
  private:
+  /// Standard lookup table entry that never matches, used to pad the standard
+  /// ID section to a whole number of words.
+  static constexpr uint32_t kDisabledStandardEntry = 0xF7FF;
+
+  /// @return a 16-bit standard ID lookup table entry.
+  static constexpr uint32_t StandardEntry(uint32_t channel, uint32_t id)
+  {
+    return (channel << 13) | id;
+  }
+
+  /// @return a 32-bit extended ID lookup table entry.
+  static constexpr uint32_t ExtendedEntry(uint32_t channel, uint32_t id)
+  {
+    return (channel << 29) | id;
+  }
+
+  /// Released flag of each transmit buffer in the SR register.
+  static constexpr std::array<bit::Mask, kTransmitBufferCount>
+      kTransmitReleased = {
+        BufferStatus::kTx1Released,
+        BufferStatus::kTx2Released,
+        BufferStatus::kTx3Released,
+      };
+
+  /// Command that sends each transmit buffer.
+  static constexpr std::array<Commands, kTransmitBufferCount> kSendTransmit = {
+    Commands::kSendTxBuffer1,
+    Commands::kSendTxBuffer2,
+    Commands::kSendTxBuffer3,
+  };
+
+  /// Channels in interrupt mode, indexed by ChannelIndex().
+  inline static std::array<const Can *, 2> interrupt_driven_channels = {};
+
+  /// @return the index of this channel in interrupt_driven_channels.
+  size_t ChannelIndex() const
+  {
+    constexpr auto kCan2 = SystemController::Peripherals::kCan2;
+    return (channel_.id.device_id == kCan2.device_id) ? 1 : 0;
+  }
+
+  /// Service this channel's interrupt: read a received message, if any, and
+  /// feed the transmit buffers that have been released.
+  void ServiceInterrupt() const
+  {
+    // Reading ICR clears its interrupt flags.
+    uint32_t interrupts = channel_.registers->ICR;
+
+    if (bit::Read(interrupts, Interrupts::kDataOverrun))
+    {
+      queues_->receive_overruns.fetch_add(1, std::memory_order_relaxed);
+      channel_.registers->CMR = Value(Commands::kClearDataOverrun);
+    }
+
+    // The capture fields are only valid along with their interrupt flag.
+    if (bit::Read(interrupts, Interrupts::kBusError))
+    {
+      uint32_t type = bit::Extract(interrupts, Interrupts::kErrorCodeType);
+      queues_->bus_errors[type].fetch_add(1, std::memory_order_relaxed);
+    }
+    if (bit::Read(interrupts, Interrupts::kArbitrationLost))
+    {
+      uint32_t position =
+          bit::Extract(interrupts, Interrupts::kArbitrationLostLocation);
+      position = std::min<uint32_t>(position, kArbitrationBits - 1);
+      queues_->arbitration_lost[position].fetch_add(1,
+                                                    std::memory_order_relaxed);
+    }
+
+    // The receive interrupt stays asserted while another message is waiting
+    // in the hardware buffer, so one message is read per interrupt.
+    if (bit::Read(channel_.registers->GSR, GlobalStatus::kReceiveBuffer))
+    {
+      if (!queues_->receive.Push(ReadReceiveBuffer()))
+      {
+        queues_->receive_dropped.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+    ServiceTransmitQueue();
+  }
+
+  /// Load the highest priority queued messages into the released transmit
+  /// buffers. Called by both Send() and the interrupt.
+  ///
+  /// Never blocks: if the queue is already being serviced by a task that this
+  /// call preempted, a request is left for that task to service it again once
+  /// it is done.
+  ///
+  /// @return true if any message was moved out of the submitted queue or into
+  ///         a transmit buffer.
+  bool ServiceTransmitQueue() const
+  {
+    Queues_t & queues  = *queues_;
+    bool made_progress = false;
+    queues.transmit_pending.store(true, std::memory_order_release);
+
+    while (queues.transmit_pending.load(std::memory_order_acquire) &&
+           !queues.transmit_lock.exchange(true, std::memory_order_acquire))
+    {
+      queues.transmit_pending.store(false, std::memory_order_relaxed);
+
+      Message_t message;
+      while (queues.transmit_size < queues.transmit.size() &&
+             queues.submitted.Pop(message))
+      {
+        made_progress = true;
+        queues.transmit[queues.transmit_size++] = {
+          .message = message,
+          .order   = queues.transmit_order++,
+        };
+        std::push_heap(queues.transmit.begin(),
+                       queues.transmit.begin() + queues.transmit_size,
+                       IsSentAfter);
+      }
+
+      uint32_t status_register = channel_.registers->SR;
+      for (size_t buffer = 0; buffer < kTransmitBufferCount; buffer++)
+      {
+        if (bit::Read(status_register, kTransmitReleased[buffer]))
+        {
+          queues.in_flight[buffer] = false;
+        }
+      }
+
+      for (size_t buffer = 0; buffer < kTransmitBufferCount; buffer++)
+      {
+        if (queues.transmit_size == 0)
+        {
+          break;
+        }
+        if (!bit::Read(status_register, kTransmitReleased[buffer]) ||
+            queues.in_flight[buffer])
+        {
+          continue;
+        }
+
+        const Message_t & next = queues.transmit.front().message;
+        uint32_t key           = ArbitrationKey(next);
+        if (IsInFlight(queues, key))
+        {
+          // The hardware may send its buffers in any order when their IDs are
+          // equal, so wait for the earlier message with this ID to be sent.
+          break;
+        }
+
+        WriteTransmitBuffer(buffer, ConvertMessageToRegisters(next));
+        queues.in_flight[buffer]     = true;
+        queues.in_flight_key[buffer] = key;
+        made_progress                = true;
+
+        std::pop_heap(queues.transmit.begin(),
+                      queues.transmit.begin() + queues.transmit_size,
+                      IsSentAfter);
+        queues.transmit_size--;
+      }
+
+      queues.transmit_lock.store(false, std::memory_order_release);
+    }
+
+    return made_progress;
+  }
+
+  /// @return true if a transmit buffer holds a message with the same ID.
+  static bool IsInFlight(const Queues_t & queues, uint32_t key)
+  {
+    for (size_t buffer = 0; buffer < kTransmitBufferCount; buffer++)
+    {
+      if (queues.in_flight[buffer] && queues.in_flight_key[buffer] == key)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// @return a key that orders messages the way they win bus arbitration, the
+  ///         lowest key first. An extended message is ordered by its 11 most
+  ///         significant ID bits, then loses to a standard message with those
+  ///         same bits, then is ordered by its remaining 18 ID bits.
+  static uint32_t ArbitrationKey(const Message_t & message)
+  {
+    if (message.format == Message_t::Format::kExtended)
+    {
+      return ((message.id >> 18) << 19) | (1 << 18) | (message.id & 0x3'FFFF);
+    }
+    return message.id << 19;
+  }
+
+  /// Heap comparison placing the message to send next at the front of the
+  /// transmit queue. Messages with equal IDs are sent in the order they were
+  /// queued.
+  static bool IsSentAfter(const Queues_t::PendingMessage_t & a,
+                          const Queues_t::PendingMessage_t & b)
+  {
+    uint32_t a_key = ArbitrationKey(a.message);
+    uint32_t b_key = ArbitrationKey(b.message);
+    if (a_key != b_key)
+    {
+      return a_key > b_key;
+    }
+    return static_cast<int32_t>(a.order - b.order) > 0;
+  }
+
+  /// Write a message into a transmit buffer and send it.
+  ///
+  /// @param buffer - index of the transmit buffer, 0 to 2.
+  /// @param registers - contents of the message.
+  void WriteTransmitBuffer(size_t buffer,
+                           const LpcRegisters_t & registers) const
+  {
+    switch (buffer)
+    {
+      case 0:
+        channel_.registers->TFI1 = registers.frame;
+        channel_.registers->TID1 = registers.id;
+        channel_.registers->TDA1 = registers.data_a;
+        channel_.registers->TDB1 = registers.data_b;
+        break;
+      case 1:
+        channel_.registers->TFI2 = registers.frame;
+        channel_.registers->TID2 = registers.id;
+        channel_.registers->TDA2 = registers.data_a;
+        channel_.registers->TDB2 = registers.data_b;
+        break;
+      default:
+        channel_.registers->TFI3 = registers.frame;
+        channel_.registers->TID3 = registers.id;
+        channel_.registers->TDA3 = registers.data_a;
+        channel_.registers->TDB3 = registers.data_b;
+        break;
+    }
+    channel_.registers->CMR = Value(kSendTransmit[buffer]);
+  }
+
+  /// Read the message in the receive buffer and release the buffer.
+  Message_t ReadReceiveBuffer() const
+  {
+    Message_t message;
+
+    uint32_t frame = channel_.registers->RFS;
+
+    // Extract all of the information from the message frame
+    bool is_remote_request = bit::Extract(frame, FrameInfo::kRemoteRequest);
+    uint32_t length        = bit::Extract(frame, FrameInfo::kLength);
+    uint32_t format        = bit::Extract(frame, FrameInfo::kFormat);
+
+    message.is_remote_request = is_remote_request;
+    message.length            = static_cast<uint8_t>(length);
+    message.format            = static_cast<Message_t::Format>(format);
+
+    // Get the frame ID
+    message.id = channel_.registers->RID;
+
+    // Pull the bytes from RDA into the payload array
+    message.payload[0] = (channel_.registers->RDA >> (0 * 8)) & 0xFF;
+    message.payload[1] = (channel_.registers->RDA >> (1 * 8)) & 0xFF;
+    message.payload[2] = (channel_.registers->RDA >> (2 * 8)) & 0xFF;
+    message.payload[3] = (channel_.registers->RDA >> (3 * 8)) & 0xFF;
+    // Pull the bytes from RDB into the payload array
+    message.payload[4] = (channel_.registers->RDB >> (0 * 8)) & 0xFF;
+    message.payload[5] = (channel_.registers->RDB >> (1 * 8)) & 0xFF;
+    message.payload[6] = (channel_.registers->RDB >> (2 * 8)) & 0xFF;
+    message.payload[7] = (channel_.registers->RDB >> (3 * 8)) & 0xFF;
+
+    // Release the RX buffer and allow another buffer to be read.
+    channel_.registers->CMR = Value(Commands::kReleaseRxBuffer);
+
+    return message;
+  }
+
   /// Convert message into the registers LPC40xx can bus registers.
   ///
   /// @param message - message to convert.
@@ -609,6 +1291,8 @@ class Can final : public sjsu::Can
   }
 
   const Channel_t & channel_;
+  mutable Queues_t * queues_          = nullptr;
+  mutable WaitFunction wait_function_ = nullptr;
 };
 }  // namespace lpc40xx
 }  // namespace sjsu
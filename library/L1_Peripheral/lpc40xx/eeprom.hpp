@@ -1,6 +1,8 @@
 #pragma once
 
+#include <array>
 #include <chrono>
+#include <cstdint>
 
 #include "L0_Platform/lpc40xx/LPC40xx.h"
 #include "L1_Peripheral/lpc40xx/system_controller.hpp"
@@ -48,6 +50,29 @@ class Eeprom final : public sjsu::Storage
   /// Max timeout for program/write operations in milliseconds
   static constexpr std::chrono::milliseconds kMaxTimeout = 5ms;
 
+  /// Number of bytes in an EEPROM page. Each erase/program cycle writes back
+  /// one whole page.
+  static constexpr size_t kPageSize = 64;
+
+  /// Number of 32-bit words in an EEPROM page
+  static constexpr size_t kWordsPerPage = kPageSize / sizeof(uint32_t);
+
+  /// Number of pages the write coalescing buffer can hold before the least
+  /// recently written page must be evicted and programmed.
+  static constexpr size_t kCachedPages = 4;
+
+  /// @param coalesce_writes - if true, writes are held in a small RAM buffer
+  ///        and each dirty page is programmed once, when Flush() is called or
+  ///        when the page is evicted to make room for another page. This
+  ///        saves a multi-millisecond program cycle (and page wear) for every
+  ///        small write that lands in an already dirty page. Data in the
+  ///        buffer is lost on reset, so Flush() must be called before any
+  ///        point where the data is expected to be durable.
+  explicit Eeprom(bool coalesce_writes = false)
+      : coalesce_writes_(coalesce_writes)
+  {
+  }
+
   Type GetMemoryType() override
   {
     return Type::kEeprom;
@@ -99,6 +124,7 @@ class Eeprom final : public sjsu::Storage
 
   Returns<void> Disable() override
   {
+    SJ2_RETURN_ON_ERROR(Flush());
     eeprom_register->PWRDWN = 1;
     return {};
   }
@@ -125,64 +151,42 @@ class Eeprom final : public sjsu::Storage
 
   Returns<void> Write(uint32_t address, const void * data, size_t size) override
   {
-    constexpr bit::Mask kLower6Bits = bit::MaskFromRange(0, 5);
-    constexpr bit::Mask kUpper6Bits = bit::MaskFromRange(6, 11);
-
     address = bit::Clear(address, kAddressMask);
 
     // Because the EEPROM uses 32-bit communication, write_data will be cast
     // into a uint32_t *
     const uint32_t * write_data = reinterpret_cast<const uint32_t *>(data);
 
-    // The first 6 bits in the address (MSB) dictate which page is being written
-    // to in the EEPROM, and the last 6 bits (LSB) dictate offset in the page
-    uint32_t page_count  = bit::Extract(address, kUpper6Bits);
-    uint32_t page_offset = bit::Extract(address, kLower6Bits);
-
-    uint16_t eeprom_address = 0;
-
-    for (size_t i = 0; (i * 4) < size; i++)
+    if (coalesce_writes_)
     {
-      // Page offset is incremented by 4 because we're writing 32 bits
-      constexpr uint8_t kOffsetInterval = 4;
-
-      eeprom_address = static_cast<uint16_t>((page_count << 6) + page_offset);
-
-      eeprom_register->ADDR  = eeprom_address;
-      eeprom_register->CMD   = kWrite32Bits;
-      eeprom_register->WDATA = write_data[i];
-
-      // Poll status register bit to see when writing is finished
-      auto check_register = []() {
-        return bit::Read(eeprom_register->INT_STATUS,
-                         StatusRegister::kReadWriteStatusMask);
-      };
-
-      auto timeout_status = Wait(kMaxTimeout, check_register);
-      if (!IsOk(timeout_status))
+      for (size_t i = 0; (i * 4) < size; i++)
       {
-        return Error(Status::kTimedOut,
-                     "Could not write to EEPROM in time.");
+        SJ2_RETURN_ON_ERROR(BufferWord(address + (i * 4), write_data[i]));
       }
+      return {};
+    }
 
-      // Clear write interrupt
-      eeprom_register->INT_CLR_STATUS =
-          (bit::Set(0, StatusRegister::kReadWriteStatusMask));
+    uint32_t eeprom_address = address;
 
-      page_offset += kOffsetInterval;
+    for (size_t i = 0; (i * 4) < size; i++)
+    {
+      eeprom_address = address + (i * 4);
+      SJ2_RETURN_ON_ERROR(WriteWord(eeprom_address, write_data[i]));
 
       // If the 64 byte page buffer fills up, then it must be
       // programmed to the EEPROM before continuing.
-      if (page_offset == 64)
+      if (((eeprom_address + 4) % kPageSize) == 0)
       {
         Program(eeprom_address);
-        page_count++;
-        page_offset = 0;
       }
     }
 
-    // Program final information so that it's stored in the EEPROM
-    Program(eeprom_address);
+    // Program final information so that it's stored in the EEPROM, unless the
+    // write ended on a page boundary, in which case it was just programmed.
+    if (((eeprom_address + 4) % kPageSize) != 0)
+    {
+      Program(eeprom_address);
+    }
 
     return {};
   }
@@ -197,7 +201,22 @@ class Eeprom final : public sjsu::Storage
 
     for (uint16_t index = 0; (index * 4) < size; index++)
     {
-      eeprom_register->ADDR = address + (index * 4);
+      const uint32_t kWordAddress = address + (index * 4);
+
+      // Words that are still waiting in the write buffer are newer than what
+      // is stored in the EEPROM.
+      if (coalesce_writes_)
+      {
+        const CachedPage_t * page = FindCachedPage(kWordAddress / kPageSize);
+        const uint32_t kWord      = WordIndex(kWordAddress);
+        if (page != nullptr && bit::Read(page->dirty, kWord))
+        {
+          read_data[index] = page->words[kWord];
+          continue;
+        }
+      }
+
+      eeprom_register->ADDR = kWordAddress;
       eeprom_register->CMD  = kRead32Bits;
       read_data[index]      = eeprom_register->RDATA;
     }
@@ -205,13 +224,153 @@ class Eeprom final : public sjsu::Storage
     return {};
   }
 
+  /// Program every dirty page held in the write coalescing buffer into the
+  /// EEPROM. Does nothing if write coalescing is disabled or if the buffer is
+  /// empty.
+  Returns<void> Flush()
+  {
+    for (auto & page : cache_)
+    {
+      SJ2_RETURN_ON_ERROR(ProgramCachedPage(page));
+    }
+    return {};
+  }
+
+  /// @return the number of erase/program cycles issued since this object was
+  ///         created. Useful for estimating EEPROM wear.
+  uint32_t GetProgramCount() const
+  {
+    return program_count_;
+  }
+
  private:
+  /// A page held in the write coalescing buffer. Only the words marked in
+  /// `dirty` are valid and will be written back to the EEPROM.
+  struct CachedPage_t
+  {
+    /// Page number within the EEPROM
+    uint32_t page = 0;
+    /// Bit mask of the words within `words` that have been written. A value
+    /// of 0 means that this entry is free.
+    uint16_t dirty = 0;
+    /// Value of `write_sequence_` when this page was last written. Used to
+    /// pick the least recently written page for eviction.
+    uint32_t last_write = 0;
+    /// Buffered word values
+    std::array<uint32_t, kWordsPerPage> words = {};
+  };
+
+  static constexpr uint32_t WordIndex(uint32_t address)
+  {
+    return (address % kPageSize) / sizeof(uint32_t);
+  }
+
+  /// Load a single word into the EEPROM's page register.
+  Returns<void> WriteWord(uint32_t address, uint32_t data)
+  {
+    eeprom_register->ADDR  = address;
+    eeprom_register->CMD   = kWrite32Bits;
+    eeprom_register->WDATA = data;
+
+    // Poll status register bit to see when writing is finished
+    auto check_register = []() {
+      return bit::Read(eeprom_register->INT_STATUS,
+                       StatusRegister::kReadWriteStatusMask);
+    };
+
+    auto timeout_status = Wait(kMaxTimeout, check_register);
+    if (!IsOk(timeout_status))
+    {
+      return Error(Status::kTimedOut, "Could not write to EEPROM in time.");
+    }
+
+    // Clear write interrupt
+    eeprom_register->INT_CLR_STATUS =
+        (bit::Set(0, StatusRegister::kReadWriteStatusMask));
+
+    return {};
+  }
+
+  CachedPage_t * FindCachedPage(uint32_t page_number)
+  {
+    for (auto & page : cache_)
+    {
+      if (page.dirty != 0 && page.page == page_number)
+      {
+        return &page;
+      }
+    }
+    return nullptr;
+  }
+
+  /// Store a word in the write coalescing buffer, evicting the least recently
+  /// written page if the word's page is not buffered and the buffer is full.
+  Returns<void> BufferWord(uint32_t address, uint32_t data)
+  {
+    const uint32_t kPageNumber = address / kPageSize;
+    CachedPage_t * page        = FindCachedPage(kPageNumber);
+
+    if (page == nullptr)
+    {
+      page = &cache_[0];
+      for (auto & candidate : cache_)
+      {
+        if (candidate.dirty == 0)
+        {
+          page = &candidate;
+          break;
+        }
+        if (candidate.last_write < page->last_write)
+        {
+          page = &candidate;
+        }
+      }
+
+      SJ2_RETURN_ON_ERROR(ProgramCachedPage(*page));
+      page->page = kPageNumber;
+    }
+
+    const uint32_t kWord = WordIndex(address);
+    page->words[kWord]   = data;
+    page->dirty          = bit::Set(page->dirty, kWord);
+    page->last_write     = ++write_sequence_;
+
+    return {};
+  }
+
+  /// Load the dirty words of a buffered page into the page register and
+  /// program it with a single erase/program cycle. The entry is freed
+  /// afterwards.
+  Returns<void> ProgramCachedPage(CachedPage_t & page)
+  {
+    if (page.dirty == 0)
+    {
+      return {};
+    }
+
+    const uint32_t kPageAddress = page.page * kPageSize;
+    for (uint32_t word = 0; word < kWordsPerPage; word++)
+    {
+      if (bit::Read(page.dirty, word))
+      {
+        const uint32_t kWordAddress = kPageAddress + (word * 4);
+        SJ2_RETURN_ON_ERROR(WriteWord(kWordAddress, page.words[word]));
+      }
+    }
+
+    Program(kPageAddress);
+    page.dirty = 0;
+
+    return {};
+  }
+
   /// The EEPROM is accessed through a 64 byte page buffer, and after it fills
   /// up, it must be programmed to the EEPROM. This function handles that.
   void Program(uint32_t address)
   {
     eeprom_register->ADDR = address;
     eeprom_register->CMD  = kEraseProgram;
+    program_count_++;
 
     // Poll status register bit to see when programming is finished
     auto check_register = []() {
@@ -225,6 +384,11 @@ class Eeprom final : public sjsu::Storage
     eeprom_register->INT_CLR_STATUS =
         (bit::Set(0, StatusRegister::kProgramStatusMask));
   }
+
+  bool coalesce_writes_;
+  uint32_t program_count_  = 0;
+  uint32_t write_sequence_ = 0;
+  std::array<CachedPage_t, kCachedPages> cache_ = {};
 };
 }  // namespace lpc40xx
 }  // namespace sjsu
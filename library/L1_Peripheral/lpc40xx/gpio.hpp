@@ -157,24 +157,20 @@ class Gpio final : public sjsu::Gpio
   }
 
   /// The gpio interrupt handler that calls the attached interrupt callbacks.
+  /// Every pending pin of every port is serviced in a single call, so
+  /// simultaneous edges do not cause repeated interrupt entries.
   static void InterruptHandler()
   {
-    int triggered_port;
-    if constexpr (IsPlatform(sjsu::build::Platform::lpc40xx))
-    {
-      triggered_port = *InterruptStatus() >> 2;
-    }
-    else
+    uint32_t port_status = *InterruptStatus();
+
+    for (uint8_t port = 0; port < kInterruptPorts; port++)
     {
-      triggered_port = *InterruptStatus() >> 2;
+      // Port 0's status is bit 0 and port 2's status is bit 2.
+      if (bit::Read(port_status, port * 2))
+      {
+        ServicePort(port);
+      }
     }
-
-    auto * interrupt  = InterruptRegister(triggered_port);
-    int status        = *interrupt->rising_status | *interrupt->falling_status;
-    int triggered_pin = __builtin_ctz(status);
-
-    handlers[triggered_port][triggered_pin]();
-    *interrupt->clear |= (1 << triggered_pin);
   }
 
   /// For port 0-4, pins 0-31 are available. Port 5 only has pins 0-4 available.
@@ -339,6 +335,31 @@ class Gpio final : public sjsu::Gpio
     return InterruptRegister(interrupt_index_);
   }
 
+  /// Call the handler of every pending pin of a gpio interrupt port.
+  ///
+  /// @param port - index of the interrupt port to service.
+  static void ServicePort(uint8_t port)
+  {
+    auto * interrupt = InterruptRegister(port);
+    uint32_t pending = *interrupt->rising_status | *interrupt->falling_status;
+
+    // Clear every pending pin with a single write before calling the handlers,
+    // so that edges arriving while the handlers run will trigger again.
+    *interrupt->clear = pending;
+
+    while (pending != 0)
+    {
+      // Cortex M3/M4 have a single cycle count leading zeros instruction.
+      uint32_t pin = 31 - __builtin_clz(pending);
+      pending      = bit::Clear(pending, pin);
+
+      if (handlers[port][pin])
+      {
+        handlers[port][pin]();
+      }
+    }
+  }
+
   const sjsu::lpc17xx::Pin kLpc17xxPin;
   const sjsu::lpc40xx::Pin kLpc40xxPin;
   const sjsu::Pin * pin_obj_;
@@ -154,6 +154,7 @@ class I2c final : public sjsu::I2c
     {
       case MasterState::kBusError:  // 0x00
       {
+        i2c.transaction.busy   = false;
         i2c.transaction.status = Status::kBusError;
         set_mask               = Control::kAssertAcknowledge | Control::kStop;
         break;
@@ -305,6 +306,16 @@ class I2c final : public sjsu::I2c
     // Set register controls
     i2c.registers->CONSET = set_mask;
     i2c.registers->CONCLR = clear_mask;
+
+    // Every transaction ends with a stop condition, which is only emitted
+    // once the last byte has been transferred. The handler is cleared before
+    // it is called so that it can start the next transaction.
+    if ((set_mask & Control::kStop) && i2c.transaction.on_complete)
+    {
+      CompletionHandler on_complete = i2c.transaction.on_complete;
+      i2c.transaction.on_complete   = nullptr;
+      on_complete(i2c.transaction.status);
+    }
   }
   /// Constructor for LPC40xx I2c peripheral
   ///
@@ -343,21 +354,86 @@ class I2c final : public sjsu::I2c
                              Control::kStop | Control::kInterrupt;
     i2c_.registers->CONSET = Control::kInterfaceEnable;
 
-    sjsu::InterruptController::GetPlatformController().Enable({
-        .interrupt_request_number = i2c_.irq_number,
-        .interrupt_handler        = [this]() { I2cHandler(i2c_); },
-    });
+    EnableInterrupt();
 
     return {};
   }
 
+  /// @return Status::kNotReadyYet if an asynchronous transaction is still in
+  ///         progress.
   Returns<void> Transaction(Transaction_t transaction) const override
   {
+    if (i2c_.transaction.on_complete)
+    {
+      return Error(Status::kNotReadyYet,
+                   "An asynchronous I2C transaction is in progress.");
+    }
+
     i2c_.transaction       = transaction;
     i2c_.registers->CONSET = Control::kStart;
     return BlockUntilFinished();
   }
 
+  /// Starts the transaction and returns immediately. `on_complete` is called
+  /// from I2cHandler() once the stop condition has been issued.
+  ///
+  /// @return Status::kNotReadyYet if the peripheral is not initialized or if
+  ///         an asynchronous transaction is still in progress.
+  Returns<void> TransactionAsync(Transaction_t transaction,
+                                 CompletionHandler on_complete) const override
+  {
+    if constexpr (build::kPlatform != build::Platform::host)
+    {
+      if (!IsIntialized())
+      {
+        return Error(Status::kNotReadyYet,
+                     "Attempted to use I2C, but peripheral was not "
+                     "initialized! Be sure to run the Initialize() method "
+                     "first");
+      }
+    }
+
+    if (i2c_.transaction.on_complete)
+    {
+      return Error(Status::kNotReadyYet,
+                   "An asynchronous I2C transaction is already in progress.");
+    }
+
+    transaction.busy        = true;
+    transaction.status      = Status::kSuccess;
+    transaction.on_complete = on_complete;
+    i2c_.transaction        = transaction;
+    i2c_.registers->CONSET  = Control::kStart;
+    return {};
+  }
+
+  /// Issues a stop condition and resets the transaction state, so that a
+  /// transaction stuck waiting on the bus no longer blocks the peripheral.
+  /// The interrupt is disabled while the state is reset, so that I2cHandler()
+  /// cannot complete the transaction at the same time.
+  bool CancelTransactionAsync() const override
+  {
+    auto & interrupt_controller =
+        sjsu::InterruptController::GetPlatformController();
+    interrupt_controller.Disable(i2c_.irq_number);
+
+    CompletionHandler on_complete = i2c_.transaction.on_complete;
+    i2c_.transaction.on_complete  = nullptr;
+    i2c_.transaction.busy         = false;
+    i2c_.transaction.status       = Status::kTimedOut;
+    i2c_.registers->CONSET = Control::kAssertAcknowledge | Control::kStop;
+    i2c_.registers->CONCLR = Control::kStart | Control::kInterrupt;
+
+    EnableInterrupt();
+
+    if (!on_complete)
+    {
+      return false;
+    }
+    on_complete(Status::kTimedOut);
+    return true;
+  }
+
   /// Special method that returns the current state of the transaction.
   const Transaction_t GetTransactionInfo()
   {
@@ -372,6 +448,16 @@ class I2c final : public sjsu::I2c
   }
 
  private:
+  /// Registers I2cHandler() as the interrupt service routine for this
+  /// peripheral.
+  void EnableInterrupt() const
+  {
+    sjsu::InterruptController::GetPlatformController().Enable({
+        .interrupt_request_number = i2c_.irq_number,
+        .interrupt_handler        = [this]() { I2cHandler(i2c_); },
+    });
+  }
+
   /// Since this I2C implementation utilizes interrupts, while the transaction
   /// is happening, on the bus, block the sequence of execution until the
   /// transaction has completed, OR the timeout has elapsed.
@@ -417,6 +417,382 @@ TEST_CASE("Testing lpc40xx Can")
           bit::Extract(local_can.BTR, Can::BusTiming::kSampling));
   }
 
+  SECTION("Interrupt mode")
+  {
+    // Setup
+    Mock<sjsu::InterruptController> mock_interrupt_controller;
+    Fake(Method(mock_interrupt_controller, Enable));
+    sjsu::InterruptController::SetPlatformController(
+        &mock_interrupt_controller.get());
+
+    Can::Queues_t queues;
+    test_can.EnableInterruptMode(queues);
+
+    auto make_message = [](uint32_t id, uint8_t first_byte) {
+      Can::Message_t message;
+      message.id      = id;
+      message.length  = 1;
+      message.payload = { first_byte, 0, 0, 0, 0, 0, 0, 0 };
+      return message;
+    };
+
+    SECTION("EnableInterruptMode()")
+    {
+      // Verify
+      Verify(Method(mock_interrupt_controller, Enable)
+                 .Matching([](sjsu::InterruptController::RegistrationInfo_t
+                                  info) {
+                   return info.interrupt_request_number == CAN_IRQn;
+                 }));
+      CHECK(bit::Read(local_can.IER, Can::Interrupts::kRxBufferFull));
+      CHECK(bit::Read(local_can.IER, Can::Interrupts::kDataOverrun));
+      CHECK(bit::Read(local_can.IER, Can::Interrupts::kTx1Ready));
+      CHECK(bit::Read(local_can.IER, Can::Interrupts::kTx2Ready));
+      CHECK(bit::Read(local_can.IER, Can::Interrupts::kTx3Ready));
+      CHECK(bit::Read(local_can.IER, Can::Interrupts::kArbitrationLost));
+      CHECK(bit::Read(local_can.IER, Can::Interrupts::kBusError));
+    }
+
+    SECTION("Receive() reads messages queued by the interrupt")
+    {
+      // Setup
+      local_can.GSR = bit::Set(0, Can::GlobalStatus::kReceiveBuffer);
+      local_can.RFS = bit::Insert(0, 1, Can::FrameInfo::kLength);
+      local_can.RID = 0x123;
+      local_can.RDA = 0xAB;
+      CHECK(!test_can.HasData());
+
+      // Exercise
+      Can::InterruptHandler();
+      local_can.RID = 0x124;
+      Can::InterruptHandler();
+
+      // Verify
+      CHECK(Value(Can::Commands::kReleaseRxBuffer) == local_can.CMR);
+      REQUIRE(test_can.HasData());
+      Can::Message_t first = test_can.Receive();
+      CHECK(0x123 == first.id);
+      CHECK(1 == first.length);
+      CHECK(0xAB == first.payload[0]);
+      CHECK(0x124 == test_can.Receive().id);
+      CHECK(!test_can.HasData());
+      CHECK(0 == test_can.Receive().length);
+    }
+
+    SECTION("Counts overruns and dropped received messages")
+    {
+      // Setup
+      local_can.GSR = bit::Set(0, Can::GlobalStatus::kReceiveBuffer);
+      local_can.ICR = bit::Set(0, Can::Interrupts::kDataOverrun);
+      Can::InterruptHandler();
+      local_can.ICR = 0;
+
+      // Exercise
+      for (size_t i = 0; i < config::kCanReceiveQueueSize; i++)
+      {
+        Can::InterruptHandler();
+      }
+
+      // Verify
+      CHECK(1 == test_can.GetStatistics().receive_overruns);
+      CHECK(1 == test_can.GetStatistics().receive_dropped);
+    }
+
+    SECTION("GetErrorStatistics()")
+    {
+      // Setup
+      uint32_t stuff_error = 0;
+      stuff_error          = bit::Set(stuff_error, Can::Interrupts::kBusError);
+      stuff_error =
+          bit::Insert(stuff_error, 0b10, Can::Interrupts::kErrorCodeType);
+      uint32_t arbitration_lost = 0;
+      arbitration_lost =
+          bit::Set(arbitration_lost, Can::Interrupts::kArbitrationLost);
+      arbitration_lost = bit::Insert(arbitration_lost, 5,
+                                     Can::Interrupts::kArbitrationLostLocation);
+
+      local_can.GSR = 0;
+      local_can.GSR = bit::Insert(local_can.GSR, 200,
+                                  Can::GlobalStatus::kTransmitErrorCounter);
+      local_can.GSR = bit::Insert(local_can.GSR, 3,
+                                  Can::GlobalStatus::kReceiveErrorCounter);
+
+      // Exercise
+      local_can.ICR = stuff_error;
+      Can::InterruptHandler();
+      Can::InterruptHandler();
+      local_can.ICR = arbitration_lost;
+      Can::InterruptHandler();
+      local_can.ICR = 0;
+      auto statistics = test_can.GetErrorStatistics();
+
+      // Verify
+      CHECK(200 == statistics.transmit_error_count);
+      CHECK(3 == statistics.receive_error_count);
+      CHECK(!statistics.bus_off);
+      CHECK(2 == statistics.bus_errors[Value(Can::BusError::kStuff)]);
+      CHECK(0 == statistics.bus_errors[Value(Can::BusError::kBit)]);
+      CHECK(1 == statistics.arbitration_lost[5]);
+    }
+
+    SECTION("Send() transmits the highest priority message first")
+    {
+      // Setup
+      local_can.SR = 0;
+
+      // Exercise
+      test_can.Send(make_message(0x300, 1));
+      test_can.Send(make_message(0x100, 2));
+      test_can.Send(make_message(0x200, 3));
+
+      // Verify: No buffer is released, so nothing is sent yet
+      CHECK(0 == local_can.TID1);
+
+      // Exercise
+      local_can.SR = bit::Set(0, Can::BufferStatus::kTx1Released);
+      Can::InterruptHandler();
+
+      // Verify
+      CHECK(0x100 == local_can.TID1);
+      CHECK(Value(Can::Commands::kSendTxBuffer1) == local_can.CMR);
+
+      // Exercise
+      local_can.SR = bit::Set(0, Can::BufferStatus::kTx3Released);
+      Can::InterruptHandler();
+
+      // Verify
+      CHECK(0x200 == local_can.TID3);
+      CHECK(3 == local_can.TDA3);
+      CHECK(Value(Can::Commands::kSendTxBuffer3) == local_can.CMR);
+    }
+
+    SECTION("Standard IDs win over extended IDs with the same base ID")
+    {
+      // Setup
+      Can::Message_t extended = make_message(0x100 << 18, 1);
+      extended.format         = Can::Message_t::Format::kExtended;
+      Can::Message_t standard = make_message(0x100, 2);
+      Can::Message_t lower    = make_message(0x0FF, 3);
+      local_can.SR            = 0;
+      test_can.Send(extended);
+      test_can.Send(standard);
+      test_can.Send(lower);
+
+      // Exercise & Verify
+      local_can.SR = bit::Set(0, Can::BufferStatus::kTx1Released);
+      Can::InterruptHandler();
+      CHECK(0x0FF == local_can.TID1);
+
+      local_can.SR = bit::Set(0, Can::BufferStatus::kTx1Released);
+      Can::InterruptHandler();
+      CHECK(0x100 == local_can.TID1);
+
+      local_can.SR = bit::Set(0, Can::BufferStatus::kTx1Released);
+      Can::InterruptHandler();
+      CHECK(extended.id == local_can.TID1);
+    }
+
+    SECTION("Messages with the same ID are sent in order")
+    {
+      // Setup
+      local_can.SR = bit::Set(0, Can::BufferStatus::kTx1Released);
+      local_can.SR = bit::Set(local_can.SR, Can::BufferStatus::kTx2Released);
+      local_can.SR = bit::Set(local_can.SR, Can::BufferStatus::kTx3Released);
+
+      // Exercise
+      test_can.Send(make_message(0x5, 1));
+      // Simulate buffer 1 sending its message
+      local_can.SR = bit::Clear(local_can.SR, Can::BufferStatus::kTx1Released);
+      test_can.Send(make_message(0x5, 2));
+
+      // Verify: The second message waits for the first to be sent
+      CHECK(1 == local_can.TDA1);
+      CHECK(0 == local_can.TID2);
+
+      // Exercise
+      local_can.SR = bit::Set(local_can.SR, Can::BufferStatus::kTx1Released);
+      Can::InterruptHandler();
+
+      // Verify
+      CHECK(2 == local_can.TDA1);
+    }
+
+    SECTION("TrySend() counts dropped transmit messages")
+    {
+      // Setup
+      local_can.SR = 0;
+
+      // Exercise
+      for (size_t i = 0; i < 2 * config::kCanTransmitQueueSize; i++)
+      {
+        CHECK(test_can.TrySend(make_message(0x10, 0)));
+      }
+      bool sent = test_can.TrySend(make_message(0x10, 0));
+
+      // Verify
+      CHECK(!sent);
+      CHECK(1 == test_can.GetStatistics().transmit_dropped);
+    }
+
+    SECTION("Send() waits for space in a full transmit queue")
+    {
+      // Setup
+      local_can.SR = 0;
+      for (size_t i = 0; i < 2 * config::kCanTransmitQueueSize; i++)
+      {
+        test_can.Send(make_message(0x10, static_cast<uint8_t>(i)));
+      }
+
+      std::thread release_tx1([&local_can]() {
+        std::this_thread::sleep_for(1ms);
+        local_can.SR = bit::Set(0, Can::BufferStatus::kTx1Released);
+      });
+
+      // Exercise
+      test_can.Send(make_message(0x10, 0xAA));
+      release_tx1.join();
+
+      // Verify: queued messages were sent to make room for the new one, which
+      // still waits behind the earlier messages with the same ID
+      CHECK(0 == test_can.GetStatistics().transmit_dropped);
+      CHECK(0x10 == local_can.TID1);
+      CHECK(0xAA != local_can.TDA1);
+    }
+
+    SECTION("Send() waits instead of spinning while the queue is held")
+    {
+      // Setup: The queue is full and is being serviced by a task that Send()
+      //        preempted, which the wait function lets finish.
+      static Can::Queues_t * held_queues;
+      static LPC_CAN_TypeDef * held_can;
+      static int waits;
+      held_queues = &queues;
+      held_can    = &local_can;
+      waits       = 0;
+      test_can.EnableInterruptMode(queues, []() {
+        waits++;
+        held_can->SR = bit::Set(0, Can::BufferStatus::kTx1Released);
+        held_queues->transmit_lock.store(false);
+      });
+
+      local_can.SR = 0;
+      for (size_t i = 0; i < 2 * config::kCanTransmitQueueSize; i++)
+      {
+        test_can.Send(make_message(0x10, static_cast<uint8_t>(i)));
+      }
+      queues.transmit_lock.store(true);
+
+      // Exercise
+      test_can.Send(make_message(0x10, 0xAA));
+
+      // Verify
+      CHECK(1 == waits);
+      CHECK(0 == test_can.GetStatistics().transmit_dropped);
+      CHECK(0x10 == local_can.TID1);
+    }
+
+    SECTION("DisableInterruptMode()")
+    {
+      // Exercise
+      test_can.DisableInterruptMode();
+
+      // Verify
+      CHECK(0 == local_can.IER);
+      local_can.GSR = bit::Set(0, Can::GlobalStatus::kReceiveBuffer);
+      CHECK(test_can.HasData());
+    }
+
+    test_can.DisableInterruptMode();
+  }
+
+  SECTION("BuildAcceptanceTable()")
+  {
+    // Setup
+    constexpr auto kCan1Filter = CanFilter<4>()
+                                     .Accept(0x120)
+                                     .Accept(0x100)
+                                     .AcceptRange(0x200, 0x2FF)
+                                     .AcceptExtended(0x1234'5678)
+                                     .AcceptExtendedRange(0x100, 0x1FF);
+    constexpr auto kCan2Filter = CanFilter<2>().Accept(0x050).Accept(0x7FF);
+
+    // Exercise
+    constexpr auto kTable =
+        Can::BuildAcceptanceTable(kCan1Filter, kCan2Filter);
+
+    // Verify
+    static_assert(kTable.valid);
+    // Standard IDs: CAN1 first, sorted by ID, two per word.
+    CHECK(0 == kTable.standard_start);
+    CHECK(0x0100'0120 == kTable.ram[0]);
+    CHECK(0x2050'27FF == kTable.ram[1]);
+    // Standard ranges: lower bound in the upper half.
+    CHECK(2 * 4 == kTable.standard_group_start);
+    CHECK(0x0200'02FF == kTable.ram[2]);
+    // Extended IDs
+    CHECK(3 * 4 == kTable.extended_start);
+    CHECK(0x1234'5678 == kTable.ram[3]);
+    // Extended ranges: lower bound, then upper bound.
+    CHECK(4 * 4 == kTable.extended_group_start);
+    CHECK(0x100 == kTable.ram[4]);
+    CHECK(0x1FF == kTable.ram[5]);
+    CHECK(6 * 4 == kTable.end);
+  }
+
+  SECTION("BuildAcceptanceTable() pads an odd number of standard IDs")
+  {
+    // Exercise
+    constexpr auto kTable =
+        Can::BuildAcceptanceTable(CanFilter<1>().Accept(0x123));
+
+    // Verify
+    CHECK(0x0123'F7FF == kTable.ram[0]);
+    CHECK(4 == kTable.standard_group_start);
+    CHECK(4 == kTable.end);
+  }
+
+  SECTION("ProgramAcceptanceFilter()")
+  {
+    // Setup
+    LPC_CANAF_RAM_TypeDef local_can_acceptance_ram;
+    testing::ClearStructure(&local_can_acceptance_ram);
+    Can::can_acceptance_filter_ram = &local_can_acceptance_ram;
+    local_can_acceptance.AFMR      = Value(Can::Commands::kAcceptAllMessages);
+
+    SECTION("Valid table")
+    {
+      constexpr auto kTable = Can::BuildAcceptanceTable(
+          CanFilter<2>().Accept(0x10).AcceptExtended(0x20));
+
+      // Exercise
+      Status status = Can::ProgramAcceptanceFilter(kTable);
+
+      // Verify
+      CHECK(Status::kSuccess == status);
+      CHECK(0x0010'F7FF == local_can_acceptance_ram.mask[0]);
+      CHECK(0x20 == local_can_acceptance_ram.mask[1]);
+      CHECK(0 == local_can_acceptance.SFF_sa);
+      CHECK(4 == local_can_acceptance.SFF_GRP_sa);
+      CHECK(4 == local_can_acceptance.EFF_sa);
+      CHECK(8 == local_can_acceptance.EFF_GRP_sa);
+      CHECK(8 == local_can_acceptance.ENDofTable);
+      // The filter is on and uses the table.
+      CHECK(0 == local_can_acceptance.AFMR);
+    }
+
+    SECTION("Invalid table")
+    {
+      auto table = Can::BuildAcceptanceTable(CanFilter<1>().Accept(0x800));
+
+      // Exercise & Verify
+      CHECK(Status::kInvalidParameters == Can::ProgramAcceptanceFilter(table));
+      CHECK(Value(Can::Commands::kAcceptAllMessages) ==
+            local_can_acceptance.AFMR);
+    }
+
+    Can::can_acceptance_filter_ram = LPC_CANAF_RAM;
+  }
+
   Can::can_acceptance_filter_register = LPC_CANAF;
 }
 }  // namespace sjsu::lpc40xx
@@ -1,5 +1,7 @@
 /// This is the eeprom.cpp test file
 
+#include <array>
+
 #include "L1_Peripheral/lpc40xx/eeprom.hpp"
 #include "L4_Testing/testing_frameworks.hpp"
 
@@ -122,6 +124,124 @@ TEST_CASE("Testing EEPROM")
     CHECK(local_eeprom.PWRDWN == 1);
   }
 
+  SECTION("Write ending on a page boundary programs once")
+  {
+    // Setup
+    std::array<uint32_t, 16> payload = {};
+    local_eeprom.INT_STATUS           = (1 << 26) | (1 << 28);
+
+    // Exercise
+    CHECK(test_eeprom.Write(0x40, payload.data(), sizeof(payload)));
+
+    // Verify
+    CHECK(test_eeprom.GetProgramCount() == 1);
+  }
+
+  SECTION("Write coalescing")
+  {
+    // Setup
+    Eeprom coalescing_eeprom(true);
+    uint32_t word           = 0xDEAD'BEEF;
+    local_eeprom.INT_STATUS = (1 << 26) | (1 << 28);
+
+    SECTION("Uncoalesced small writes program every time")
+    {
+      // Exercise
+      for (uint32_t address = 0; address < 64; address += 4)
+      {
+        CHECK(test_eeprom.Write(address, &word, sizeof(word)));
+      }
+
+      // Verify
+      CHECK(test_eeprom.GetProgramCount() == 16);
+    }
+
+    SECTION("Small writes to one page program once on Flush()")
+    {
+      // Exercise
+      for (uint32_t address = 0; address < 64; address += 4)
+      {
+        CHECK(coalescing_eeprom.Write(address, &word, sizeof(word)));
+      }
+
+      // Verify
+      CHECK(coalescing_eeprom.GetProgramCount() == 0);
+      CHECK(coalescing_eeprom.Flush());
+      CHECK(coalescing_eeprom.GetProgramCount() == 1);
+      CHECK(local_eeprom.CMD == Eeprom::kEraseProgram);
+      CHECK(local_eeprom.ADDR == 0);
+      // Verify: Flushing an empty buffer does not program anything
+      CHECK(coalescing_eeprom.Flush());
+      CHECK(coalescing_eeprom.GetProgramCount() == 1);
+    }
+
+    SECTION("Interleaved writes to several pages program each page once")
+    {
+      // Exercise
+      for (int i = 0; i < 10; i++)
+      {
+        CHECK(coalescing_eeprom.Write(0x000, &word, sizeof(word)));
+        CHECK(coalescing_eeprom.Write(0x284, &word, sizeof(word)));
+        CHECK(coalescing_eeprom.Write(0x7F8, &word, sizeof(word)));
+      }
+      // Exercise: Spans two pages, one of which is already dirty
+      std::array<uint32_t, 8> payload = {};
+      CHECK(coalescing_eeprom.Write(0x7F0, payload.data(), sizeof(payload)));
+      CHECK(coalescing_eeprom.Flush());
+
+      // Verify
+      CHECK(coalescing_eeprom.GetProgramCount() == 4);
+    }
+
+    SECTION("Least recently written page is evicted when buffer is full")
+    {
+      // Exercise
+      for (uint32_t page = 0; page < Eeprom::kCachedPages; page++)
+      {
+        CHECK(coalescing_eeprom.Write(page * 64, &word, sizeof(word)));
+      }
+      // Exercise: Touch page 0 so page 1 becomes the least recently written
+      CHECK(coalescing_eeprom.Write(0x04, &word, sizeof(word)));
+      CHECK(coalescing_eeprom.GetProgramCount() == 0);
+      CHECK(coalescing_eeprom.Write(0xF00, &word, sizeof(word)));
+
+      // Verify
+      CHECK(coalescing_eeprom.GetProgramCount() == 1);
+      CHECK(local_eeprom.CMD == Eeprom::kEraseProgram);
+      CHECK(local_eeprom.ADDR == 64);
+
+      CHECK(coalescing_eeprom.Flush());
+      CHECK(coalescing_eeprom.GetProgramCount() == 1 + Eeprom::kCachedPages);
+    }
+
+    SECTION("Reads return buffered words")
+    {
+      // Setup
+      local_eeprom.RDATA = 0x1234'5678;
+      std::array<uint32_t, 2> rdata;
+
+      // Exercise
+      CHECK(coalescing_eeprom.Write(0x100, &word, sizeof(word)));
+      CHECK(coalescing_eeprom.Read(0x100, rdata.data(), sizeof(rdata)));
+
+      // Verify
+      CHECK(rdata[0] == word);
+      CHECK(rdata[1] == 0x1234'5678);
+      CHECK(local_eeprom.ADDR == 0x104);
+    }
+
+    SECTION("Disable flushes the buffer")
+    {
+      // Exercise
+      CHECK(coalescing_eeprom.Write(0x100, &word, sizeof(word)));
+      CHECK(coalescing_eeprom.Disable());
+
+      // Verify
+      CHECK(coalescing_eeprom.GetProgramCount() == 1);
+      CHECK(local_eeprom.PWRDWN == 1);
+    }
+  }
+
   // Reset eeprom_register back to original value
   // in case future tests depend on it
   Eeprom::eeprom_register = LPC_EEPROM;
@@ -1,3 +1,4 @@
+#include <array>
 #include <cstdint>
 
 #include "L1_Peripheral/cortex/interrupt.hpp"
@@ -185,9 +186,9 @@ TEST_CASE("Testing lpc40xx Gpio External Interrupts")
 
     // Verify: Check Developer's ISR is attached
     auto * save_callback0 =
-        p0_15.handlers[kPort0][kPin15].target<void (*)(void)>();
+        p0_15.handlers[kPort0][kPin15].Target<void (*)(void)>();
     auto * save_callback1 =
-        p2_7.handlers[kPort2][kPin7].target<void (*)(void)>();
+        p2_7.handlers[kPort2][kPin7].Target<void (*)(void)>();
     REQUIRE(save_callback0 != nullptr);
     REQUIRE(save_callback1 != nullptr);
     CHECK(&InterruptCallback0 == *save_callback0);
@@ -223,5 +224,63 @@ TEST_CASE("Testing lpc40xx Gpio External Interrupts")
     CHECK(bit::Read(local_eint.IO0IntClr, kPin15));
     CHECK(was_called);
   }
+
+  SECTION("Service every pending pin in a single call")
+  {
+    // Setup
+    constexpr uint8_t kPin3 = 3;
+    Gpio p0_3(0, kPin3, &mock_pin.get());
+
+    std::array<int, 3> calls = { 0 };
+    p0_15.AttachInterrupt([&calls]() { calls[0]++; },
+                          sjsu::Gpio::Edge::kBoth);
+    p0_3.AttachInterrupt([&calls]() { calls[1]++; },
+                         sjsu::Gpio::Edge::kFalling);
+    p2_7.AttachInterrupt([&calls]() { calls[2]++; },
+                         sjsu::Gpio::Edge::kRising);
+
+    // Setup: Manually trigger interrupts on both ports at once
+    *Gpio::InterruptStatus() = (1 << 0) | (1 << 2);
+    local_eint.IO0IntStatR   = (1 << kPin15);
+    local_eint.IO0IntStatF   = (1 << kPin3);
+    local_eint.IO2IntStatR   = (1 << kPin7);
+
+    // Execute
+    Gpio::InterruptHandler();
+
+    // Verify
+    CHECK(1 == calls[0]);
+    CHECK(1 == calls[1]);
+    CHECK(1 == calls[2]);
+    CHECK(((1 << kPin15) | (1 << kPin3)) == local_eint.IO0IntClr);
+    CHECK((1 << kPin7) == local_eint.IO2IntClr);
+
+    // Cleanup
+    p0_15.DetachInterrupt();
+    p0_3.DetachInterrupt();
+    p2_7.DetachInterrupt();
+    *Gpio::InterruptStatus() = 0;
+  }
+
+  SECTION("Ports without a pending interrupt are not serviced")
+  {
+    // Setup
+    int calls = 0;
+    p2_7.AttachInterrupt([&calls]() { calls++; }, sjsu::Gpio::Edge::kRising);
+
+    *Gpio::InterruptStatus() = (1 << 0);
+    local_eint.IO2IntStatR   = (1 << kPin7);
+
+    // Execute
+    Gpio::InterruptHandler();
+
+    // Verify
+    CHECK(0 == calls);
+    CHECK(0 == local_eint.IO2IntClr);
+
+    // Cleanup
+    p2_7.DetachInterrupt();
+    *Gpio::InterruptStatus() = 0;
+  }
 }
 }  // namespace sjsu::lpc40xx
@@ -468,6 +468,164 @@ TEST_CASE("Testing lpc40xx I2C")
     CHECK_BITS(I2c::Control::kInterrupt, local_i2c.CONCLR);
   }
 
+  SECTION("TransactionAsync()")
+  {
+    static Status completed_status;
+    static int completed_count;
+    completed_status = Status::kNotImplemented;
+    completed_count  = 0;
+    auto on_complete = [](Status status) {
+      completed_status = status;
+      completed_count++;
+    };
+
+    auto step = [&](I2c::MasterState state, uint8_t data = 0) {
+      setup_state_machine(state);
+      local_i2c.DAT = data;
+      test_subject.I2cHandler(kMockI2c);
+    };
+
+    SECTION("Write then read")
+    {
+      // Setup
+      const uint8_t kRegister[]  = { 0x75 };
+      uint8_t read_buffer[2]     = { 0 };
+      I2c::Transaction_t request = {
+        .operation  = I2c::Operation::kWrite,
+        .address    = kAddress,
+        .data_out   = kRegister,
+        .out_length = sizeof(kRegister),
+        .data_in    = read_buffer,
+        .in_length  = sizeof(read_buffer),
+        .repeated   = true,
+      };
+      local_i2c.CONSET = 0;
+
+      // Exercise
+      REQUIRE(test_subject.TransactionAsync(request, on_complete));
+
+      // Verify: the transaction has started, but not completed
+      CHECK(local_i2c.CONSET == I2c::Control::kStart);
+      CHECK(test_subject.GetTransactionInfo().busy);
+      CHECK(!test_subject.TransactionAsync(request, on_complete));
+
+      // Exercise
+      step(I2c::MasterState::kStartCondition);
+      CHECK((kAddress << 1) == local_i2c.DAT);
+      step(I2c::MasterState::kSlaveAddressWriteSentReceivedAck);
+      CHECK(kRegister[0] == local_i2c.DAT);
+      step(I2c::MasterState::kTransmittedDataReceivedAck);
+      CHECK_BITS(I2c::Control::kStart, local_i2c.CONSET);
+      step(I2c::MasterState::kRepeatedStart);
+      CHECK(((kAddress << 1) | 1) == local_i2c.DAT);
+      step(I2c::MasterState::kSlaveAddressReadSentReceivedAck);
+      step(I2c::MasterState::kReceivedDataReceivedAck, 0xAB);
+
+      // Verify: the last byte has not been received yet
+      CHECK(0 == completed_count);
+
+      // Exercise
+      step(I2c::MasterState::kReceivedDataReceivedNack, 0xCD);
+
+      // Verify
+      CHECK(1 == completed_count);
+      CHECK(Status::kSuccess == completed_status);
+      CHECK(0xAB == read_buffer[0]);
+      CHECK(0xCD == read_buffer[1]);
+      CHECK_BITS(I2c::Control::kStop, local_i2c.CONSET);
+      CHECK(test_subject.TransactionAsync(request, on_complete));
+    }
+
+    SECTION("Device not found")
+    {
+      // Setup
+      const uint8_t kPayload[] = { 0x01, 0x02 };
+      REQUIRE(test_subject.TransactionAsync(
+          { .address    = kAddress,
+            .data_out   = kPayload,
+            .out_length = sizeof(kPayload) },
+          on_complete));
+
+      // Exercise
+      step(I2c::MasterState::kStartCondition);
+      step(I2c::MasterState::kSlaveAddressWriteSentReceivedNack);
+
+      // Verify
+      CHECK(1 == completed_count);
+      CHECK(Status::kDeviceNotFound == completed_status);
+      CHECK(!test_subject.GetTransactionInfo().busy);
+    }
+
+    SECTION("Bus error")
+    {
+      // Setup
+      REQUIRE(test_subject.TransactionAsync({ .address = kAddress },
+                                            on_complete));
+
+      // Exercise
+      step(I2c::MasterState::kBusError);
+
+      // Verify
+      CHECK(1 == completed_count);
+      CHECK(Status::kBusError == completed_status);
+    }
+
+    SECTION("Synchronous transactions do not call the handler")
+    {
+      // Exercise
+      test_subject.Write(kAddress, nullptr, 0);
+      step(I2c::MasterState::kStartCondition);
+      step(I2c::MasterState::kSlaveAddressWriteSentReceivedAck);
+
+      // Verify
+      CHECK(0 == completed_count);
+    }
+
+    SECTION("Synchronous transactions fail while one is in progress")
+    {
+      // Setup
+      REQUIRE(test_subject.TransactionAsync({ .address = kAddress },
+                                            on_complete));
+
+      // Exercise
+      auto result = test_subject.Write(kAddress, nullptr, 0);
+
+      // Verify
+      REQUIRE(!result);
+      CHECK(Status::kNotReadyYet == result.error()->status);
+      CHECK(test_subject.GetTransactionInfo().on_complete);
+    }
+
+    SECTION("CancelTransactionAsync()")
+    {
+      // Setup: the device holds the bus after the address is sent
+      REQUIRE(test_subject.TransactionAsync({ .address = kAddress },
+                                            on_complete));
+      step(I2c::MasterState::kStartCondition);
+      local_i2c.CONSET = 0;
+      local_i2c.CONCLR = 0;
+
+      // Exercise
+      CHECK(test_subject.CancelTransactionAsync());
+
+      // Verify
+      CHECK(1 == completed_count);
+      CHECK(Status::kTimedOut == completed_status);
+      CHECK(!test_subject.GetTransactionInfo().busy);
+      CHECK_BITS(I2c::Control::kStop, local_i2c.CONSET);
+      CHECK_BITS(I2c::Control::kInterrupt, local_i2c.CONCLR);
+      Verify(Method(mock_interrupt_controller, Disable)
+                 .Using(kMockI2c.irq_number))
+          .Once();
+
+      // Exercise: nothing is left to cancel, and the bus can be used again
+      CHECK(!test_subject.CancelTransactionAsync());
+      CHECK(1 == completed_count);
+      CHECK(test_subject.TransactionAsync({ .address = kAddress },
+                                          on_complete));
+    }
+  }
+
   sjsu::lpc40xx::SystemController::system_controller = LPC_SC;
 }
 }  // namespace sjsu::lpc40xx
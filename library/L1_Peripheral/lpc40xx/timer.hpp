@@ -99,12 +99,13 @@ class Timer final : public sjsu::Timer
     uint32_t prescaler        = peripheral_frequency / frequency;
     timer_.peripheral->PR     = prescaler;
 
-    // Take the class's address and a copy of the callback for use in the
-    // interrupt handler.
-    auto interrupt_handler = [this, callback]() {
-      if (callback != nullptr)
+    // Keep the callback in this object, so the interrupt handler only needs
+    // to capture the class's address.
+    callback_              = callback;
+    auto interrupt_handler = [this]() {
+      if (callback_ != nullptr)
       {
-        callback();
+        callback_();
       }
       // Clear interrupts for all 4 match register interrupt flag
       timer_.peripheral->IR |= 0b1111;
@@ -174,6 +175,8 @@ class Timer final : public sjsu::Timer
 
  private:
   const Peripheral_t & timer_;
+  /// Callback called by the interrupt handler installed by Initialize().
+  mutable InterruptCallback callback_ = nullptr;
 };
 }  // namespace lpc40xx
 }  // namespace sjsu
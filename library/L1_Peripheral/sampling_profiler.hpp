@@ -0,0 +1,50 @@
+#pragma once
+
+#include "config.hpp"
+#include "utility/sample_table.hpp"
+#include "utility/status.hpp"
+#include "utility/units.hpp"
+
+namespace sjsu
+{
+/// A statistical profiler that periodically samples the address of the code
+/// that is running and counts how often each address is seen. Addresses that
+/// are sampled the most are where the program spends the most time.
+///
+/// Stop() the profiler before reading or clearing its samples.
+/// @ingroup l1_peripheral
+class SamplingProfiler
+{
+ public:
+  /// Table that samples are counted in.
+  using Samples_t = SampleTable<config::kSamplingProfilerSize>;
+
+  // ===========================================================================
+  // Interface Methods
+  // ===========================================================================
+
+  /// Start sampling.
+  ///
+  /// @param sample_rate - number of samples to take per second.
+  /// @return Status::kInvalidParameters if the sample rate is not supported,
+  ///         otherwise the status of starting the sampling hardware.
+  virtual Status Start(units::frequency::hertz_t sample_rate) = 0;
+
+  /// Stop sampling. Samples taken so far are kept.
+  virtual void Stop() = 0;
+
+  // ===========================================================================
+  // Helper Methods
+  // ===========================================================================
+
+  /// @return the samples taken so far.
+  Samples_t & GetSamples()
+  {
+    return samples_;
+  }
+
+ protected:
+  /// Samples taken by the implementation.
+  Samples_t samples_;
+};
+}  // namespace sjsu
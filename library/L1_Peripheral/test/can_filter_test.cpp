@@ -0,0 +1,122 @@
+#include "L1_Peripheral/can_filter.hpp"
+#include "L4_Testing/testing_frameworks.hpp"
+
+namespace sjsu
+{
+namespace
+{
+constexpr Can::Message_t CanMessage(uint32_t id,
+                                    Can::Message_t::Format format =
+                                        Can::Message_t::Format::kStandard)
+{
+  Can::Message_t message = {};
+  message.id             = id;
+  message.format         = format;
+  return message;
+}
+
+constexpr Can::Message_t ExtendedMessage(uint32_t id)
+{
+  return CanMessage(id, Can::Message_t::Format::kExtended);
+}
+}  // namespace
+
+TEST_CASE("Testing CanFilter")
+{
+  SECTION("Built at compile time")
+  {
+    // Setup
+    constexpr auto kFilter = CanFilter<2>()
+                                 .Accept(0x100)
+                                 .AcceptRange(0x200, 0x20F)
+                                 .AcceptExtended(0x1800'0000);
+
+    // Verify
+    static_assert(kFilter.IsValid());
+    static_assert(kFilter.IsAccepted(CanMessage(0x100)));
+    static_assert(!kFilter.IsAccepted(CanMessage(0x101)));
+    CHECK(kFilter.IsAccepted(CanMessage(0x200)));
+    CHECK(kFilter.IsAccepted(CanMessage(0x20F)));
+    CHECK(!kFilter.IsAccepted(CanMessage(0x210)));
+    CHECK(kFilter.IsAccepted(ExtendedMessage(0x1800'0000)));
+  }
+
+  SECTION("Standard and extended IDs are filtered separately")
+  {
+    // Setup
+    CanFilter<2> filter;
+    filter.Accept(0x100).AcceptExtended(0x200);
+
+    // Exercise & Verify
+    CHECK(filter.IsAccepted(CanMessage(0x100)));
+    CHECK(!filter.IsAccepted(ExtendedMessage(0x100)));
+    CHECK(filter.IsAccepted(ExtendedMessage(0x200)));
+    CHECK(!filter.IsAccepted(CanMessage(0x200)));
+  }
+
+  SECTION("Extended ranges")
+  {
+    // Setup
+    CanFilter<4> filter;
+    filter.AcceptExtendedRange(0x3000, 0x3FFF)
+        .AcceptExtendedRange(0x1000, 0x8000)
+        .AcceptExtended(0x9000)
+        .AcceptExtendedRange(0x2000, 0x2000);
+
+    // Exercise & Verify
+    CHECK(!filter.IsAccepted(ExtendedMessage(0x0FFF)));
+    CHECK(filter.IsAccepted(ExtendedMessage(0x1000)));
+    // Only held by the wider range, which starts before the later ones
+    CHECK(filter.IsAccepted(ExtendedMessage(0x5000)));
+    CHECK(filter.IsAccepted(ExtendedMessage(0x8000)));
+    CHECK(!filter.IsAccepted(ExtendedMessage(0x8001)));
+    CHECK(filter.IsAccepted(ExtendedMessage(0x9000)));
+    CHECK(!filter.IsAccepted(ExtendedMessage(0x9001)));
+  }
+
+  SECTION("Entries are sorted and unique")
+  {
+    // Setup
+    CanFilter<4> filter;
+    filter.Accept(0x300).Accept(0x100).AcceptRange(0x100, 0x1FF).Accept(0x300);
+
+    // Exercise
+    auto standard = filter.GetStandard();
+
+    // Verify
+    REQUIRE(3 == standard.size());
+    CHECK(0x100 == standard[0].low);
+    CHECK(0x100 == standard[0].high);
+    CHECK(0x100 == standard[1].low);
+    CHECK(0x1FF == standard[1].high);
+    CHECK(0x300 == standard[2].low);
+    CHECK(0 == filter.GetExtended().size());
+  }
+
+  SECTION("Invalid entries")
+  {
+    // Setup
+    CanFilter<1> filter;
+
+    SECTION("Standard ID out of range")
+    {
+      filter.Accept(0x800);
+    }
+    SECTION("Extended ID out of range")
+    {
+      filter.AcceptExtended(0x2000'0000);
+    }
+    SECTION("Low bound above high bound")
+    {
+      filter.AcceptRange(0x20, 0x10);
+    }
+    SECTION("Too many entries")
+    {
+      filter.Accept(0x10).Accept(0x11);
+    }
+
+    // Verify
+    CHECK(!filter.IsValid());
+  }
+}
+}  // namespace sjsu
@@ -6,5 +6,23 @@ namespace sjsu
 TEST_CASE("Testing L1 i2c")
 {
   Mock<I2c> i2c;
+
+  SECTION("Default TransactionAsync() completes before returning")
+  {
+    // Setup
+    static Status completed_status;
+    completed_status = Status::kNotImplemented;
+    When(Method(i2c, Transaction))
+        .Return(Returns<void>{})
+        .Return(Error(Status::kDeviceNotFound, ""));
+    auto on_complete = [](Status status) { completed_status = status; };
+
+    // Exercise & Verify
+    CHECK(i2c.get().I2c::TransactionAsync({ .address = 0x10 }, on_complete));
+    CHECK(Status::kSuccess == completed_status);
+    CHECK(i2c.get().I2c::TransactionAsync({ .address = 0x10 }, on_complete));
+    CHECK(Status::kDeviceNotFound == completed_status);
+    Verify(Method(i2c, Transaction)).Twice();
+  }
 }
 }  // namespace sjsu
@@ -8,6 +8,7 @@
 // Interface Test
 // =============================================================================
 #include "L1_Peripheral/test/adc_test.cpp"                // NOLINT
+#include "L1_Peripheral/test/can_filter_test.cpp"         // NOLINT
 #include "L1_Peripheral/test/gpio_test.cpp"               // NOLINT
 #include "L1_Peripheral/test/hardware_counter_test.cpp"   // NOLINT
 #include "L1_Peripheral/test/i2c_test.cpp"                // NOLINT
@@ -42,7 +43,7 @@
 // lpc40xx implemenation test
 // =============================================================================
 #include "L1_Peripheral/lpc40xx/test/adc_test.cpp"                // NOLINT
-// #include "L1_Peripheral/lpc40xx/test/can_test.cpp"                // NOLINT
+#include "L1_Peripheral/lpc40xx/test/can_test.cpp"                // NOLINT
 #include "L1_Peripheral/lpc40xx/test/dac_test.cpp"                // NOLINT
 #include "L1_Peripheral/lpc40xx/test/eeprom_test.cpp"             // NOLINT
 #include "L1_Peripheral/lpc40xx/test/gpio_test.cpp"               // NOLINT
@@ -70,6 +71,12 @@
 // =============================================================================
 // cortex implemenation test
 // =============================================================================
-#include "L1_Peripheral/cortex/test/dwt_counter_test.cpp"   // NOLINT
-#include "L1_Peripheral/cortex/test/system_timer_test.cpp"  // NOLINT
-#include "L1_Peripheral/cortex/test/interrupt_test.cpp"     // NOLINT
+#include "L1_Peripheral/cortex/test/dwt_counter_test.cpp"        // NOLINT
+#include "L1_Peripheral/cortex/test/system_timer_test.cpp"       // NOLINT
+#include "L1_Peripheral/cortex/test/interrupt_test.cpp"          // NOLINT
+#include "L1_Peripheral/cortex/test/sampling_profiler_test.cpp"  // NOLINT
+
+// =============================================================================
+// linux implemenation test
+// =============================================================================
+#include "L1_Peripheral/linux/test/sampling_profiler_test.cpp"  // NOLINT
@@ -0,0 +1,440 @@
+// Usage:
+//
+//    sjsu::lpc40xx::Can can1(sjsu::lpc40xx::Can::Channel::kCan1);
+//    sjsu::CanBusMonitor can_monitor("can1", can1, 500'000_Hz);
+//
+//    // Use can_monitor everywhere can1 would be used.
+//    can_monitor.Initialize();
+//    can_monitor.Send(0x100, { 0xAA, 0xBB });
+//
+//    can_monitor.Print();
+//
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include "L1_Peripheral/can.hpp"
+#include "utility/time.hpp"
+#include "utility/units.hpp"
+
+namespace sjsu
+{
+/// Calculate the number of bits a frame takes up on the bus, including its
+/// stuff bits and the 3 bit intermission that follows it.
+///
+/// The stuff bits depend on the frame's CRC, so the frame is encoded bit by
+/// bit, exactly as the controller would transmit it.
+///
+/// @param message - message to calculate the length of.
+/// @return the length of the frame in bits.
+constexpr uint32_t CanFrameBitLength(const Can::Message_t & message)
+{
+  uint32_t bits     = 0;
+  uint32_t run      = 0;
+  bool last_bit     = true;
+  uint32_t crc      = 0;
+  bool crc_complete = false;
+
+  auto send = [&](uint32_t value, uint32_t width) {
+    for (uint32_t i = width; i > 0; i--)
+    {
+      bool bit = (value >> (i - 1)) & 1;
+      if (!crc_complete)
+      {
+        bool feedback = bit ^ ((crc >> 14) & 1);
+        crc           = (crc << 1) & 0x7FFF;
+        if (feedback)
+        {
+          crc ^= 0x4599;
+        }
+      }
+
+      bits++;
+      run      = (bit == last_bit) ? run + 1 : 1;
+      last_bit = bit;
+      if (run == 5)
+      {
+        // A stuff bit of the opposite value starts the next run.
+        bits++;
+        last_bit = !bit;
+        run      = 1;
+      }
+    }
+  };
+
+  const uint32_t kRemote = message.is_remote_request;
+  const uint32_t kLength = message.length;
+
+  // Start of frame, which can never be stuffed, so a run of 0s starts here.
+  send(0, 1);
+  if (message.format == Can::Message_t::Format::kExtended)
+  {
+    send(message.id >> 18, 11);
+    // SRR and IDE bits
+    send(0b11, 2);
+    send(message.id & 0x3'FFFF, 18);
+    send(kRemote, 1);
+    // r1 and r0 bits
+    send(0b00, 2);
+  }
+  else
+  {
+    send(message.id, 11);
+    send(kRemote, 1);
+    // IDE and r0 bits
+    send(0b00, 2);
+  }
+  send(kLength, 4);
+  if (!message.is_remote_request)
+  {
+    for (uint32_t i = 0; i < std::min<uint32_t>(kLength, 8); i++)
+    {
+      send(message.payload[i], 8);
+    }
+  }
+
+  crc_complete = true;
+  send(crc, 15);
+
+  // CRC delimiter, acknowledge slot and delimiter, end of frame and
+  // intermission are never stuffed.
+  return bits + 1 + 2 + 7 + 3;
+}
+
+/// Measures the load on a CAN bus and its error rate over a sliding window,
+/// to find out when a bus is saturated or unhealthy.
+///
+/// CanBusMonitor wraps a Can peripheral and is used in its place. Every
+/// message sent or received through it is counted along with its length on
+/// the wire, including stuff bits, which gives the bus utilization. The
+/// controller's error counters, bus errors and arbitration losses are read
+/// with Can::GetErrorStatistics().
+///
+/// The window is split into kBucketCount buckets. Buckets older than the
+/// window are discarded as time passes, so the statistics always cover the
+/// most recent window. Bus errors and arbitration losses are counted in the
+/// bucket that is current when they are read from the controller, which
+/// happens whenever a new bucket starts, so call Update() periodically if the
+/// bus may go quiet.
+///
+/// Frames that the acceptance filter rejects are never received, so for an
+/// accurate utilization the filter must accept every message.
+///
+/// Not thread safe. Send(), Receive() and every other method must be called
+/// from the same task.
+class CanBusMonitor final : public Can
+{
+ public:
+  /// Number of buckets the window is split into.
+  static constexpr size_t kBucketCount = 10;
+
+  /// Statistics of the bus over the window.
+  struct Window_t
+  {
+    /// Length of time that the window covers. Shorter than the window until
+    /// the monitor has been running for a whole window.
+    std::chrono::nanoseconds duration = 0ns;
+    /// Number of messages received.
+    uint32_t frames_received = 0;
+    /// Number of messages sent.
+    uint32_t frames_sent = 0;
+    /// Number of bits on the bus taken up by the frames.
+    uint64_t bits = 0;
+    /// Fraction of the bus' bandwidth that was used, from 0 to 1.
+    float utilization = 0;
+    /// Highest utilization of any single bucket. Shows bursts that are
+    /// averaged away by the rest of the window.
+    float peak_utilization = 0;
+    /// Controller error counters and bus off status, as last read.
+    ErrorStatistics_t errors = {};
+  };
+
+  /// @param name - name used to identify this monitor when it is printed.
+  /// @param can - CAN peripheral to monitor. Its acceptance filter should
+  ///        accept every message.
+  /// @param bit_rate - bit rate of the bus. Updated by SetBaudRate().
+  /// @param bucket_period - length of each bucket. The window is kBucketCount
+  ///        times as long.
+  CanBusMonitor(const char * name,
+                const Can & can,
+                units::frequency::hertz_t bit_rate = kStandardBaudRate,
+                std::chrono::nanoseconds bucket_period = 100ms)
+      : name_(name),
+        can_(can),
+        bit_rate_(bit_rate),
+        bucket_period_(bucket_period)
+  {
+  }
+
+  using Can::Send;
+
+  Status Initialize() const override
+  {
+    return can_.Initialize();
+  }
+
+  void Enable() const override
+  {
+    can_.Enable();
+  }
+
+  /// Send a message and count it.
+  void Send(const Message_t & message) const override
+  {
+    can_.Send(message);
+    Record(message).frames_sent++;
+  }
+
+  /// Receive a message and count it.
+  Message_t Receive() const override
+  {
+    Message_t message = can_.Receive();
+    Record(message).frames_received++;
+    return message;
+  }
+
+  bool HasData() const override
+  {
+    return can_.HasData();
+  }
+
+  bool SelfTest(uint32_t id) const override
+  {
+    return can_.SelfTest(id);
+  }
+
+  bool IsBusOff() const override
+  {
+    return can_.IsBusOff();
+  }
+
+  void SetBaudRate(units::frequency::hertz_t baud) const override
+  {
+    bit_rate_ = baud;
+    can_.SetBaudRate(baud);
+  }
+
+  ErrorStatistics_t GetErrorStatistics() const override
+  {
+    return can_.GetErrorStatistics();
+  }
+
+  /// Discard buckets older than the window and count the errors reported by
+  /// the controller since the last update.
+  void Update() const
+  {
+    Advance(Uptime());
+    SampleErrors();
+  }
+
+  /// @return statistics of the bus over the window, up to now.
+  Window_t GetWindow() const
+  {
+    const std::chrono::nanoseconds kNow = Uptime();
+    Advance(kNow);
+    SampleErrors();
+
+    Window_t window = { .errors = last_errors_ };
+    window.errors.bus_errors       = {};
+    window.errors.arbitration_lost = {};
+
+    const uint64_t kBucketBits = BitsPerBucket();
+    for (const Bucket_t & bucket : buckets_)
+    {
+      window.frames_received += bucket.frames_received;
+      window.frames_sent += bucket.frames_sent;
+      window.bits += bucket.bits;
+      for (size_t i = 0; i < bucket.bus_errors.size(); i++)
+      {
+        window.errors.bus_errors[i] += bucket.bus_errors[i];
+      }
+      for (size_t i = 0; i < bucket.arbitration_lost.size(); i++)
+      {
+        window.errors.arbitration_lost[i] += bucket.arbitration_lost[i];
+      }
+      if (&bucket != &buckets_[epoch_ % kBucketCount] && kBucketBits != 0)
+      {
+        window.peak_utilization =
+            std::max(window.peak_utilization,
+                     static_cast<float>(bucket.bits) /
+                         static_cast<float>(kBucketBits));
+      }
+    }
+
+    // The current bucket has only been running for part of its period.
+    const std::chrono::nanoseconds kWindowLength =
+        (kBucketCount - 1) * bucket_period_ +
+        (kNow - static_cast<int64_t>(epoch_) * bucket_period_);
+    window.duration = std::min(kNow - start_, kWindowLength);
+
+    const double kAvailableBits =
+        bit_rate_.to<double>() *
+        std::chrono::duration<double>(window.duration).count();
+    if (kAvailableBits > 0)
+    {
+      window.utilization = static_cast<float>(
+          static_cast<double>(window.bits) / kAvailableBits);
+    }
+    return window;
+  }
+
+  /// Discard every statistic and start a new window.
+  void Reset() const
+  {
+    buckets_ = {};
+    started_ = false;
+    Advance(Uptime());
+  }
+
+  /// @return the name of the monitor.
+  const char * GetName() const
+  {
+    return name_;
+  }
+
+  /// Print the statistics of the window.
+  void Print() const
+  {
+    static constexpr std::array<const char *, kBusErrorTypes> kErrorNames = {
+      "bit", "form", "stuff", "other"
+    };
+
+    Window_t window = GetWindow();
+    const char * state = "error active";
+    if (window.errors.bus_off)
+    {
+      state = "bus off";
+    }
+    else if (window.errors.transmit_error_count > 127 ||
+             window.errors.receive_error_count > 127)
+    {
+      state = "error passive";
+    }
+
+    printf("%s: %" PRIu32 " bit/s over the last %" PRIu32 "ms\n", name_,
+           bit_rate_.to<uint32_t>(),
+           static_cast<uint32_t>(
+               std::chrono::duration_cast<std::chrono::milliseconds>(
+                   window.duration)
+                   .count()));
+    printf("  utilization  %5.1f%% (peak %5.1f%%)\n",
+           static_cast<double>(window.utilization) * 100.0,
+           static_cast<double>(window.peak_utilization) * 100.0);
+    printf("  frames       received %" PRIu32 ", sent %" PRIu32 "\n",
+           window.frames_received, window.frames_sent);
+    printf("  error count  transmit %u, receive %u (%s)\n",
+           window.errors.transmit_error_count,
+           window.errors.receive_error_count, state);
+    printf("  bus errors  ");
+    for (size_t i = 0; i < kErrorNames.size(); i++)
+    {
+      printf(" %s %" PRIu32, kErrorNames[i], window.errors.bus_errors[i]);
+    }
+    printf("\n  arbitration lost at bit:");
+    bool any_lost = false;
+    for (size_t i = 0; i < window.errors.arbitration_lost.size(); i++)
+    {
+      if (window.errors.arbitration_lost[i] != 0)
+      {
+        printf(" %zu (%" PRIu32 ")", i, window.errors.arbitration_lost[i]);
+        any_lost = true;
+      }
+    }
+    printf("%s\n", any_lost ? "" : " none");
+  }
+
+ private:
+  static constexpr size_t kBusErrorTypes =
+      static_cast<size_t>(BusError::kNumberOfErrors);
+
+  /// Statistics of a single bucket of the window.
+  struct Bucket_t
+  {
+    uint32_t frames_received = 0;
+    uint32_t frames_sent     = 0;
+    uint32_t bits            = 0;
+    std::array<uint32_t, kBusErrorTypes> bus_errors           = {};
+    std::array<uint32_t, kArbitrationBits> arbitration_lost = {};
+  };
+
+  /// Count the bits of a frame in the current bucket.
+  ///
+  /// @return the current bucket.
+  Bucket_t & Record(const Message_t & message) const
+  {
+    Advance(Uptime());
+    Bucket_t & bucket = buckets_[epoch_ % kBucketCount];
+    bucket.bits += CanFrameBitLength(message);
+    return bucket;
+  }
+
+  /// Move the current bucket forward to the bucket that now falls in,
+  /// clearing the buckets in between.
+  void Advance(std::chrono::nanoseconds now) const
+  {
+    const uint64_t kEpoch = static_cast<uint64_t>(now / bucket_period_);
+    if (!started_)
+    {
+      started_     = true;
+      start_       = now;
+      epoch_       = kEpoch;
+      last_errors_ = can_.GetErrorStatistics();
+      return;
+    }
+    if (kEpoch == epoch_)
+    {
+      return;
+    }
+
+    const uint64_t kSteps = std::min<uint64_t>(kEpoch - epoch_, kBucketCount);
+    for (uint64_t step = 1; step <= kSteps; step++)
+    {
+      buckets_[(epoch_ + step) % kBucketCount] = {};
+    }
+    epoch_ = kEpoch;
+    SampleErrors();
+  }
+
+  /// Count the bus errors and arbitration losses reported by the controller
+  /// since the last sample in the current bucket.
+  void SampleErrors() const
+  {
+    ErrorStatistics_t errors = can_.GetErrorStatistics();
+    Bucket_t & bucket        = buckets_[epoch_ % kBucketCount];
+    for (size_t i = 0; i < errors.bus_errors.size(); i++)
+    {
+      bucket.bus_errors[i] += errors.bus_errors[i] - last_errors_.bus_errors[i];
+    }
+    for (size_t i = 0; i < errors.arbitration_lost.size(); i++)
+    {
+      bucket.arbitration_lost[i] +=
+          errors.arbitration_lost[i] - last_errors_.arbitration_lost[i];
+    }
+    last_errors_ = errors;
+  }
+
+  /// @return the number of bits the bus can carry in a bucket.
+  uint64_t BitsPerBucket() const
+  {
+    return static_cast<uint64_t>(
+        bit_rate_.to<double>() *
+        std::chrono::duration<double>(bucket_period_).count());
+  }
+
+  const char * name_;
+  const Can & can_;
+  mutable units::frequency::hertz_t bit_rate_;
+  const std::chrono::nanoseconds bucket_period_;
+  mutable std::array<Bucket_t, kBucketCount> buckets_ = {};
+  mutable ErrorStatistics_t last_errors_              = {};
+  mutable std::chrono::nanoseconds start_             = 0ns;
+  mutable uint64_t epoch_                             = 0;
+  mutable bool started_                               = false;
+};
+}  // namespace sjsu
@@ -0,0 +1,655 @@
+// Usage:
+//
+//    sjsu::IsoTp<2> iso_tp(can);
+//    size_t channel = iso_tp.Open({ .transmit_id = 0x7E8,
+//                                   .receive_id  = 0x7E0,
+//                                   .block_size  = 8 }).value();
+//
+//    std::array<uint8_t, 4095> request;
+//    iso_tp.Receive(channel, request);
+//    while (iso_tp.GetReceiveStatus(channel) == sjsu::Status::kNotReadyYet)
+//    {
+//      iso_tp.Service();
+//    }
+//    size_t length = iso_tp.GetReceivedLength(channel);
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "L1_Peripheral/can.hpp"
+#include "utility/enum.hpp"
+#include "utility/status.hpp"
+#include "utility/time.hpp"
+
+namespace sjsu
+{
+/// ISO-TP (ISO 15765-2) transport protocol, which moves messages of up to 4GB
+/// over classic CAN by splitting them into a first frame, followed by
+/// consecutive frames that the receiver paces with flow control frames.
+///
+/// Each channel is a pair of CAN IDs, one to transmit and one to receive on,
+/// and can send and receive a message at the same time as every other
+/// channel. Messages are never copied: Send() transmits straight from the
+/// caller's data and Receive() reassembles straight into the caller's buffer,
+/// so both must stay valid until the transfer finishes.
+///
+/// IsoTp never blocks. Received frames are passed to Handle(), either by
+/// Service(), which also receives them from the Can peripheral, or by a
+/// CanRouter route for the channel's receive ID. Process(), which Service()
+/// also calls, sends consecutive frames as fast as the receiver's flow
+/// control allows and times out stalled transfers, so call one of them
+/// frequently while transfers are in progress.
+///
+/// Only normal addressing on classic CAN, where the whole 8 byte payload
+/// carries the protocol, is supported.
+///
+/// @tparam kMaxChannels - maximum number of channels.
+template <size_t kMaxChannels>
+class IsoTp
+{
+ public:
+  /// Type of an ISO-TP frame, stored in the upper nibble of its first byte.
+  enum class FrameType : uint8_t
+  {
+    kSingle      = 0,
+    kFirst       = 1,
+    kConsecutive = 2,
+    kFlowControl = 3,
+  };
+
+  /// Flow status of a flow control frame.
+  enum class FlowStatus : uint8_t
+  {
+    kContinueToSend = 0,
+    kWait           = 1,
+    kOverflow       = 2,
+  };
+
+  /// Most data bytes that fit in a single frame.
+  static constexpr size_t kSingleFrameCapacity = 7;
+  /// Longest message whose length fits in the 12-bit first frame length.
+  /// Longer messages use the 32-bit escape sequence.
+  static constexpr size_t kMaxShortLength = 4095;
+  /// Largest separation time that can be requested from the sender.
+  static constexpr std::chrono::microseconds kMaxSeparationTime = 127ms;
+  /// Byte used to pad frames out to 8 bytes.
+  static constexpr uint8_t kPaddingByte = 0xCC;
+
+  /// Settings of a single channel.
+  struct Channel_t
+  {
+    /// ID that this channel's frames are sent with.
+    uint32_t transmit_id;
+    /// ID of the frames sent to this channel.
+    uint32_t receive_id;
+    /// ID format of both IDs.
+    Can::Message_t::Format format = Can::Message_t::Format::kStandard;
+    /// Number of consecutive frames the sender may send before waiting for
+    /// another flow control frame. 0 lets it send the whole message at once.
+    uint8_t block_size = 0;
+    /// Minimum time the sender must wait between consecutive frames. Rounded
+    /// up to 100us below 1ms and to 1ms above it.
+    std::chrono::microseconds separation_time = 0us;
+    /// Longest time to wait for the next flow control or consecutive frame
+    /// before the transfer fails, the N_Bs and N_Cr timeouts of the standard.
+    std::chrono::milliseconds timeout = 1000ms;
+    /// Pad every frame out to 8 bytes with kPaddingByte, which is required
+    /// by most automotive networks.
+    bool pad_frames = true;
+  };
+
+  /// @param can - CAN peripheral to send and receive frames with. Must be
+  ///        initialized and enabled.
+  explicit IsoTp(const Can & can) : can_(can) {}
+
+  /// Add a channel.
+  ///
+  /// @param channel - settings of the channel.
+  /// @return the index of the channel, which is passed to every other method.
+  Returns<size_t> Open(const Channel_t & channel)
+  {
+    if (!IsValidId(channel.transmit_id, channel.format) ||
+        !IsValidId(channel.receive_id, channel.format) ||
+        channel.separation_time > kMaxSeparationTime)
+    {
+      return Error(Status::kInvalidParameters,
+                   "Channel ID is out of range or separation time is larger "
+                   "than 127ms.");
+    }
+    if (channel_count_ == kMaxChannels)
+    {
+      return Error(Status::kOutOfBounds,
+                   "Every ISO-TP channel is in use, increase kMaxChannels.");
+    }
+
+    channels_[channel_count_] = State_t{ .settings = channel };
+    return channel_count_++;
+  }
+
+  /// Start sending a message. The data is sent straight from the caller's
+  /// memory, so it must not change until GetSendStatus() stops returning
+  /// Status::kNotReadyYet.
+  ///
+  /// @param channel - index of the channel to send on.
+  /// @param data - message to send.
+  Returns<void> Send(size_t channel, std::span<const uint8_t> data)
+  {
+    if (channel >= channel_count_ || data.empty())
+    {
+      return Error(Status::kInvalidParameters,
+                   "Channel is not open or message is empty.");
+    }
+
+    Transmit_t & transmit = channels_[channel].transmit;
+    if (transmit.status == Status::kNotReadyYet)
+    {
+      return Error(Status::kNotReadyYet,
+                   "A message is already being sent on this channel.");
+    }
+
+    const Channel_t & settings     = channels_[channel].settings;
+    std::array<uint8_t, 8> payload = {};
+    transmit                       = Transmit_t{ .data = data };
+
+    if (data.size() <= kSingleFrameCapacity)
+    {
+      payload[0] = Pci(FrameType::kSingle, data.size());
+      std::copy(data.begin(), data.end(), &payload[1]);
+      SendFrame(settings, payload, data.size() + 1);
+      transmit.status = Status::kSuccess;
+      return {};
+    }
+
+    size_t header = 2;
+    if (data.size() <= kMaxShortLength)
+    {
+      payload[0] = Pci(FrameType::kFirst, data.size() >> 8);
+      payload[1] = static_cast<uint8_t>(data.size());
+    }
+    else
+    {
+      // A length of zero escapes to a 32-bit length.
+      const uint32_t kLength = static_cast<uint32_t>(data.size());
+      payload[0]             = Pci(FrameType::kFirst, 0);
+      payload[1]             = 0;
+      payload[2]             = static_cast<uint8_t>(kLength >> 24);
+      payload[3]             = static_cast<uint8_t>(kLength >> 16);
+      payload[4]             = static_cast<uint8_t>(kLength >> 8);
+      payload[5]             = static_cast<uint8_t>(kLength);
+      header                 = 6;
+    }
+
+    transmit.position = payload.size() - header;
+    std::copy_n(data.begin(), transmit.position, &payload[header]);
+    SendFrame(settings, payload, payload.size());
+
+    transmit.state    = TransmitState::kWaitForFlowControl;
+    transmit.deadline = Uptime() + settings.timeout;
+    transmit.status   = Status::kNotReadyYet;
+    return {};
+  }
+
+  /// Start receiving the next message on a channel straight into a buffer.
+  /// Messages that arrive before Receive() is called, or after a message was
+  /// received and before Receive() is called again, are rejected.
+  ///
+  /// @param channel - index of the channel to receive on.
+  /// @param buffer - buffer to reassemble the message in. Messages longer than
+  ///        the buffer are rejected with an overflow flow control frame.
+  Returns<void> Receive(size_t channel, std::span<uint8_t> buffer)
+  {
+    if (channel >= channel_count_)
+    {
+      return Error(Status::kInvalidParameters, "Channel is not open.");
+    }
+
+    Receive_t & receive = channels_[channel].receive;
+    if (receive.state == ReceiveState::kReceiving)
+    {
+      return Error(Status::kNotReadyYet,
+                   "A message is already being received on this channel.");
+    }
+
+    receive = Receive_t{ .buffer = buffer, .state = ReceiveState::kReady };
+    return {};
+  }
+
+  /// @param channel - index of the channel.
+  /// @return Status::kNotReadyYet while the last message given to Send() is
+  ///         being sent, and Status::kSuccess once it was sent. Otherwise,
+  ///         Status::kTimedOut if the receiver stopped responding,
+  ///         Status::kOutOfBounds if the receiver's buffer was too small or
+  ///         Status::kBusError if the receiver's flow control was invalid.
+  Status GetSendStatus(size_t channel) const
+  {
+    return channels_[channel].transmit.status;
+  }
+
+  /// @param channel - index of the channel.
+  /// @return Status::kNotReadyYet until a whole message is received into the
+  ///         buffer given to Receive(), then Status::kSuccess. Otherwise,
+  ///         Status::kTimedOut if the sender stopped sending,
+  ///         Status::kOutOfBounds if the message was longer than the buffer or
+  ///         Status::kBusError if a consecutive frame was lost.
+  Status GetReceiveStatus(size_t channel) const
+  {
+    return channels_[channel].receive.status;
+  }
+
+  /// @param channel - index of the channel.
+  /// @return the length of the received message once GetReceiveStatus()
+  ///         returns Status::kSuccess.
+  size_t GetReceivedLength(size_t channel) const
+  {
+    return channels_[channel].receive.length;
+  }
+
+  /// Handle a frame received from the CAN bus.
+  ///
+  /// @param message - received frame.
+  /// @return true if the frame was sent to one of the channels.
+  bool Handle(const Can::Message_t & message)
+  {
+    if (message.length == 0 || message.is_remote_request)
+    {
+      return false;
+    }
+
+    for (size_t i = 0; i < channel_count_; i++)
+    {
+      State_t & channel = channels_[i];
+      if (channel.settings.receive_id != message.id ||
+          channel.settings.format != message.format)
+      {
+        continue;
+      }
+
+      switch (static_cast<FrameType>(message.payload[0] >> 4))
+      {
+        case FrameType::kSingle: HandleSingleFrame(channel, message); break;
+        case FrameType::kFirst: HandleFirstFrame(channel, message); break;
+        case FrameType::kConsecutive:
+          HandleConsecutiveFrame(channel, message);
+          break;
+        case FrameType::kFlowControl:
+          HandleFlowControl(channel, message);
+          break;
+      }
+      return true;
+    }
+    return false;
+  }
+
+  /// Send every consecutive frame that the receivers' flow control allows,
+  /// taking turns between channels, and fail transfers that timed out.
+  void Process()
+  {
+    const std::chrono::nanoseconds kNow = Uptime();
+
+    bool sent = true;
+    while (sent)
+    {
+      sent = false;
+      for (size_t i = 0; i < channel_count_; i++)
+      {
+        sent |= SendConsecutiveFrame(channels_[i], kNow);
+      }
+    }
+
+    for (size_t i = 0; i < channel_count_; i++)
+    {
+      CheckTimeouts(channels_[i], kNow);
+    }
+  }
+
+  /// Handle every frame waiting in the CAN peripheral, then Process().
+  void Service()
+  {
+    while (can_.HasData())
+    {
+      Handle(can_.Receive());
+    }
+    Process();
+  }
+
+ private:
+  enum class TransmitState : uint8_t
+  {
+    kIdle,
+    kWaitForFlowControl,
+    kSending,
+  };
+
+  enum class ReceiveState : uint8_t
+  {
+    kIdle,
+    kReady,
+    kReceiving,
+  };
+
+  /// Progress of the message being sent on a channel.
+  struct Transmit_t
+  {
+    std::span<const uint8_t> data;
+    size_t position                     = 0;
+    uint8_t sequence                    = 1;
+    uint8_t block_remaining             = 0;
+    std::chrono::nanoseconds separation = 0ns;
+    std::chrono::nanoseconds next_frame = 0ns;
+    std::chrono::nanoseconds deadline   = 0ns;
+    TransmitState state                 = TransmitState::kIdle;
+    Status status                       = Status::kSuccess;
+  };
+
+  /// Progress of the message being received on a channel.
+  struct Receive_t
+  {
+    std::span<uint8_t> buffer;
+    size_t length                     = 0;
+    size_t position                   = 0;
+    uint8_t sequence                  = 1;
+    uint8_t block_remaining           = 0;
+    std::chrono::nanoseconds deadline = 0ns;
+    ReceiveState state                = ReceiveState::kIdle;
+    Status status                     = Status::kNotReadyYet;
+  };
+
+  /// Settings and transfers of a single channel.
+  struct State_t
+  {
+    Channel_t settings;
+    Transmit_t transmit = {};
+    Receive_t receive   = {};
+  };
+
+  static constexpr bool IsValidId(uint32_t id, Can::Message_t::Format format)
+  {
+    return id <= ((format == Can::Message_t::Format::kExtended) ? 0x1FFF'FFFF
+                                                                : 0x7FF);
+  }
+
+  static constexpr uint8_t Pci(FrameType type, size_t low_nibble)
+  {
+    return static_cast<uint8_t>((Value(type) << 4) | (low_nibble & 0xF));
+  }
+
+  /// Encode a separation time into the STmin byte of a flow control frame.
+  static constexpr uint8_t EncodeSeparationTime(std::chrono::microseconds time)
+  {
+    if (time <= 0us)
+    {
+      return 0;
+    }
+    if (time <= 900us)
+    {
+      return static_cast<uint8_t>(0xF0 + ((time.count() + 99) / 100));
+    }
+    return static_cast<uint8_t>((time.count() + 999) / 1000);
+  }
+
+  /// Decode the STmin byte of a flow control frame. Reserved values are
+  /// treated as the longest separation time, as the standard requires.
+  static constexpr std::chrono::nanoseconds DecodeSeparationTime(uint8_t value)
+  {
+    if (value <= 0x7F)
+    {
+      return std::chrono::milliseconds(value);
+    }
+    if (value >= 0xF1 && value <= 0xF9)
+    {
+      return std::chrono::microseconds((value - 0xF0) * 100);
+    }
+    return kMaxSeparationTime;
+  }
+
+  void SendFrame(const Channel_t & settings,
+                 const std::array<uint8_t, 8> & payload,
+                 size_t length)
+  {
+    Can::Message_t message = {};
+    message.id             = settings.transmit_id;
+    message.format         = settings.format;
+    message.payload        = payload;
+    message.length         = static_cast<uint8_t>(length);
+    if (settings.pad_frames)
+    {
+      std::fill(&message.payload[length], message.payload.end(), kPaddingByte);
+      message.length = 8;
+    }
+    can_.Send(message);
+  }
+
+  void SendFlowControl(State_t & channel, FlowStatus status)
+  {
+    std::array<uint8_t, 8> payload = {
+      Pci(FrameType::kFlowControl, Value(status)),
+      channel.settings.block_size,
+      EncodeSeparationTime(channel.settings.separation_time),
+    };
+    SendFrame(channel.settings, payload, 3);
+  }
+
+  void HandleSingleFrame(State_t & channel, const Can::Message_t & message)
+  {
+    Receive_t & receive = channel.receive;
+    size_t length       = message.payload[0] & 0xF;
+    if (length == 0 || length > kSingleFrameCapacity ||
+        length >= message.length)
+    {
+      return;
+    }
+    // Messages that arrive before Receive() provides a buffer are ignored.
+    if (receive.state == ReceiveState::kIdle)
+    {
+      return;
+    }
+    if (length > receive.buffer.size())
+    {
+      receive.state  = ReceiveState::kIdle;
+      receive.status = Status::kOutOfBounds;
+      return;
+    }
+
+    // A new message replaces one that is still being received.
+    std::copy_n(&message.payload[1], length, receive.buffer.begin());
+    receive.length = length;
+    receive.state  = ReceiveState::kIdle;
+    receive.status = Status::kSuccess;
+  }
+
+  void HandleFirstFrame(State_t & channel, const Can::Message_t & message)
+  {
+    if (message.length != 8)
+    {
+      return;
+    }
+
+    Receive_t & receive = channel.receive;
+    size_t header       = 2;
+    size_t length       = (size_t{ message.payload[0] & 0xFU } << 8) |
+                    message.payload[1];
+    if (length == 0)
+    {
+      length = (size_t{ message.payload[2] } << 24) |
+               (size_t{ message.payload[3] } << 16) |
+               (size_t{ message.payload[4] } << 8) | message.payload[5];
+      header = 6;
+    }
+    if (length <= kSingleFrameCapacity)
+    {
+      return;
+    }
+
+    // Messages that arrive before Receive() provides a buffer are refused.
+    if (receive.state == ReceiveState::kIdle)
+    {
+      SendFlowControl(channel, FlowStatus::kOverflow);
+      return;
+    }
+    if (length > receive.buffer.size())
+    {
+      SendFlowControl(channel, FlowStatus::kOverflow);
+      receive.state  = ReceiveState::kIdle;
+      receive.status = Status::kOutOfBounds;
+      return;
+    }
+
+    // A new message replaces one that is still being received.
+    receive.length   = length;
+    receive.position = message.payload.size() - header;
+    receive.sequence = 1;
+    std::copy_n(&message.payload[header], receive.position,
+                receive.buffer.begin());
+    StartBlock(channel);
+  }
+
+  void HandleConsecutiveFrame(State_t & channel, const Can::Message_t & message)
+  {
+    Receive_t & receive = channel.receive;
+    if (receive.state != ReceiveState::kReceiving)
+    {
+      return;
+    }
+
+    size_t length = std::min(kSingleFrameCapacity,
+                             receive.length - receive.position);
+    if (length >= message.length)
+    {
+      return;
+    }
+    if ((message.payload[0] & 0xF) != receive.sequence)
+    {
+      receive.state  = ReceiveState::kIdle;
+      receive.status = Status::kBusError;
+      return;
+    }
+
+    std::copy_n(&message.payload[1], length,
+                receive.buffer.begin() + receive.position);
+    receive.position += length;
+    receive.sequence = (receive.sequence + 1) & 0xF;
+
+    if (receive.position == receive.length)
+    {
+      receive.state  = ReceiveState::kIdle;
+      receive.status = Status::kSuccess;
+    }
+    else if (receive.block_remaining != 0 && --receive.block_remaining == 0)
+    {
+      StartBlock(channel);
+    }
+    else
+    {
+      receive.deadline = Uptime() + channel.settings.timeout;
+    }
+  }
+
+  /// Let the sender send the next block of consecutive frames.
+  void StartBlock(State_t & channel)
+  {
+    Receive_t & receive     = channel.receive;
+    receive.state           = ReceiveState::kReceiving;
+    receive.block_remaining = channel.settings.block_size;
+    receive.deadline        = Uptime() + channel.settings.timeout;
+    SendFlowControl(channel, FlowStatus::kContinueToSend);
+  }
+
+  void HandleFlowControl(State_t & channel, const Can::Message_t & message)
+  {
+    Transmit_t & transmit = channel.transmit;
+    if (transmit.state != TransmitState::kWaitForFlowControl ||
+        message.length < 3)
+    {
+      return;
+    }
+
+    switch (static_cast<FlowStatus>(message.payload[0] & 0xF))
+    {
+      case FlowStatus::kContinueToSend:
+        transmit.block_remaining = message.payload[1];
+        transmit.separation      = DecodeSeparationTime(message.payload[2]);
+        transmit.next_frame      = Uptime();
+        transmit.state           = TransmitState::kSending;
+        break;
+      case FlowStatus::kWait:
+        transmit.deadline = Uptime() + channel.settings.timeout;
+        break;
+      case FlowStatus::kOverflow:
+        transmit.state  = TransmitState::kIdle;
+        transmit.status = Status::kOutOfBounds;
+        break;
+      default:
+        transmit.state  = TransmitState::kIdle;
+        transmit.status = Status::kBusError;
+        break;
+    }
+  }
+
+  /// @return true if a consecutive frame was sent.
+  bool SendConsecutiveFrame(State_t & channel, std::chrono::nanoseconds now)
+  {
+    Transmit_t & transmit = channel.transmit;
+    if (transmit.state != TransmitState::kSending || now < transmit.next_frame)
+    {
+      return false;
+    }
+
+    size_t length = std::min(kSingleFrameCapacity,
+                             transmit.data.size() - transmit.position);
+    std::array<uint8_t, 8> payload = {
+      Pci(FrameType::kConsecutive, transmit.sequence),
+    };
+    std::copy_n(transmit.data.begin() + transmit.position, length, &payload[1]);
+    SendFrame(channel.settings, payload, length + 1);
+
+    transmit.position += length;
+    transmit.sequence = (transmit.sequence + 1) & 0xF;
+
+    if (transmit.position == transmit.data.size())
+    {
+      transmit.state  = TransmitState::kIdle;
+      transmit.status = Status::kSuccess;
+    }
+    else if (transmit.block_remaining != 0 && --transmit.block_remaining == 0)
+    {
+      transmit.state    = TransmitState::kWaitForFlowControl;
+      transmit.deadline = now + channel.settings.timeout;
+    }
+    else
+    {
+      transmit.next_frame = now + transmit.separation;
+      // Keep sending in this pass only if the receiver allows back to back
+      // frames.
+      return transmit.separation == 0ns;
+    }
+    return true;
+  }
+
+  void CheckTimeouts(State_t & channel, std::chrono::nanoseconds now)
+  {
+    Transmit_t & transmit = channel.transmit;
+    if (transmit.state == TransmitState::kWaitForFlowControl &&
+        now > transmit.deadline)
+    {
+      transmit.state  = TransmitState::kIdle;
+      transmit.status = Status::kTimedOut;
+    }
+
+    Receive_t & receive = channel.receive;
+    if (receive.state == ReceiveState::kReceiving && now > receive.deadline)
+    {
+      receive.state  = ReceiveState::kIdle;
+      receive.status = Status::kTimedOut;
+    }
+  }
+
+  const Can & can_;
+  std::array<State_t, kMaxChannels> channels_ = {};
+  size_t channel_count_                       = 0;
+};
+}  // namespace sjsu
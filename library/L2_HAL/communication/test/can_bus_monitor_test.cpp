@@ -0,0 +1,182 @@
+#include <chrono>
+#include <cstdint>
+
+#include "L2_HAL/communication/can_bus_monitor.hpp"
+#include "L4_Testing/testing_frameworks.hpp"
+
+namespace sjsu
+{
+namespace
+{
+Can::Message_t CanMessage(uint32_t id, uint8_t length, uint8_t fill)
+{
+  Can::Message_t message = {};
+  message.id             = id;
+  message.length         = length;
+  message.payload.fill(fill);
+  return message;
+}
+}  // namespace
+
+TEST_CASE("Testing CanFrameBitLength()")
+{
+  using Format = Can::Message_t::Format;
+
+  // Alternating bits need few stuff bits, while long runs of 0s need many.
+  CHECK(113 == CanFrameBitLength(CanMessage(0x7FF, 8, 0x55)));
+  CHECK(127 == CanFrameBitLength(CanMessage(0x000, 8, 0x00)));
+  CHECK(53 == CanFrameBitLength(CanMessage(0x000, 0, 0x00)));
+
+  Can::Message_t extended = CanMessage(0x123'4567, 4, 0xAA);
+  extended.format         = Format::kExtended;
+  CHECK(100 == CanFrameBitLength(extended));
+
+  // Remote frames carry no data, whatever their length.
+  Can::Message_t remote    = CanMessage(0x100, 8, 0xFF);
+  remote.is_remote_request = true;
+  CHECK(49 == CanFrameBitLength(remote));
+}
+
+TEST_CASE("Testing CanBusMonitor")
+{
+  static std::chrono::nanoseconds fake_uptime;
+  fake_uptime = 10s;
+  SetUptimeFunction([]() { return fake_uptime; });
+
+  Can::ErrorStatistics_t errors = {};
+  Mock<Can> mock_can;
+  Fake(ConstOverloadedMethod(mock_can, Send, void(const Can::Message_t &)));
+  When(Method(mock_can, Receive))
+      .AlwaysReturn(CanMessage(0x7FF, 8, 0x55));
+  When(Method(mock_can, GetErrorStatistics)).AlwaysDo([&errors]() {
+    return errors;
+  });
+
+  // 100 kbit/s, so each 100ms bucket can hold 10'000 bits.
+  CanBusMonitor test_subject("can1", mock_can.get(), 100'000_Hz);
+  test_subject.Update();
+
+  SECTION("Utilization")
+  {
+    // Exercise
+    for (int i = 0; i < 10; i++)
+    {
+      test_subject.Send(CanMessage(0x7FF, 8, 0x55));
+    }
+    fake_uptime += 200ms;
+    test_subject.Receive();
+    fake_uptime += 300ms;
+    auto window = test_subject.GetWindow();
+
+    // Verify
+    Verify(ConstOverloadedMethod(mock_can, Send, void(const Can::Message_t &)))
+        .Exactly(10);
+    CHECK(10 == window.frames_sent);
+    CHECK(1 == window.frames_received);
+    CHECK(11 * 113 == window.bits);
+    CHECK(500ms == window.duration);
+    CHECK(0.02486f == doctest::Approx(window.utilization));
+    CHECK(0.113f == doctest::Approx(window.peak_utilization));
+  }
+
+  SECTION("Old buckets leave the window")
+  {
+    // Setup
+    test_subject.Send(CanMessage(0x7FF, 8, 0x55));
+    fake_uptime += 950ms;
+    test_subject.Send(CanMessage(0x7FF, 8, 0x55));
+
+    // Exercise
+    fake_uptime += 100ms;
+    auto window = test_subject.GetWindow();
+
+    // Verify
+    CHECK(1 == window.frames_sent);
+    CHECK(950ms == window.duration);
+
+    // Exercise
+    fake_uptime += 5s;
+    window = test_subject.GetWindow();
+
+    // Verify
+    CHECK(0 == window.frames_sent);
+    CHECK(window.utilization == doctest::Approx(0.0f));
+  }
+
+  SECTION("Errors")
+  {
+    // Setup: only errors after the first update are counted
+    errors.transmit_error_count                     = 130;
+    errors.receive_error_count                      = 2;
+    errors.bus_errors[Value(Can::BusError::kStuff)] = 3;
+    errors.bus_errors[Value(Can::BusError::kBit)]   = 1;
+    errors.arbitration_lost[4]                      = 1;
+    fake_uptime += 50ms;
+
+    // Exercise
+    auto window = test_subject.GetWindow();
+
+    // Verify
+    CHECK(130 == window.errors.transmit_error_count);
+    CHECK(2 == window.errors.receive_error_count);
+    CHECK(3 == window.errors.bus_errors[Value(Can::BusError::kStuff)]);
+    CHECK(1 == window.errors.bus_errors[Value(Can::BusError::kBit)]);
+    CHECK(1 == window.errors.arbitration_lost[4]);
+    CHECK(0 == window.errors.arbitration_lost[5]);
+
+    // Exercise
+    errors.bus_errors[Value(Can::BusError::kStuff)] = 5;
+    fake_uptime += 1s;
+    test_subject.Update();
+    fake_uptime += 500ms;
+    window = test_subject.GetWindow();
+
+    // Verify: the first errors have left the window
+    CHECK(2 == window.errors.bus_errors[Value(Can::BusError::kStuff)]);
+    CHECK(0 == window.errors.bus_errors[Value(Can::BusError::kBit)]);
+    CHECK(0 == window.errors.arbitration_lost[4]);
+  }
+
+  SECTION("SetBaudRate() changes the utilization")
+  {
+    // Setup
+    Fake(Method(mock_can, SetBaudRate));
+    test_subject.SetBaudRate(50'000_Hz);
+
+    // Exercise
+    test_subject.Send(CanMessage(0x7FF, 8, 0x55));
+    fake_uptime += 100ms;
+    auto window = test_subject.GetWindow();
+
+    // Verify
+    Verify(Method(mock_can, SetBaudRate).Using(50'000_Hz)).Once();
+    CHECK(0.0226f == doctest::Approx(window.utilization));
+  }
+
+  SECTION("Reset()")
+  {
+    // Setup
+    test_subject.Send(CanMessage(0x7FF, 8, 0x55));
+    fake_uptime += 300ms;
+
+    // Exercise
+    test_subject.Reset();
+    fake_uptime += 100ms;
+    auto window = test_subject.GetWindow();
+
+    // Verify
+    CHECK(0 == window.frames_sent);
+    CHECK(100ms == window.duration);
+  }
+
+  SECTION("Print()")
+  {
+    test_subject.Send(CanMessage(0x7FF, 8, 0x55));
+    errors.arbitration_lost[3] = 2;
+    test_subject.Print();
+    CHECK(std::string("can1") == test_subject.GetName());
+  }
+
+  SetUptimeFunction(DefaultUptime);
+}
+}  // namespace sjsu
@@ -0,0 +1,361 @@
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <numeric>
+#include <vector>
+
+#include "L2_HAL/communication/iso_tp.hpp"
+#include "L4_Testing/testing_frameworks.hpp"
+
+namespace sjsu
+{
+namespace
+{
+/// Can stand-in that delivers every sent message to a peer, so that two
+/// nodes can talk to each other on the host.
+class LoopbackCan final : public Can
+{
+ public:
+  Status Initialize() const override
+  {
+    return Status::kSuccess;
+  }
+  void Enable() const override {}
+  void Send(const Message_t & message) const override
+  {
+    sent.push_back(message);
+    if (peer != nullptr)
+    {
+      peer->inbox.push_back(message);
+    }
+  }
+  Message_t Receive() const override
+  {
+    Message_t message = inbox.front();
+    inbox.pop_front();
+    return message;
+  }
+  bool HasData() const override
+  {
+    return !inbox.empty();
+  }
+  bool SelfTest(uint32_t) const override
+  {
+    return true;
+  }
+  bool IsBusOff() const override
+  {
+    return false;
+  }
+  void SetBaudRate(units::frequency::hertz_t) const override {}
+
+  /// Node that receives the messages sent by this node.
+  const LoopbackCan * peer = nullptr;
+  /// Messages waiting to be received by this node.
+  mutable std::deque<Message_t> inbox;
+  /// Every message sent by this node.
+  mutable std::vector<Message_t> sent;
+};
+
+std::vector<uint8_t> CountingBytes(size_t length)
+{
+  std::vector<uint8_t> data(length);
+  std::iota(data.begin(), data.end(), uint8_t{ 0 });
+  return data;
+}
+}  // namespace
+
+TEST_CASE("Testing IsoTp")
+{
+  using IsoTp_t = IsoTp<2>;
+
+  LoopbackCan tester_can;
+  LoopbackCan ecu_can;
+  tester_can.peer = &ecu_can;
+  ecu_can.peer    = &tester_can;
+
+  IsoTp_t tester(tester_can);
+  IsoTp_t ecu(ecu_can);
+  IsoTp_t::Channel_t tester_channel = { .transmit_id = 0x7E0,
+                                        .receive_id  = 0x7E8 };
+  IsoTp_t::Channel_t ecu_channel    = { .transmit_id = 0x7E8,
+                                        .receive_id  = 0x7E0 };
+
+  auto run_until_done = [&]() {
+    do
+    {
+      tester.Service();
+      ecu.Service();
+    } while (!tester_can.inbox.empty() || !ecu_can.inbox.empty());
+  };
+
+  SECTION("Single frame")
+  {
+    // Setup
+    size_t tx                      = tester.Open(tester_channel).value();
+    size_t rx                      = ecu.Open(ecu_channel).value();
+    std::array<uint8_t, 8> buffer  = {};
+    std::array<uint8_t, 3> request = { 0x22, 0xF1, 0x90 };
+    REQUIRE(ecu.Receive(rx, buffer));
+
+    // Exercise
+    REQUIRE(tester.Send(tx, request));
+    run_until_done();
+
+    // Verify
+    REQUIRE(1 == tester_can.sent.size());
+    CHECK(0x7E0 == tester_can.sent[0].id);
+    CHECK(8 == tester_can.sent[0].length);
+    CHECK(0x03 == tester_can.sent[0].payload[0]);
+    CHECK(IsoTp_t::kPaddingByte == tester_can.sent[0].payload[7]);
+    CHECK(Status::kSuccess == tester.GetSendStatus(tx));
+    CHECK(Status::kSuccess == ecu.GetReceiveStatus(rx));
+    REQUIRE(3 == ecu.GetReceivedLength(rx));
+    CHECK(0x22 == buffer[0]);
+    CHECK(0x90 == buffer[2]);
+  }
+
+  SECTION("Frames without padding")
+  {
+    // Setup
+    tester_channel.pad_frames      = false;
+    size_t tx                      = tester.Open(tester_channel).value();
+    std::array<uint8_t, 2> request = { 0x10, 0x03 };
+
+    // Exercise
+    REQUIRE(tester.Send(tx, request));
+
+    // Verify
+    REQUIRE(1 == tester_can.sent.size());
+    CHECK(3 == tester_can.sent[0].length);
+  }
+
+  SECTION("Multiple frames with block size")
+  {
+    // Setup
+    ecu_channel.block_size = 4;
+    size_t tx              = tester.Open(tester_channel).value();
+    size_t rx              = ecu.Open(ecu_channel).value();
+    auto data              = CountingBytes(200);
+    std::vector<uint8_t> buffer(256);
+    REQUIRE(ecu.Receive(rx, buffer));
+
+    // Exercise
+    REQUIRE(tester.Send(tx, data));
+    CHECK(Status::kNotReadyYet == tester.GetSendStatus(tx));
+    run_until_done();
+
+    // Verify: a first frame with 6 bytes, then 28 consecutive frames
+    CHECK(Status::kSuccess == tester.GetSendStatus(tx));
+    REQUIRE(Status::kSuccess == ecu.GetReceiveStatus(rx));
+    REQUIRE(200 == ecu.GetReceivedLength(rx));
+    CHECK(std::equal(data.begin(), data.end(), buffer.begin()));
+
+    REQUIRE(29 == tester_can.sent.size());
+    CHECK(0x10 == tester_can.sent[0].payload[0]);
+    CHECK(200 == tester_can.sent[0].payload[1]);
+    CHECK(0x21 == tester_can.sent[1].payload[0]);
+    // Sequence numbers wrap around from 0xF to 0x0.
+    CHECK(0x2F == tester_can.sent[15].payload[0]);
+    CHECK(0x20 == tester_can.sent[16].payload[0]);
+    // A flow control frame after the first frame, then after every 4
+    // consecutive frames, except the last block.
+    REQUIRE(7 == ecu_can.sent.size());
+    CHECK(0x30 == ecu_can.sent[0].payload[0]);
+    CHECK(4 == ecu_can.sent[0].payload[1]);
+  }
+
+  SECTION("Messages longer than 4095 bytes")
+  {
+    // Setup
+    size_t tx = tester.Open(tester_channel).value();
+    size_t rx = ecu.Open(ecu_channel).value();
+    auto data = CountingBytes(5000);
+    std::vector<uint8_t> buffer(5000);
+    REQUIRE(ecu.Receive(rx, buffer));
+
+    // Exercise
+    REQUIRE(tester.Send(tx, data));
+    run_until_done();
+
+    // Verify
+    CHECK(0x10 == tester_can.sent[0].payload[0]);
+    CHECK(0x00 == tester_can.sent[0].payload[1]);
+    CHECK(0x13 == tester_can.sent[0].payload[4]);
+    CHECK(0x88 == tester_can.sent[0].payload[5]);
+    REQUIRE(Status::kSuccess == ecu.GetReceiveStatus(rx));
+    CHECK(5000 == ecu.GetReceivedLength(rx));
+    CHECK(data == buffer);
+  }
+
+  SECTION("Concurrent channels")
+  {
+    // Setup
+    size_t tx_a = tester.Open(tester_channel).value();
+    size_t rx_a = ecu.Open(ecu_channel).value();
+    size_t tx_b = tester.Open({ .transmit_id = 0x123,
+                                .receive_id  = 0x456 }).value();
+    size_t rx_b = ecu.Open({ .transmit_id = 0x456,
+                             .receive_id  = 0x123 }).value();
+    auto data_a = CountingBytes(40);
+    std::vector<uint8_t> data_b(50, 0xAB);
+    std::vector<uint8_t> buffer_a(64);
+    std::vector<uint8_t> buffer_b(64);
+    REQUIRE(ecu.Receive(rx_a, buffer_a));
+    REQUIRE(ecu.Receive(rx_b, buffer_b));
+
+    // Exercise
+    REQUIRE(tester.Send(tx_a, data_a));
+    REQUIRE(tester.Send(tx_b, data_b));
+    run_until_done();
+
+    // Verify
+    REQUIRE(Status::kSuccess == ecu.GetReceiveStatus(rx_a));
+    REQUIRE(Status::kSuccess == ecu.GetReceiveStatus(rx_b));
+    CHECK(std::equal(data_a.begin(), data_a.end(), buffer_a.begin()));
+    CHECK(std::equal(data_b.begin(), data_b.end(), buffer_b.begin()));
+    // Consecutive frames of both channels are interleaved.
+    CHECK(0x21 == tester_can.sent[2].payload[0]);
+    CHECK(0x21 == tester_can.sent[3].payload[0]);
+  }
+
+  SECTION("Receiver buffer too small")
+  {
+    // Setup
+    size_t tx                      = tester.Open(tester_channel).value();
+    size_t rx                      = ecu.Open(ecu_channel).value();
+    auto data                      = CountingBytes(20);
+    std::array<uint8_t, 16> buffer = {};
+    REQUIRE(ecu.Receive(rx, buffer));
+
+    // Exercise
+    REQUIRE(tester.Send(tx, data));
+    run_until_done();
+
+    // Verify
+    CHECK(Status::kOutOfBounds == tester.GetSendStatus(tx));
+    CHECK(Status::kOutOfBounds == ecu.GetReceiveStatus(rx));
+    REQUIRE(1 == ecu_can.sent.size());
+    CHECK(0x32 == ecu_can.sent[0].payload[0]);
+  }
+
+  SECTION("Timeouts and separation time")
+  {
+    // Setup
+    static std::chrono::nanoseconds fake_uptime;
+    fake_uptime = 0ns;
+    SetUptimeFunction([]() { return fake_uptime; });
+    ecu_channel.separation_time = 5ms;
+    size_t tx                   = tester.Open(tester_channel).value();
+    size_t rx                   = ecu.Open(ecu_channel).value();
+    auto data                   = CountingBytes(30);
+    std::vector<uint8_t> buffer(30);
+    REQUIRE(ecu.Receive(rx, buffer));
+
+    SECTION("Separation time")
+    {
+      // Exercise
+      REQUIRE(tester.Send(tx, data));
+      ecu.Service();
+      tester.Service();
+      tester.Service();
+
+      // Verify: the first frame and a single consecutive frame
+      CHECK(5 == ecu_can.sent[0].payload[2]);
+      CHECK(2 == tester_can.sent.size());
+
+      // Exercise
+      fake_uptime += 5ms;
+      tester.Service();
+
+      // Verify
+      CHECK(3 == tester_can.sent.size());
+    }
+
+    SECTION("Sender stops waiting for flow control")
+    {
+      // Setup
+      ecu_can.peer = nullptr;
+
+      // Exercise
+      REQUIRE(tester.Send(tx, data));
+      ecu.Service();
+      fake_uptime += 999ms;
+      tester.Service();
+      CHECK(Status::kNotReadyYet == tester.GetSendStatus(tx));
+      fake_uptime += 2ms;
+      tester.Service();
+
+      // Verify
+      CHECK(Status::kTimedOut == tester.GetSendStatus(tx));
+      CHECK(tester.Send(tx, data));
+    }
+
+    SECTION("Receiver stops waiting for consecutive frames")
+    {
+      // Setup
+      tester_can.peer = nullptr;
+      REQUIRE(tester.Send(tx, data));
+      ecu.Handle(tester_can.sent[0]);
+
+      // Exercise
+      fake_uptime += 1001ms;
+      ecu.Service();
+
+      // Verify
+      CHECK(Status::kTimedOut == ecu.GetReceiveStatus(rx));
+    }
+
+    SetUptimeFunction(DefaultUptime);
+  }
+
+  SECTION("Lost consecutive frame")
+  {
+    // Setup
+    size_t tx = tester.Open(tester_channel).value();
+    size_t rx = ecu.Open(ecu_channel).value();
+    auto data = CountingBytes(30);
+    std::vector<uint8_t> buffer(30);
+    REQUIRE(ecu.Receive(rx, buffer));
+    REQUIRE(tester.Send(tx, data));
+    ecu.Service();
+    tester.Service();
+
+    // Exercise: drop the first consecutive frame
+    ecu_can.inbox.pop_front();
+    ecu.Service();
+
+    // Verify
+    CHECK(Status::kBusError == ecu.GetReceiveStatus(rx));
+  }
+
+  SECTION("Frames without a buffer are rejected")
+  {
+    // Setup
+    size_t tx = tester.Open(tester_channel).value();
+    auto data = CountingBytes(30);
+    REQUIRE(ecu.Open(ecu_channel));
+
+    // Exercise
+    REQUIRE(tester.Send(tx, data));
+    run_until_done();
+
+    // Verify
+    CHECK(Status::kOutOfBounds == tester.GetSendStatus(tx));
+  }
+
+  SECTION("Invalid channels")
+  {
+    // Exercise & Verify
+    CHECK(!tester.Open({ .transmit_id = 0x800, .receive_id = 0x7E8 }));
+    CHECK(!tester.Open({ .transmit_id     = 0x7E0,
+                         .receive_id      = 0x7E8,
+                         .separation_time = 128ms }));
+    CHECK(tester.Open(tester_channel));
+    CHECK(tester.Open(ecu_channel));
+    CHECK(!tester.Open(tester_channel));
+    CHECK(!tester.Send(2, CountingBytes(1)));
+  }
+}
+}  // namespace sjsu
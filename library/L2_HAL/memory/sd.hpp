@@ -136,6 +136,8 @@ class Sd : public Storage
                                    // application-specific command
     kGetOcr = kCommandBase | 58,   // CMD58: request data from the
                                    // operational conditions register
+    kCrcOnOff = kCommandBase | 59,  // CMD59: turns the card's CRC checking of
+                                    // commands and data blocks on or off
     kAcInit = kCommandBase | 41    // CMD41: application-specific version of
                                    // CMD1 (must precede with CMD55)
   };
@@ -318,9 +320,6 @@ class Sd : public Storage
         }
       }
 
-      // Set the CRC bytes of the block before transmission
-      block.SetCrcBytes();
-
       // Convert the block address into a byte address
       uint32_t block_byte_address = block_address + block_offset;
       SJ2_RETURN_ON_ERROR(WriteBlock(block_byte_address, block));
@@ -362,6 +361,35 @@ class Sd : public Storage
     return {};
   }
 
+  /// Enable or disable CRC protection of data blocks. When enabled (the
+  /// default), the CRC16 of each block is computed byte by byte as the block
+  /// is clocked over SPI and the card is told via CMD59 to verify everything
+  /// it receives. Disabling CRC removes the per-byte CRC calculation which is
+  /// useful for trusted, high throughput logging.
+  ///
+  /// If the card has not been mounted yet, the setting will be applied when
+  /// Enable() is called.
+  ///
+  /// @param enable - true to enable CRC checking, false to disable it.
+  Returns<void> SetCrcChecking(bool enable)
+  {
+    crc_enabled_ = enable;
+
+    if (is_mounted_)
+    {
+      SJ2_RETURN_ON_ERROR(SendCrcSetting());
+    }
+
+    return {};
+  }
+
+  /// @return true if CRC generation and verification of data blocks is
+  ///         enabled.
+  bool IsCrcEnabled() const
+  {
+    return crc_enabled_;
+  }
+
   /// Returns the SD card's information as a reference.
   /// Used for testing purposes and should not be used in production code.
   /// In production code, the CardInfo_t object returned is a dummy object and
@@ -382,17 +410,9 @@ class Sd : public Storage
  private:
   struct Block_t
   {
-    // +2 for CRC
-    std::array<uint8_t, kBlockSize + 2> byte;
-
-    void SetCrcBytes()
-    {
-      uint16_t crc = GetCrc16(byte.data(), kBlockSize);
-      // Set the last byte to the LSB of the crc
-      byte.end()[-1] = static_cast<uint8_t>(bit::Extract(crc, 0, 8));
-      // Set the second to last byte to the MSB of the crc
-      byte.end()[-2] = static_cast<uint8_t>(bit::Extract(crc, 8, 8));
-    }
+    // NOTE: The block's CRC16 is not stored here, it is calculated as the
+    // bytes are transferred over SPI.
+    std::array<uint8_t, kBlockSize> byte;
   };
 
   // Returns string to represent a boolean value
@@ -496,17 +516,25 @@ class Sd : public Storage
     // Wait for the card to respond with a ready signal
     WaitToReadBlock();
 
-    // Read all the bytes of a single block
-    for (uint16_t i = 0; i < block.byte.size(); i++)
+    // Read all the bytes of a single block, accumulating the CRC as each byte
+    // arrives so verification does not require a second pass over the block.
+    uint16_t expected_block_crc = 0;
+    for (auto & byte : block.byte)
     {
-      block.byte[i] = static_cast<uint8_t>(spi_.Transfer(0xFF));
+      byte = static_cast<uint8_t>(spi_.Transfer(0xFF));
+      if (crc_enabled_)
+      {
+        expected_block_crc = Crc16Add(expected_block_crc, byte);
+      }
     }
 
     // Then read the last two bytes to get the 16-bit CRC
-    uint32_t block_crc = block.byte.end()[-2] << 8 | block.byte.end()[-1];
-    uint32_t expected_block_crc = GetCrc16(block.byte.data(), kBlockSize);
+    uint16_t crc_higher_byte = spi_.Transfer(0xFF);
+    uint16_t crc_lower_byte  = spi_.Transfer(0xFF);
+    uint16_t block_crc =
+        static_cast<uint16_t>(crc_higher_byte << 8 | crc_lower_byte);
 
-    if (expected_block_crc != block_crc)
+    if (crc_enabled_ && expected_block_crc != block_crc)
     {
       LogDebug("Expected CRC '0x%04X' :: Got '0x%04X'", expected_block_crc,
                block_crc);
@@ -548,8 +576,27 @@ class Sd : public Storage
     constexpr uint8_t kWriteStartToken = 0xFE;
     spi_.Transfer(kWriteStartToken);
 
-    // Write all 512-bytes of the given block
-    spi_.Transfer(block.byte);
+    // Write all 512-bytes of the given block, accumulating the CRC as each
+    // byte is queued for transmission.
+    uint16_t crc = 0xFFFF;
+    if (crc_enabled_)
+    {
+      crc = 0;
+    }
+
+    for (const auto & byte : block.byte)
+    {
+      spi_.Transfer(byte);
+      if (crc_enabled_)
+      {
+        crc = Crc16Add(crc, byte);
+      }
+    }
+
+    // Send the MSB then the LSB of the CRC. If CRC checking is disabled, the
+    // card ignores these bytes.
+    spi_.Transfer(static_cast<uint8_t>(bit::Extract(crc, 8, 8)));
+    spi_.Transfer(static_cast<uint8_t>(bit::Extract(crc, 0, 8)));
 
     // Read the data response token after writing the block
     uint8_t data_response_token = static_cast<uint8_t>(spi_.Transfer(0xFF));
@@ -563,6 +610,24 @@ class Sd : public Storage
 
     WaitWhileBusy();
 
+    // The lower 5 bits of the data response token are "0b0'0101" when the
+    // data was accepted, "0b0'1011" when the card detected a CRC error and
+    // "0b0'1101" when the card failed to write the data. Anything else, such
+    // as 0xFF from a card that did not respond, is not a valid token.
+    constexpr bit::Mask kDataResponseMask   = bit::MaskFromRange(0, 4);
+    constexpr uint8_t kDataAccepted         = 0b0'0101;
+    constexpr uint8_t kDataRejectedCrcError = 0b0'1011;
+    const uint8_t kDataResponse = static_cast<uint8_t>(
+        bit::Extract(data_response_token, kDataResponseMask));
+    if (kDataResponse == kDataRejectedCrcError)
+    {
+      return Error(Status::kBusError, "CRC Mismatch on Block Write!");
+    }
+    if (kDataResponse != kDataAccepted)
+    {
+      return Error(Status::kBusError, "Card did not accept the block write!");
+    }
+
     return {};
   }
 
@@ -722,6 +787,7 @@ class Sd : public Storage
       case Command::kAcBegin: response_type = ResponseType::kR1; break;
       case Command::kAcInit: response_type = ResponseType::kR1; break;
       case Command::kGetOcr: response_type = ResponseType::kR3; break;
+      case Command::kCrcOnOff: response_type = ResponseType::kR1; break;
       case Command::kChgBlkLen: response_type = ResponseType::kR1; break;
       case Command::kReadSingle: response_type = ResponseType::kR1; break;
       case Command::kReadMulti: response_type = ResponseType::kR1; break;
@@ -873,6 +939,11 @@ class Sd : public Storage
       return Error(Status::kTimedOut, "Initialization Failed!");
     }
 
+    // =========================================================================
+    // Apply CRC Setting
+    // =========================================================================
+    SJ2_RETURN_ON_ERROR(SendCrcSetting());
+
     // =========================================================================
     // Get Card Capacity Type
     // =========================================================================
@@ -895,6 +966,25 @@ class Sd : public Storage
     // Bring the clock speed back up for typical use
     spi_.SetClock(spi_clock_rate_);
 
+    is_mounted_ = true;
+
+    return {};
+  }
+
+  /// Tell the card to turn its CRC checking on or off based on crc_enabled_.
+  Returns<void> SendCrcSetting()
+  {
+    LogDebug("Setting CRC checking to %s", ToBool(crc_enabled_));
+    uint32_t crc_option = crc_enabled_;
+    Response_t response =
+        SendCommand(Command::kCrcOnOff, crc_option, KeepAlive::kNo);
+
+    if (!CommandWasAcknowledged(response))
+    {
+      return Error(Status::kBusError,
+                   "CRC On/Off Command was not acknowledged properly!");
+    }
+
     return {};
   }
 
@@ -974,20 +1064,23 @@ class Sd : public Storage
     return crc;
   }
 
+  // Adds a message byte to the current CCITT CRC-16 to get the new CRC-16
+  static uint16_t Crc16Add(uint16_t crc, uint8_t message_byte)
+  {
+    return static_cast<uint16_t>(
+        kCrcTable16.crc_table[((crc >> 8) ^ message_byte) & 0xFF] ^
+        (crc << 8));
+  }
+
   // Returns CCITT CRC-16 for a message of "length" bytes
   static uint16_t GetCrc16(const uint8_t * message, uint16_t length)
   {
-    uint64_t crc = 0x0000;
-    uint64_t temp;
-    uint64_t final_value = 0;
-
-    for (uint64_t count = 0; count < length; ++count)
+    uint16_t crc = 0x0000;
+    for (uint16_t count = 0; count < length; ++count)
     {
-      temp = (*message++ ^ (crc >> 8)) & 0xff;
-      crc  = kCrcTable16.crc_table[temp] ^ (crc << 8);
+      crc = Crc16Add(crc, message[count]);
     }
-
-    return static_cast<uint16_t>(crc ^ final_value);
+    return crc;
   }
 
   Spi & spi_;
@@ -996,5 +1089,7 @@ class Sd : public Storage
   Gpio::State card_detect_active_level_;
   units::frequency::hertz_t spi_clock_rate_;
   CardInfo_t sd_;
+  bool crc_enabled_ = true;
+  bool is_mounted_  = false;
 };
 }  // namespace sjsu
@@ -1,3 +1,8 @@
+#include <algorithm>
+#include <deque>
+#include <string_view>
+#include <vector>
+
 #include "L2_HAL/memory/sd.hpp"
 #include "L4_Testing/testing_frameworks.hpp"
 
@@ -149,12 +154,190 @@ TEST_CASE("Testing SD Card Driver Class")
 
   SECTION("Read()")
   {
-    // NOT TESTED!
+    // Setup: Script the bytes that the SD card will return over SPI. Once the
+    // script has run out, the card will respond with 0x00.
+    std::deque<uint8_t> script;
+    When(ConstOverloadedMethod(mock_spi, Transfer, uint16_t(uint16_t)))
+        .AlwaysDo([&script](uint16_t) -> uint16_t {
+          if (script.empty())
+          {
+            return 0x00;
+          }
+          uint8_t response = script.front();
+          script.pop_front();
+          return response;
+        });
+
+    // Setup: Wait while busy (0xFF), the padding byte, command payload and
+    // command CRC, then the R1 response (0x00) followed by the start token
+    // (0xFE) and a block of all 0xFF.
+    script.push_back(0xFF);
+    script.insert(script.end(), 7, 0xFF);
+    script.push_back(0x00);
+    script.push_back(0xFE);
+    script.insert(script.end(), Sd::kBlockSize, 0xFF);
+
+    std::array<uint8_t, Sd::kBlockSize> data;
+    data.fill(0x00);
+
+    SECTION("Valid CRC")
+    {
+      // Setup: The CCITT CRC16 of 512 bytes of 0xFF is 0x7FA1
+      script.push_back(0x7F);
+      script.push_back(0xA1);
+
+      // Exercise
+      auto result = sd.Read(0, data.data(), data.size());
+
+      // Verify
+      CHECK(result);
+      CHECK(std::all_of(data.begin(), data.end(),
+                        [](uint8_t byte) { return byte == 0xFF; }));
+    }
+
+    SECTION("Invalid CRC")
+    {
+      // Setup
+      script.push_back(0x12);
+      script.push_back(0x34);
+
+      // Exercise
+      auto result = sd.Read(0, data.data(), data.size());
+
+      // Verify
+      REQUIRE(!result);
+      CHECK(Status::kBusError == result.error()->status);
+    }
+
+    SECTION("Invalid CRC with CRC checking disabled")
+    {
+      // Setup
+      script.push_back(0x12);
+      script.push_back(0x34);
+      CHECK(sd.SetCrcChecking(false));
+
+      // Exercise
+      auto result = sd.Read(0, data.data(), data.size());
+
+      // Verify
+      CHECK(!sd.IsCrcEnabled());
+      CHECK(result);
+      CHECK(std::all_of(data.begin(), data.end(),
+                        [](uint8_t byte) { return byte == 0xFF; }));
+    }
   }
 
   SECTION("Write()")
   {
-    // NOT TESTED!
+    // Setup: Record every byte sent to the card and script the bytes that the
+    // card will return.
+    std::vector<uint8_t> transmitted;
+    std::deque<uint8_t> script;
+    When(ConstOverloadedMethod(mock_spi, Transfer, uint16_t(uint16_t)))
+        .AlwaysDo([&script, &transmitted](uint16_t data) -> uint16_t {
+          transmitted.push_back(static_cast<uint8_t>(data));
+          if (script.empty())
+          {
+            return 0xFF;
+          }
+          uint8_t response = script.front();
+          script.pop_front();
+          return response;
+        });
+
+    // Setup: Wait while busy (0xFF), the padding byte, command payload and
+    // command CRC, then the R1 response (0x00). The card then returns 0xFF
+    // while it receives the start token, block and CRC.
+    script.push_back(0xFF);
+    script.insert(script.end(), 7, 0xFF);
+    script.push_back(0x00);
+    script.insert(script.end(), 1 + Sd::kBlockSize + 2, 0xFF);
+
+    std::array<uint8_t, Sd::kBlockSize> data;
+    data.fill(0xFF);
+
+    // The start token is transmitted after the initial busy wait, padding,
+    // command payload, command CRC and response bytes.
+    constexpr size_t kStartTokenIndex = 9;
+    constexpr size_t kCrcIndex        = kStartTokenIndex + 1 + Sd::kBlockSize;
+
+    SECTION("CRC Enabled")
+    {
+      // Setup: Data accepted token
+      script.push_back(0xE5);
+
+      // Exercise
+      auto result = sd.Write(0, data.data(), data.size());
+
+      // Verify
+      CHECK(result);
+      REQUIRE(transmitted.size() > kCrcIndex + 1);
+      CHECK(0xFE == transmitted[kStartTokenIndex]);
+      CHECK(std::all_of(&transmitted[kStartTokenIndex + 1],
+                        &transmitted[kCrcIndex],
+                        [](uint8_t byte) { return byte == 0xFF; }));
+      CHECK(0x7F == transmitted[kCrcIndex]);
+      CHECK(0xA1 == transmitted[kCrcIndex + 1]);
+    }
+
+    SECTION("Card rejects CRC")
+    {
+      // Setup: Data rejected due to CRC error token
+      script.push_back(0xEB);
+
+      // Exercise
+      auto result = sd.Write(0, data.data(), data.size());
+
+      // Verify
+      REQUIRE(!result);
+      CHECK(Status::kBusError == result.error()->status);
+      CHECK(std::string_view(result.error()->message).find("CRC") !=
+            std::string_view::npos);
+    }
+
+    SECTION("Card reports a write error")
+    {
+      // Setup: Data rejected due to write error token
+      script.push_back(0xED);
+
+      // Exercise
+      auto result = sd.Write(0, data.data(), data.size());
+
+      // Verify
+      REQUIRE(!result);
+      CHECK(Status::kBusError == result.error()->status);
+      CHECK(std::string_view(result.error()->message).find("CRC") ==
+            std::string_view::npos);
+    }
+
+    SECTION("Card does not respond with a data response token")
+    {
+      // Setup: Script runs out, so the card returns 0xFF
+
+      // Exercise
+      auto result = sd.Write(0, data.data(), data.size());
+
+      // Verify
+      REQUIRE(!result);
+      CHECK(Status::kBusError == result.error()->status);
+    }
+
+    SECTION("CRC Disabled")
+    {
+      // Setup
+      script.push_back(0xE5);
+      CHECK(sd.SetCrcChecking(false));
+
+      // Exercise
+      auto result = sd.Write(0, data.data(), data.size());
+
+      // Verify
+      CHECK(result);
+      REQUIRE(transmitted.size() > kCrcIndex + 1);
+      CHECK(0xFE == transmitted[kStartTokenIndex]);
+      CHECK(0xFF == transmitted[kCrcIndex]);
+      CHECK(0xFF == transmitted[kCrcIndex + 1]);
+    }
   }
 }
 }  // namespace sjsu::experimental
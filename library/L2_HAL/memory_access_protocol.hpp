@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <type_traits>
 #include <span>
+#include <tuple>
 #include <utility>
 
 #include "L1_Peripheral/i2c.hpp"
@@ -393,7 +394,9 @@ class I2cProtocol : public MemoryAccessProtocol
     std::copy(address.begin(), address.end(), buffer.begin());
     std::copy(value.begin(), value.end(), buffer.begin() + address.size());
 
-    SJ2_RETURN_ON_ERROR(i2c_.Write(i2c_address_, buffer));
+    const size_t kLength = address.size() + value.size();
+    SJ2_RETURN_ON_ERROR(
+        i2c_.Write(i2c_address_, std::span(buffer).first(kLength)));
     return {};
   }
 
@@ -409,6 +412,240 @@ class I2cProtocol : public MemoryAccessProtocol
   const sjsu::I2c & i2c_;
 };
 
+/// How CachedProtocol treats accesses to a register.
+enum class CachePolicy : uint8_t
+{
+  /// Never cached. Use for status, data and FIFO registers whose contents are
+  /// changed by the device.
+  kVolatile,
+  /// Reads are served from the cache once the register has been read or
+  /// written. Writes go to the device immediately.
+  kWriteThrough,
+  /// Like kWriteThrough, but writes only update the cache until Sync() is
+  /// called, so several fields of a register can be changed with a single
+  /// write.
+  kWriteBack,
+};
+
+/// Keeps a shadow copy of a device's configuration registers, so that reading
+/// a register that is only changed by the driver does not cost a bus
+/// transaction. With it, read-modify-write operations such as
+/// `memory[kConfig] |= 0x18` cost a single write once the register is cached.
+///
+/// CachedProtocol wraps the MemoryAccessProtocol of a device and is used in
+/// its place. Only registers passed to Declare() are cached, and only accesses
+/// with the register's exact address and width use the cache. Any other
+/// access goes to the device, after writing back dirty registers that it
+/// overlaps. Writes that overlap a cached register invalidate it.
+///
+/// Call Invalidate() whenever the device may have changed its own
+/// configuration, such as after a reset.
+///
+/// @tparam kMaxRegisters - maximum number of registers that can be declared.
+template <size_t kMaxRegisters>
+class CachedProtocol : public MemoryAccessProtocol
+{
+ public:
+  /// Widest register that can be cached, in bytes.
+  static constexpr size_t kMaxRegisterWidth = 8;
+
+  /// @param device - protocol used to access the device.
+  explicit constexpr CachedProtocol(MemoryAccessProtocol & device)
+      : device_(device)
+  {
+  }
+
+  /// Declare how accesses to a register are to be cached. Registers start out
+  /// uncached and are filled by the first read or write.
+  ///
+  /// @param device_register - register to cache.
+  /// @param policy - how to cache the register.
+  /// @return an error if kMaxRegisters have already been declared or if the
+  ///         register is wider than kMaxRegisterWidth.
+  template <AddressWidth address_width, std::endian endianness>
+  Returns<void> Declare(
+      const Address<address_width, endianness> & device_register,
+      CachePolicy policy = CachePolicy::kWriteThrough)
+  {
+    if (device_register.width > kMaxRegisterWidth)
+    {
+      return Error(Status::kInvalidParameters,
+                   "Register is too wide to be cached.");
+    }
+    if (register_count_ >= registers_.size())
+    {
+      return Error(Status::kOutOfBounds,
+                   "CachedProtocol cannot hold any more registers.");
+    }
+
+    Register_t & entry = registers_[register_count_++];
+    entry              = Register_t{
+      .location      = ToInteger<uint32_t>(endianness, device_register.address),
+      .address_width = static_cast<uint8_t>(device_register.address.size()),
+      .width         = device_register.width,
+      .endianness    = endianness,
+      .policy        = policy,
+    };
+    std::copy(device_register.address.begin(), device_register.address.end(),
+              entry.address.begin());
+    return {};
+  }
+
+  Returns<void> Write(std::span<const uint8_t> address,
+                      std::span<const uint8_t> payload) override
+  {
+    Register_t * entry = Find(address, payload.size());
+    if (entry == nullptr)
+    {
+      SJ2_RETURN_ON_ERROR(WriteBackOverlapping(address, payload.size()));
+      SJ2_RETURN_ON_ERROR(device_.Write(address, payload));
+      InvalidateOverlapping(address, payload.size());
+      return {};
+    }
+
+    if (entry->policy == CachePolicy::kWriteBack)
+    {
+      entry->is_dirty = true;
+    }
+    else
+    {
+      entry->is_valid = false;
+      SJ2_RETURN_ON_ERROR(device_.Write(address, payload));
+    }
+    std::copy(payload.begin(), payload.end(), entry->value.begin());
+    entry->is_valid = true;
+    return {};
+  }
+
+  Returns<void> Read(std::span<const uint8_t> address,
+                     std::span<uint8_t> payload) override
+  {
+    Register_t * entry = Find(address, payload.size());
+    if (entry == nullptr)
+    {
+      SJ2_RETURN_ON_ERROR(WriteBackOverlapping(address, payload.size()));
+      return device_.Read(address, payload);
+    }
+
+    if (!entry->is_valid)
+    {
+      SJ2_RETURN_ON_ERROR(
+          device_.Read(address, std::span(entry->value).first(entry->width)));
+      entry->is_valid = true;
+    }
+    std::copy_n(entry->value.begin(), payload.size(), payload.begin());
+    return {};
+  }
+
+  /// Write every kWriteBack register that has changed since it was last
+  /// written to the device.
+  Returns<void> Sync()
+  {
+    for (size_t i = 0; i < register_count_; i++)
+    {
+      SJ2_RETURN_ON_ERROR(WriteBack(registers_[i]));
+    }
+    return {};
+  }
+
+  /// Forget the contents of every register, so that they are read from the
+  /// device again. Changes that have not been written by Sync() are lost.
+  void Invalidate()
+  {
+    for (size_t i = 0; i < register_count_; i++)
+    {
+      registers_[i].is_valid = false;
+      registers_[i].is_dirty = false;
+    }
+  }
+
+ private:
+  /// A declared register and its shadow copy.
+  struct Register_t
+  {
+    uint32_t location;
+    uint8_t address_width;
+    uint8_t width;
+    std::endian endianness;
+    CachePolicy policy;
+    bool is_valid = false;
+    bool is_dirty = false;
+    std::array<uint8_t, kAddressSizeLimit> address = {};
+    std::array<uint8_t, kMaxRegisterWidth> value   = {};
+  };
+
+  /// @return true if the `size` bytes at `address` overlap the register.
+  static bool Overlaps(const Register_t & entry,
+                       std::span<const uint8_t> address,
+                       size_t size)
+  {
+    if (address.size() != entry.address_width)
+    {
+      return false;
+    }
+    const uint32_t kLocation = ToInteger<uint32_t>(entry.endianness, address);
+    return kLocation < entry.location + entry.width &&
+           entry.location < kLocation + size;
+  }
+
+  /// @return the cached register at exactly `address` and `size`, or nullptr
+  ///         if there is none.
+  Register_t * Find(std::span<const uint8_t> address, size_t size)
+  {
+    for (size_t i = 0; i < register_count_; i++)
+    {
+      Register_t & entry = registers_[i];
+      if (entry.policy != CachePolicy::kVolatile && entry.width == size &&
+          entry.address_width == address.size() &&
+          std::equal(address.begin(), address.end(), entry.address.begin()))
+      {
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+
+  Returns<void> WriteBack(Register_t & entry)
+  {
+    if (entry.is_dirty)
+    {
+      SJ2_RETURN_ON_ERROR(device_.Write(
+          std::span(entry.address).first(entry.address_width),
+          std::span(entry.value).first(entry.width)));
+      entry.is_dirty = false;
+    }
+    return {};
+  }
+
+  Returns<void> WriteBackOverlapping(std::span<const uint8_t> address,
+                                     size_t size)
+  {
+    for (size_t i = 0; i < register_count_; i++)
+    {
+      if (Overlaps(registers_[i], address, size))
+      {
+        SJ2_RETURN_ON_ERROR(WriteBack(registers_[i]));
+      }
+    }
+    return {};
+  }
+
+  void InvalidateOverlapping(std::span<const uint8_t> address, size_t size)
+  {
+    for (size_t i = 0; i < register_count_; i++)
+    {
+      if (Overlaps(registers_[i], address, size))
+      {
+        registers_[i].is_valid = false;
+      }
+    }
+  }
+
+  MemoryAccessProtocol & device_;
+  std::array<Register_t, kMaxRegisters> registers_ = {};
+  size_t register_count_                           = 0;
+};
+
 template <MemoryAccessProtocol::AddressWidth address_width,
           std::endian endianness>
 constexpr bool NoRegistersOverlap(
@@ -428,4 +665,237 @@ constexpr bool NoRegistersOverlap(
   }
   return true;
 }
+
+/// A set of registers that are read together, such as the data registers of a
+/// sensor. The registers are fetched with as few auto-incrementing burst reads
+/// as possible and each is converted to the type of its field, using the
+/// endianness of the device.
+///
+/// Registers do not need to be contiguous or in address order. Registers
+/// separated by no more than `max_gap` unused bytes are read in the same burst,
+/// since reading a few extra bytes costs less bus time than starting another
+/// transaction. Use a `max_gap` of 0 for devices whose unused addresses must
+/// not be read.
+///
+/// Usage:
+///
+///     static constexpr auto kMotion =
+///         MakeRegisterGroup<std::array<int16_t, 3>, int16_t>(kAccel, kTemp);
+///     Returns<Sample_t> sample = kMotion.Read<Sample_t>(memory);
+///
+/// @tparam Fields - type of each register in the group, in the order the
+///         registers are given. Each is an integer or a std::array of
+///         integers. Registers narrower than their field are zero extended.
+template <MemoryAccessProtocol::AddressWidth address_width,
+          std::endian endianness,
+          typename... Fields>
+class RegisterGroup
+{
+ public:
+  using Address_t = MemoryAccessProtocol::Address<address_width, endianness>;
+
+  /// Number of registers in the group.
+  static constexpr size_t kFieldCount = sizeof...(Fields);
+
+  /// Maximum number of bytes read in a single burst.
+  static constexpr size_t kMaxBurstLength = 32;
+
+  /// Gap that costs about as much bus time as starting another burst: the
+  /// device address, the register address and a repeated start.
+  static constexpr size_t kDefaultMaxGap = Value(address_width) + 2;
+
+  /// @param registers - register holding each field.
+  /// @param max_gap - largest number of unused bytes to read between two
+  ///        registers to avoid starting another burst.
+  explicit constexpr RegisterGroup(
+      const std::array<Address_t, kFieldCount> & registers,
+      size_t max_gap = kDefaultMaxGap)
+  {
+    std::array<size_t, kFieldCount> order = {};
+    for (size_t i = 0; i < kFieldCount; i++)
+    {
+      fields_[i].location = ToInteger<uint32_t>(endianness,
+                                                registers[i].address);
+      fields_[i].width    = registers[i].width;
+      is_valid_           = is_valid_ && (fields_[i].width <= kMaxBurstLength);
+
+      // Insertion sort the registers by location
+      size_t position = i;
+      for (; position > 0; position--)
+      {
+        if (fields_[order[position - 1]].location <= fields_[i].location)
+        {
+          break;
+        }
+        order[position] = order[position - 1];
+      }
+      order[position] = i;
+    }
+
+    for (size_t index : order)
+    {
+      Field_t & field     = fields_[index];
+      const uint32_t kEnd = field.location + field.width;
+      Burst_t * burst     = nullptr;
+      if (burst_count_ > 0)
+      {
+        burst = &bursts_[burst_count_ - 1];
+      }
+
+      if (burst == nullptr ||
+          field.location > burst->location + burst->length + max_gap ||
+          kEnd - burst->location > kMaxBurstLength)
+      {
+        burst           = &bursts_[burst_count_++];
+        burst->location = field.location;
+        burst->length   = 0;
+      }
+
+      burst->length = std::max(burst->length, kEnd - burst->location);
+      field.burst   = burst_count_ - 1;
+      field.offset  = field.location - burst->location;
+    }
+  }
+
+  /// @return the number of burst reads performed by Read().
+  constexpr size_t GetBurstCount() const
+  {
+    return burst_count_;
+  }
+
+  /// Read every register in the group from the device.
+  ///
+  /// @tparam Struct - type to return. Defaults to a std::tuple of the fields.
+  ///         Any aggregate whose members are the fields, in order, can be
+  ///         used instead.
+  /// @param memory - protocol used to access the device.
+  /// @return the fields, or the error of the first burst that failed.
+  template <typename Struct = std::tuple<Fields...>>
+  Returns<Struct> Read(MemoryAccessProtocol & memory) const
+  {
+    if (!is_valid_)
+    {
+      return Error(Status::kOutOfBounds,
+                   "A register in the group is wider than a burst.");
+    }
+
+    std::array<uint8_t, kMaxBurstLength> buffer;
+    std::tuple<Fields...> values;
+
+    for (size_t i = 0; i < burst_count_; i++)
+    {
+      const auto kAddress =
+          ToByteArray<uint32_t, Address_t::AddressWidth()>(
+              endianness, bursts_[i].location);
+      SJ2_RETURN_ON_ERROR(memory.Read(
+          kAddress, std::span(buffer).first(bursts_[i].length)));
+      Decode(values, i, buffer, std::index_sequence_for<Fields...>{});
+    }
+
+    return std::apply([](auto &... fields) { return Struct{ fields... }; },
+                      values);
+  }
+
+ private:
+  /// Location of a register and where it is found in the bursts.
+  struct Field_t
+  {
+    uint32_t location = 0;
+    uint32_t width    = 0;
+    size_t burst      = 0;
+    uint32_t offset   = 0;
+  };
+
+  /// A single auto-incrementing read.
+  struct Burst_t
+  {
+    uint32_t location = 0;
+    uint32_t length   = 0;
+  };
+
+  template <typename T>
+  struct IsIntegerArray : std::false_type
+  {
+  };
+
+  template <typename T, size_t N>
+  struct IsIntegerArray<std::array<T, N>> : std::is_integral<T>
+  {
+  };
+
+  static_assert(
+      ((std::is_integral_v<Fields> || IsIntegerArray<Fields>::value) && ...),
+      "Fields must be integers or std::arrays of integers.");
+
+  template <size_t... kIndex>
+  void Decode(std::tuple<Fields...> & values,
+              size_t burst,
+              std::span<const uint8_t> buffer,
+              std::index_sequence<kIndex...>) const
+  {
+    (DecodeField(std::get<kIndex>(values), fields_[kIndex], burst, buffer),
+     ...);
+  }
+
+  template <typename T>
+  static void DecodeField(T & value,
+                          const Field_t & field,
+                          size_t burst,
+                          std::span<const uint8_t> buffer)
+  {
+    if (field.burst != burst)
+    {
+      return;
+    }
+
+    // Zero extend registers that are narrower than their field
+    const size_t kLength = std::min<size_t>(field.width, sizeof(T));
+    const auto kRegister = buffer.subspan(field.offset, kLength);
+    std::array<uint8_t, sizeof(T)> bytes = {};
+    if (std::is_integral_v<T> && endianness == std::endian::big)
+    {
+      std::copy(kRegister.begin(), kRegister.end(),
+                bytes.end() - kRegister.size());
+    }
+    else
+    {
+      std::copy(kRegister.begin(), kRegister.end(), bytes.begin());
+    }
+
+    if constexpr (std::is_integral_v<T>)
+    {
+      value = ToInteger<T>(endianness, bytes);
+    }
+    else
+    {
+      using Element = typename T::value_type;
+      value = ToIntegerArray<Element, std::tuple_size_v<T>>(endianness, bytes);
+    }
+  }
+
+  std::array<Field_t, kFieldCount> fields_ = {};
+  std::array<Burst_t, kFieldCount> bursts_ = {};
+  size_t burst_count_                      = 0;
+  bool is_valid_                           = true;
+};
+
+/// Make a RegisterGroup of the given registers, which must all be from the
+/// same device.
+///
+/// @tparam Fields - type of each register, see RegisterGroup.
+/// @param first - register holding the first field.
+/// @param rest - registers holding the remaining fields.
+template <typename... Fields,
+          MemoryAccessProtocol::AddressWidth address_width,
+          std::endian endianness,
+          typename... Registers>
+constexpr auto MakeRegisterGroup(
+    const MemoryAccessProtocol::Address<address_width, endianness> & first,
+    const Registers &... rest)
+{
+  static_assert(sizeof...(Fields) == 1 + sizeof...(Registers),
+                "There must be exactly one register per field.");
+  using Group_t = RegisterGroup<address_width, endianness, Fields...>;
+  return Group_t({ first, rest... });
+}
 }  // namespace sjsu
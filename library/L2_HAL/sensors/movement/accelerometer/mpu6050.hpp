@@ -1,17 +1,27 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <span>
 
+#include "L1_Peripheral/gpio.hpp"
 #include "L1_Peripheral/i2c.hpp"
 #include "L2_HAL/sensors/movement/accelerometer.hpp"
 #include "utility/bit.hpp"
+#include "utility/containers/mpsc_queue.hpp"
 #include "utility/enum.hpp"
 #include "utility/map.hpp"
 
 namespace sjsu
 {
 /// Driver for the Mpu6050 3-axis accelerometer
+///
+/// Besides reading single samples with `Read()`, the driver can stream
+/// samples through the device's FIFO, see `EnableStreaming()`.
 class Mpu6050 : public Accelerometer
 {
  public:
@@ -29,6 +39,58 @@ class Mpu6050 : public Accelerometer
 
     /// Control register 1 holds the enable bit
     kControlReg1 = 0x6B,
+
+    /// Divides the sensor output rate down to the sample rate
+    kSampleRateDivider = 0x19,
+
+    /// Holds the digital low pass filter configuration
+    kConfig = 0x1A,
+
+    /// Selects which measurements are written to the FIFO
+    kFifoEnable = 0x23,
+
+    /// Configures the behavior of the INT pin
+    kInterruptPinConfig = 0x37,
+
+    /// Selects which events drive the INT pin
+    kInterruptEnable = 0x38,
+
+    /// Enables and resets the FIFO
+    kUserControl = 0x6A,
+
+    /// First of the two bytes holding the number of bytes in the FIFO
+    kFifoCount = 0x72,
+
+    /// Reading this register pops bytes from the FIFO
+    kFifoData = 0x74,
+  };
+
+  /// Size of the on-chip FIFO in bytes.
+  static constexpr size_t kFifoSize = 1024;
+
+  /// Size of each accelerometer sample in the FIFO in bytes.
+  static constexpr size_t kSampleSize = 6;
+
+  /// Largest number of whole samples the FIFO can hold.
+  static constexpr size_t kFifoSampleCapacity = kFifoSize / kSampleSize;
+
+  /// Rate, in Hz, at which the sensor produces measurements with the digital
+  /// low pass filter enabled. Sample rates are derived from this.
+  static constexpr uint32_t kOutputRate = 1'000;
+
+  /// Counters describing how well a stream is keeping up with the device.
+  struct StreamStatistics_t
+  {
+    /// Samples added to the sample queue.
+    uint32_t samples = 0;
+
+    /// Samples lost because the FIFO overflowed or the sample queue was full.
+    /// Without a data ready pin, samples overwritten in a full FIFO cannot be
+    /// counted, so only the samples discarded with the FIFO are.
+    uint32_t dropped = 0;
+
+    /// Number of times the FIFO overflowed and had to be reset.
+    uint32_t overflows = 0;
   };
 
   ///
@@ -75,47 +137,155 @@ class Mpu6050 : public Accelerometer
 
   Returns<Acceleration_t> Read() override
   {
-    constexpr uint16_t kBytesPerAxis = 2;
-    constexpr uint8_t kNumberOfAxis  = 3;
+    std::array<uint8_t, kSampleSize> xyz_data;
 
-    Acceleration_t acceleration = {};
+    SJ2_RETURN_ON_ERROR(i2c_.WriteThenRead(
+        kAccelerometerAddress, { Value(RegisterMap::kXYZStartAddress) },
+        xyz_data.data(), xyz_data.size()));
 
-    uint8_t xyz_data[kBytesPerAxis * kNumberOfAxis];
+    return ToAcceleration(xyz_data);
+  }
 
-    i2c_.WriteThenRead(kAccelerometerAddress,
-                       { Value(RegisterMap::kXYZStartAddress) }, xyz_data,
-                       sizeof(xyz_data));
+  /// Start collecting samples in the device's FIFO at a fixed rate, so that
+  /// samples are not lost when the task reading them is late. Samples are
+  /// retrieved with `Drain()`. `Enable()` must be called first.
+  ///
+  /// @param sample_rate - rate to sample acceleration at. Must divide 1 kHz by
+  ///        a whole number from 1 to 256.
+  /// @param data_ready - optional GPIO connected to the INT pin. When given,
+  ///        the data ready interrupt counts the samples written to the FIFO,
+  ///        which lets `Drain()` skip the bus when nothing is waiting and
+  ///        count every sample lost to a FIFO overflow.
+  Returns<void> EnableStreaming(units::frequency::hertz_t sample_rate,
+                                sjsu::Gpio * data_ready = nullptr)
+  {
+    const uint32_t kRate = sample_rate.to<uint32_t>();
 
-    // First X-axis Byte (MSB first)
-    // =========================================================================
-    // Bit 7 | Bit 6 | Bit 5 | Bit 4 | Bit 3 | Bit 2 | Bit 1 | Bit 0
-    //  XD15 | XD14  |  XD13 |  XD12 |  XD11 |  XD10 |  XD9  |  XD8
-    //
-    // Final X-axis Byte (LSB)
-    // =========================================================================
-    // Bit 7 | Bit 6 | Bit 5 | Bit 4 | Bit 3 | Bit 2 | Bit 1 | Bit 0
-    //   XD7 |   XD6 |   XD5 |   XD4 |   XD3 |   XD2 |   XD1 |   XD0
-    //
-    // We simply shift and OR the bytes together to get them into a signed int
-    // 16 value.
+    if (kRate == 0 || kRate > kOutputRate || kOutputRate % kRate != 0 ||
+        kOutputRate / kRate > 256)
+    {
+      return Error(Status::kInvalidParameters,
+                   "Sample rate must divide 1 kHz by a value from 1 to 256.");
+    }
 
-    int16_t x = static_cast<int16_t>(xyz_data[0] << 8 | xyz_data[1]);
-    int16_t y = static_cast<int16_t>(xyz_data[2] << 8 | xyz_data[3]);
-    int16_t z = static_cast<int16_t>(xyz_data[4] << 8 | xyz_data[5]);
+    constexpr uint8_t kLowPassFilter184Hz = 0x01;
+    constexpr uint8_t kAccelerometerFifo  = 1 << 3;
+    constexpr uint8_t kDataReadyInterrupt = 1 << 0;
+    const auto kDivider = static_cast<uint8_t>(kOutputRate / kRate - 1);
 
-    // Convert the 16 bit value into a floating point value m/S^2
-    constexpr int16_t kMax = std::numeric_limits<int16_t>::max();
-    constexpr int16_t kMin = std::numeric_limits<int16_t>::min();
+    SJ2_RETURN_ON_ERROR(DisableStreaming());
+    SJ2_RETURN_ON_ERROR(Write(RegisterMap::kConfig, kLowPassFilter184Hz));
+    SJ2_RETURN_ON_ERROR(Write(RegisterMap::kSampleRateDivider, kDivider));
+    SJ2_RETURN_ON_ERROR(Write(RegisterMap::kFifoEnable, kAccelerometerFifo));
 
-    float x_ratio = sjsu::Map(x, kMin, kMax, -1.0f, 1.0f);
-    float y_ratio = sjsu::Map(y, kMin, kMax, -1.0f, 1.0f);
-    float z_ratio = sjsu::Map(z, kMin, kMax, -1.0f, 1.0f);
+    if (data_ready != nullptr)
+    {
+      // Active high, push-pull, with a 50us pulse for each sample.
+      SJ2_RETURN_ON_ERROR(Write(RegisterMap::kInterruptPinConfig, 0x00));
+      data_ready_ = data_ready;
+      data_ready_->SetAsInput();
+      data_ready_->OnRisingEdge([this]() { pending_++; });
+      SJ2_RETURN_ON_ERROR(
+          Write(RegisterMap::kInterruptEnable, kDataReadyInterrupt));
+    }
 
-    acceleration.x = kFullScale * x_ratio;
-    acceleration.y = kFullScale * y_ratio;
-    acceleration.z = kFullScale * z_ratio;
+    statistics_ = {};
+    return ResetFifo();
+  }
 
-    return acceleration;
+  /// Stop collecting samples in the FIFO and release the data ready pin.
+  Returns<void> DisableStreaming()
+  {
+    if (data_ready_ != nullptr)
+    {
+      data_ready_->DetachInterrupt();
+      data_ready_ = nullptr;
+    }
+
+    SJ2_RETURN_ON_ERROR(Write(RegisterMap::kInterruptEnable, 0x00));
+    SJ2_RETURN_ON_ERROR(Write(RegisterMap::kUserControl, 0x00));
+    SJ2_RETURN_ON_ERROR(Write(RegisterMap::kFifoEnable, 0x00));
+    return {};
+  }
+
+  /// Move every sample in the FIFO into `samples`, reading the FIFO with as
+  /// few transactions as possible.
+  ///
+  /// An overflowed FIFO has lost its oldest bytes, so its contents no longer
+  /// line up with sample boundaries. They are discarded and counted as
+  /// dropped.
+  ///
+  /// @tparam kBurstSize - most bytes to read in a single transaction. This
+  ///         much stack is used to hold them, so reduce it for small stacks.
+  /// @param samples - queue to add samples to. Samples that do not fit are
+  ///        counted as dropped.
+  /// @return the number of samples added to `samples`.
+  template <size_t kBurstSize = kFifoSize, size_t kCapacity>
+  Returns<size_t> Drain(MpscQueue<Acceleration_t, kCapacity> & samples)
+  {
+    static_assert(kBurstSize >= kSampleSize,
+                  "Bursts must be able to hold at least one sample.");
+    constexpr size_t kBurstLength = kBurstSize - (kBurstSize % kSampleSize);
+
+    uint32_t produced = 0;
+    if (data_ready_ != nullptr)
+    {
+      produced = pending_.exchange(0);
+      if (produced == 0)
+      {
+        return 0;
+      }
+    }
+
+    std::array<uint8_t, 2> count_bytes;
+    SJ2_RETURN_ON_ERROR(i2c_.WriteThenRead(
+        kAccelerometerAddress, { Value(RegisterMap::kFifoCount) },
+        count_bytes.data(), count_bytes.size()));
+    const size_t kFifoCount = static_cast<size_t>(count_bytes[0] << 8) |
+                              count_bytes[1];
+
+    if (kFifoCount > kFifoSampleCapacity * kSampleSize)
+    {
+      statistics_.overflows++;
+      statistics_.dropped += std::max<uint32_t>(produced, kFifoSampleCapacity);
+      SJ2_RETURN_ON_ERROR(ResetFifo());
+      return 0;
+    }
+
+    std::array<uint8_t, kBurstLength> buffer;
+    size_t remaining = kFifoCount - (kFifoCount % kSampleSize);
+    size_t stored    = 0;
+
+    while (remaining > 0)
+    {
+      const size_t kLength = std::min(remaining, kBurstLength);
+      SJ2_RETURN_ON_ERROR(i2c_.WriteThenRead(kAccelerometerAddress,
+                                             { Value(RegisterMap::kFifoData) },
+                                             buffer.data(), kLength));
+      remaining -= kLength;
+
+      for (size_t i = 0; i < kLength; i += kSampleSize)
+      {
+        std::span<const uint8_t, kSampleSize> sample(&buffer[i], kSampleSize);
+        if (samples.Push(ToAcceleration(sample)))
+        {
+          stored++;
+        }
+        else
+        {
+          statistics_.dropped++;
+        }
+      }
+    }
+
+    statistics_.samples += static_cast<uint32_t>(stored);
+    return stored;
+  }
+
+  /// @return counters for the current stream.
+  StreamStatistics_t GetStreamStatistics() const
+  {
+    return statistics_;
   }
 
   Returns<void> SetFullScaleRange()
@@ -148,9 +318,10 @@ class Mpu6050 : public Accelerometer
 
     // Write in the full scale range; but leave the self test and high pass
     // filter config untouched
-    uint8_t configRegister;
-    i2c_.WriteThenRead(kAccelerometerAddress,
-                       { Value(RegisterMap::kDataConfig) }, &configRegister, 1);
+    uint8_t configRegister = 0;
+    SJ2_RETURN_ON_ERROR(i2c_.WriteThenRead(kAccelerometerAddress,
+                                           { Value(RegisterMap::kDataConfig) },
+                                           &configRegister, 1));
     auto scaleMask = bit::MaskFromRange(3, 4);
     configRegister = bit::Insert(configRegister, gravity_code, scaleMask);
     SJ2_RETURN_ON_ERROR(
@@ -162,10 +333,10 @@ class Mpu6050 : public Accelerometer
 
   Returns<void> ActiveMode(bool is_active = true)
   {
-    uint8_t controlRegister;
-    i2c_.WriteThenRead(kAccelerometerAddress,
-                       { Value(RegisterMap::kDataConfig) }, &controlRegister,
-                       1);
+    uint8_t controlRegister = 0;
+    SJ2_RETURN_ON_ERROR(i2c_.WriteThenRead(kAccelerometerAddress,
+                                           { Value(RegisterMap::kControlReg1) },
+                                           &controlRegister, 1));
     auto sleepMask = bit::MaskFromRange(6);
 
     // !is_active is required as the bit must be set to 0 in order to prevent it
@@ -203,8 +374,64 @@ class Mpu6050 : public Accelerometer
   }
 
  private:
+  Acceleration_t ToAcceleration(
+      std::span<const uint8_t, kSampleSize> xyz_data) const
+  {
+    Acceleration_t acceleration = {};
+
+    // First X-axis Byte (MSB first)
+    // =========================================================================
+    // Bit 7 | Bit 6 | Bit 5 | Bit 4 | Bit 3 | Bit 2 | Bit 1 | Bit 0
+    //  XD15 | XD14  |  XD13 |  XD12 |  XD11 |  XD10 |  XD9  |  XD8
+    //
+    // Final X-axis Byte (LSB)
+    // =========================================================================
+    // Bit 7 | Bit 6 | Bit 5 | Bit 4 | Bit 3 | Bit 2 | Bit 1 | Bit 0
+    //   XD7 |   XD6 |   XD5 |   XD4 |   XD3 |   XD2 |   XD1 |   XD0
+    //
+    // We simply shift and OR the bytes together to get them into a signed int
+    // 16 value.
+
+    int16_t x = static_cast<int16_t>(xyz_data[0] << 8 | xyz_data[1]);
+    int16_t y = static_cast<int16_t>(xyz_data[2] << 8 | xyz_data[3]);
+    int16_t z = static_cast<int16_t>(xyz_data[4] << 8 | xyz_data[5]);
+
+    // Convert the 16 bit value into a floating point value m/S^2
+    constexpr int16_t kMax = std::numeric_limits<int16_t>::max();
+    constexpr int16_t kMin = std::numeric_limits<int16_t>::min();
+
+    float x_ratio = sjsu::Map(x, kMin, kMax, -1.0f, 1.0f);
+    float y_ratio = sjsu::Map(y, kMin, kMax, -1.0f, 1.0f);
+    float z_ratio = sjsu::Map(z, kMin, kMax, -1.0f, 1.0f);
+
+    acceleration.x = kFullScale * x_ratio;
+    acceleration.y = kFullScale * y_ratio;
+    acceleration.z = kFullScale * z_ratio;
+
+    return acceleration;
+  }
+
+  Returns<void> Write(RegisterMap device_register, uint8_t value)
+  {
+    return i2c_.Write(kAccelerometerAddress, { Value(device_register), value });
+  }
+
+  Returns<void> ResetFifo()
+  {
+    constexpr uint8_t kFifoOn    = 1 << 6;
+    constexpr uint8_t kFifoReset = 1 << 2;
+
+    SJ2_RETURN_ON_ERROR(Write(RegisterMap::kUserControl, kFifoReset));
+    SJ2_RETURN_ON_ERROR(Write(RegisterMap::kUserControl, kFifoOn));
+    pending_ = 0;
+    return {};
+  }
+
   const I2c & i2c_;
   const units::acceleration::standard_gravity_t kFullScale;
   const uint8_t kAccelerometerAddress;
+  sjsu::Gpio * data_ready_       = nullptr;
+  std::atomic<uint32_t> pending_ = 0;
+  StreamStatistics_t statistics_ = {};
 };
 }  // namespace sjsu
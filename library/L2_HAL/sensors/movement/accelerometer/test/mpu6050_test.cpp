@@ -0,0 +1,297 @@
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include "L2_HAL/sensors/movement/accelerometer/mpu6050.hpp"
+#include "L4_Testing/testing_frameworks.hpp"
+
+namespace sjsu
+{
+namespace
+{
+/// I2c stand-in that behaves like an MPU6050: register writes are recorded,
+/// and the FIFO count and data registers are backed by a scripted FIFO.
+class FakeMpu6050I2c final : public I2c
+{
+ public:
+  static constexpr uint8_t kFifoCount = 0x72;
+  static constexpr uint8_t kFifoData  = 0x74;
+
+  Returns<void> Initialize() const override
+  {
+    return {};
+  }
+
+  Returns<void> Transaction(Transaction_t transaction) const override
+  {
+    transactions++;
+    const uint8_t kRegister = transaction.data_out[0];
+
+    if (!transaction.repeated)
+    {
+      const uint8_t kValue = transaction.data_out[1];
+      writes.push_back({ kRegister, kValue });
+      registers[kRegister] = kValue;
+      // Writing the FIFO_RESET bit of USER_CTRL empties the FIFO
+      if (kRegister == 0x6A && (kValue & (1 << 2)))
+      {
+        fifo.clear();
+      }
+    }
+    else if (kRegister == failing_register)
+    {
+      return Error(Status::kBusError, "Injected register read failure.");
+    }
+    else if (kRegister == kFifoCount)
+    {
+      transaction.data_in[0] = static_cast<uint8_t>(fifo.size() >> 8);
+      transaction.data_in[1] = static_cast<uint8_t>(fifo.size());
+    }
+    else if (kRegister == kFifoData)
+    {
+      largest_burst = std::max(largest_burst, transaction.in_length);
+      for (size_t i = 0; i < transaction.in_length; i++)
+      {
+        transaction.data_in[i] = fifo.front();
+        fifo.pop_front();
+      }
+    }
+    else
+    {
+      std::copy_n(&registers[kRegister], transaction.in_length,
+                  transaction.data_in);
+    }
+    return {};
+  }
+
+  /// Add a sample to the FIFO, as the device does at each sample period.
+  void PushSample(int16_t x, int16_t y, int16_t z)
+  {
+    for (int16_t axis : { x, y, z })
+    {
+      fifo.push_back(static_cast<uint8_t>(axis >> 8));
+      fifo.push_back(static_cast<uint8_t>(axis));
+    }
+  }
+
+  mutable std::array<uint8_t, 256> registers = {};
+  mutable std::vector<std::pair<uint8_t, uint8_t>> writes;
+  mutable std::deque<uint8_t> fifo;
+  mutable int transactions     = 0;
+  mutable size_t largest_burst = 0;
+  /// Reads of this register fail, as if the device did not respond.
+  int failing_register = -1;
+};
+}  // namespace
+
+TEST_CASE("Testing Mpu6050 FIFO streaming")
+{
+  using RegisterMap = Mpu6050::RegisterMap;
+
+  FakeMpu6050I2c i2c;
+  Mpu6050 test_subject(i2c);
+  MpscQueue<Accelerometer::Acceleration_t, 256> samples;
+
+  SECTION("Enable() does not write back registers it failed to read")
+  {
+    for (auto failing : { RegisterMap::kControlReg1, RegisterMap::kDataConfig })
+    {
+      // Setup
+      i2c.registers[Value(RegisterMap::kWhoAmI)] = 0x68;
+      i2c.failing_register                       = Value(failing);
+      i2c.writes.clear();
+
+      // Exercise
+      auto result = test_subject.Enable();
+
+      // Verify
+      CHECK(!result);
+      for (auto [address, value] : i2c.writes)
+      {
+        CHECK(address != Value(failing));
+      }
+    }
+  }
+
+  SECTION("EnableStreaming() configures the FIFO")
+  {
+    // Exercise
+    CHECK(test_subject.EnableStreaming(200_Hz));
+
+    // Verify
+    CHECK(0x01 == i2c.registers[Value(RegisterMap::kConfig)]);
+    CHECK(4 == i2c.registers[Value(RegisterMap::kSampleRateDivider)]);
+    CHECK(0x08 == i2c.registers[Value(RegisterMap::kFifoEnable)]);
+    CHECK(0x00 == i2c.registers[Value(RegisterMap::kInterruptEnable)]);
+    CHECK(0x40 == i2c.registers[Value(RegisterMap::kUserControl)]);
+    CHECK(std::pair<uint8_t, uint8_t>(0x6A, 0x04) == i2c.writes.end()[-2]);
+  }
+
+  SECTION("EnableStreaming() rejects unreachable sample rates")
+  {
+    for (auto rate : { 0_Hz, 3_Hz, 2_Hz, 300_Hz, 2'000_Hz })
+    {
+      auto result = test_subject.EnableStreaming(rate);
+      CHECK(Status::kInvalidParameters == result.error()->status);
+    }
+    CHECK(test_subject.EnableStreaming(4_Hz));
+    CHECK(test_subject.EnableStreaming(1'000_Hz));
+  }
+
+  SECTION("Drain() reads the whole FIFO in one burst")
+  {
+    // Setup
+    REQUIRE(test_subject.EnableStreaming(1'000_Hz));
+    for (int16_t i = 0; i < 100; i++)
+    {
+      i2c.PushSample(0x4000, i, -0x4000);
+    }
+    i2c.transactions = 0;
+
+    // Exercise
+    auto drained = test_subject.Drain(samples);
+
+    // Verify: one transaction for the count and one for the samples
+    REQUIRE(drained);
+    CHECK(100 == drained.value());
+    CHECK(2 == i2c.transactions);
+    CHECK(600 == i2c.largest_burst);
+    CHECK(100 == samples.Size());
+    CHECK(100 == test_subject.GetStreamStatistics().samples);
+
+    Accelerometer::Acceleration_t sample;
+    REQUIRE(samples.Pop(sample));
+    CHECK(9.807f == doctest::Approx(sample.x.to<float>()).epsilon(0.01));
+    CHECK(-9.807f == doctest::Approx(sample.z.to<float>()).epsilon(0.01));
+  }
+
+  SECTION("Drain() splits reads into kBurstSize bursts")
+  {
+    // Setup
+    REQUIRE(test_subject.EnableStreaming(1'000_Hz));
+    for (int16_t i = 0; i < 100; i++)
+    {
+      i2c.PushSample(i, i, i);
+    }
+    i2c.transactions = 0;
+
+    // Exercise
+    auto drained = test_subject.Drain<64>(samples);
+
+    // Verify: bursts are rounded down to whole samples
+    CHECK(100 == drained.value());
+    CHECK(11 == i2c.transactions);
+    CHECK(60 == i2c.largest_burst);
+  }
+
+  SECTION("Samples that do not fit in the queue are dropped")
+  {
+    // Setup
+    MpscQueue<Accelerometer::Acceleration_t, 16> small_queue;
+    REQUIRE(test_subject.EnableStreaming(1'000_Hz));
+    for (int16_t i = 0; i < 20; i++)
+    {
+      i2c.PushSample(i, i, i);
+    }
+
+    // Exercise
+    auto drained = test_subject.Drain(small_queue);
+
+    // Verify
+    CHECK(16 == drained.value());
+    CHECK(16 == test_subject.GetStreamStatistics().samples);
+    CHECK(4 == test_subject.GetStreamStatistics().dropped);
+    CHECK(i2c.fifo.empty());
+  }
+
+  SECTION("An overflowed FIFO is discarded")
+  {
+    // Setup: the FIFO fills to the last byte and loses sample alignment
+    REQUIRE(test_subject.EnableStreaming(1'000_Hz));
+    i2c.fifo.assign(Mpu6050::kFifoSize, 0x55);
+
+    // Exercise
+    auto drained = test_subject.Drain(samples);
+
+    // Verify
+    CHECK(0 == drained.value());
+    CHECK(i2c.fifo.empty());
+    CHECK(samples.IsEmpty());
+    CHECK(1 == test_subject.GetStreamStatistics().overflows);
+    CHECK(Mpu6050::kFifoSampleCapacity ==
+          test_subject.GetStreamStatistics().dropped);
+  }
+
+  SECTION("Data ready pin")
+  {
+    // Setup
+    InterruptCallback data_ready;
+    Mock<Gpio> mock_pin;
+    Fake(Method(mock_pin, SetDirection));
+    Fake(Method(mock_pin, DetachInterrupt));
+    When(Method(mock_pin, AttachInterrupt))
+        .AlwaysDo([&data_ready](InterruptCallback callback, Gpio::Edge) {
+          data_ready = callback;
+        });
+
+    // Exercise
+    REQUIRE(test_subject.EnableStreaming(500_Hz, &mock_pin.get()));
+
+    // Verify
+    Verify(Method(mock_pin, AttachInterrupt).Using(_, Gpio::Edge::kRising));
+    CHECK(0x01 == i2c.registers[Value(RegisterMap::kInterruptEnable)]);
+
+    SECTION("Drain() skips the bus when no samples are ready")
+    {
+      // Exercise
+      i2c.transactions = 0;
+      auto drained     = test_subject.Drain(samples);
+
+      // Verify
+      CHECK(0 == drained.value());
+      CHECK(0 == i2c.transactions);
+
+      // Exercise
+      for (int16_t i = 0; i < 3; i++)
+      {
+        i2c.PushSample(i, i, i);
+        data_ready();
+      }
+      drained = test_subject.Drain(samples);
+
+      // Verify
+      CHECK(3 == drained.value());
+      CHECK(2 == i2c.transactions);
+    }
+
+    SECTION("Every sample lost to an overflow is counted")
+    {
+      // Setup
+      i2c.fifo.assign(Mpu6050::kFifoSize, 0x55);
+      for (int i = 0; i < 200; i++)
+      {
+        data_ready();
+      }
+
+      // Exercise
+      CHECK(test_subject.Drain(samples));
+
+      // Verify
+      CHECK(200 == test_subject.GetStreamStatistics().dropped);
+    }
+
+    SECTION("DisableStreaming() releases the pin")
+    {
+      // Exercise
+      CHECK(test_subject.DisableStreaming());
+
+      // Verify
+      Verify(Method(mock_pin, DetachInterrupt)).Once();
+      CHECK(0x00 == i2c.registers[Value(RegisterMap::kUserControl)]);
+      CHECK(0x00 == i2c.registers[Value(RegisterMap::kFifoEnable)]);
+    }
+  }
+}
+}  // namespace sjsu
@@ -1,5 +1,7 @@
 #include <numeric>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "L2_HAL/memory_access_protocol.hpp"
 #include "L4_Testing/testing_frameworks.hpp"
@@ -715,6 +717,331 @@ TEST_CASE_TEMPLATE("Testing MemoryAccessProtocol",
     }
   }
 }
+
+TEST_CASE("Testing CachedProtocol")
+{
+  // Setup: an I2C device with a byte addressed register map that counts the
+  // transactions performed on the bus.
+  static constexpr uint8_t kDeviceAddress = 0x68;
+
+  std::array<uint8_t, 256> device_memory = {};
+  int transactions                       = 0;
+
+  Mock<I2c> mock_i2c;
+  When(Method(mock_i2c, Transaction))
+      .AlwaysDo([&](I2c::Transaction_t transaction) -> Returns<void> {
+        transactions++;
+        const uint8_t kRegister = transaction.data_out[0];
+        if (transaction.repeated)
+        {
+          std::copy_n(&device_memory[kRegister], transaction.in_length,
+                      transaction.data_in);
+        }
+        else
+        {
+          std::copy_n(&transaction.data_out[1], transaction.out_length - 1,
+                      &device_memory[kRegister]);
+        }
+        return {};
+      });
+
+  I2cProtocol device(kDeviceAddress, mock_i2c.get());
+  CachedProtocol<3> test_subject(device);
+
+  constexpr MemoryAccessProtocol::Specification_t<
+      MemoryAccessProtocol::AddressWidth::kByte1, std::endian::big>
+      kSpec;
+  static constexpr auto kConfig =
+      MemoryAccessProtocol::Address(kSpec, { .address = 0x1C, .width = 1 });
+  static constexpr auto kPower =
+      MemoryAccessProtocol::Address(kSpec, { .address = 0x6B, .width = 1 });
+  static constexpr auto kStatus =
+      MemoryAccessProtocol::Address(kSpec, { .address = 0x3A, .width = 1 });
+
+  REQUIRE(test_subject.Declare(kConfig, CachePolicy::kWriteThrough));
+  REQUIRE(test_subject.Declare(kPower, CachePolicy::kWriteBack));
+  REQUIRE(test_subject.Declare(kStatus, CachePolicy::kVolatile));
+
+  device_memory[0x1C] = 0x01;
+  device_memory[0x6B] = 0x40;
+  device_memory[0x3A] = 0x05;
+
+  SECTION("Read-modify-write costs one write once cached")
+  {
+    // Exercise: the first access reads the register from the device
+    Returns<uint8_t> config = test_subject[kConfig];
+    REQUIRE(config);
+    const auto kEnabled = static_cast<uint8_t>(config.value() | 0x18);
+    REQUIRE((test_subject[kConfig] = kEnabled));
+
+    // Verify
+    CHECK(2 == transactions);
+    CHECK(0x19 == device_memory[0x1C]);
+
+    // Exercise
+    config = test_subject[kConfig];
+    const auto kDisabled = static_cast<uint8_t>(config.value() & ~0x08);
+    REQUIRE((test_subject[kConfig] = kDisabled));
+
+    // Verify
+    CHECK(3 == transactions);
+    CHECK(0x11 == device_memory[0x1C]);
+  }
+
+  SECTION("Write-back registers are written by Sync()")
+  {
+    // Exercise
+    Returns<uint8_t> power = test_subject[kPower];
+    const auto kAwake = static_cast<uint8_t>(power.value() & ~0x40);
+    REQUIRE((test_subject[kPower] = kAwake));
+    REQUIRE((test_subject[kPower] = static_cast<uint8_t>(kAwake | 0x01)));
+    power = test_subject[kPower];
+
+    // Verify
+    CHECK(1 == transactions);
+    CHECK(0x01 == power.value());
+    CHECK(0x40 == device_memory[0x6B]);
+
+    // Exercise
+    CHECK(test_subject.Sync());
+    CHECK(test_subject.Sync());
+
+    // Verify
+    CHECK(2 == transactions);
+    CHECK(0x01 == device_memory[0x6B]);
+  }
+
+  SECTION("Volatile registers are always read from the device")
+  {
+    // Exercise
+    Returns<uint8_t> first  = test_subject[kStatus];
+    device_memory[0x3A]     = 0x06;
+    Returns<uint8_t> second = test_subject[kStatus];
+
+    // Verify
+    CHECK(2 == transactions);
+    CHECK(0x05 == first.value());
+    CHECK(0x06 == second.value());
+  }
+
+  SECTION("Invalidate() reads registers from the device again")
+  {
+    // Setup
+    Returns<uint8_t> config = test_subject[kConfig];
+    device_memory[0x1C]     = 0x02;
+
+    // Exercise
+    test_subject.Invalidate();
+    config = test_subject[kConfig];
+
+    // Verify
+    CHECK(2 == transactions);
+    CHECK(0x02 == config.value());
+  }
+
+  SECTION("Accesses overlapping cached registers")
+  {
+    // Setup
+    static constexpr auto kBlock =
+        MemoryAccessProtocol::Address(kSpec, { .address = 0x6A, .width = 3 });
+    Returns<uint8_t> power = test_subject[kPower];
+    REQUIRE((test_subject[kPower] = static_cast<uint8_t>(0x03)));
+
+    // Exercise: the dirty register is written before the block is read
+    Returns<std::array<uint8_t, 3>> block = test_subject[kBlock];
+
+    // Verify
+    CHECK(3 == transactions);
+    CHECK(std::array<uint8_t, 3>{ 0x00, 0x03, 0x00 } == block.value());
+
+    // Exercise: writing the block invalidates the cached register
+    const std::array<uint8_t, 3> kBlockValue = { 0x0A, 0x0B, 0x0C };
+    REQUIRE((test_subject[kBlock] = kBlockValue));
+    power = test_subject[kPower];
+
+    // Verify
+    CHECK(5 == transactions);
+    CHECK(0x0B == power.value());
+  }
+
+  SECTION("Declare() limits")
+  {
+    // Setup
+    static constexpr auto kWide =
+        MemoryAccessProtocol::Address(kSpec, { .address = 0x00, .width = 9 });
+    CachedProtocol<1> small_cache(device);
+
+    // Exercise & Verify
+    auto wide = small_cache.Declare(kWide);
+    CHECK(Status::kInvalidParameters == wide.error()->status);
+    CHECK(small_cache.Declare(kConfig));
+    auto full = small_cache.Declare(kPower);
+    CHECK(Status::kOutOfBounds == full.error()->status);
+  }
+}
+
+TEST_CASE("Testing RegisterGroup")
+{
+  // Setup: a device that records each burst read from it
+  class BurstProtocol : public MemoryAccessProtocol
+  {
+   public:
+    Returns<void> Write(std::span<const uint8_t>,
+                        std::span<const uint8_t>) override
+    {
+      return Error(Status::kNotImplemented, "");
+    }
+
+    Returns<void> Read(std::span<const uint8_t> address,
+                       std::span<uint8_t> payload) override
+    {
+      if (fail)
+      {
+        return Error(Status::kBusError, "");
+      }
+      const uint32_t kLocation = ToInteger<uint32_t>(endian, address);
+      bursts.push_back({ kLocation, payload.size() });
+      std::copy_n(&memory[kLocation], payload.size(), payload.begin());
+      return {};
+    }
+
+    std::endian endian = std::endian::big;
+    std::array<uint8_t, 256> memory;
+    std::vector<std::pair<uint32_t, size_t>> bursts;
+    bool fail = false;
+  };
+
+  BurstProtocol device;
+  std::iota(device.memory.begin(), device.memory.end(), 0);
+
+  constexpr MemoryAccessProtocol::Specification_t<
+      MemoryAccessProtocol::AddressWidth::kByte1, std::endian::big>
+      kSpec;
+  static constexpr auto kAccel =
+      MemoryAccessProtocol::Address(kSpec, { .address = 0x3B, .width = 6 });
+  static constexpr auto kTemperature =
+      MemoryAccessProtocol::Address(kSpec, { .address = 0x41, .width = 2 });
+  static constexpr auto kGyro =
+      MemoryAccessProtocol::Address(kSpec, { .address = 0x43, .width = 6 });
+  static constexpr auto kWhoAmI =
+      MemoryAccessProtocol::Address(kSpec, { .address = 0x75, .width = 1 });
+
+  using Axes_t = std::array<int16_t, 3>;
+
+  SECTION("Contiguous registers are read in one burst")
+  {
+    // Setup
+    struct Sample_t
+    {
+      Axes_t acceleration;
+      int16_t temperature;
+      Axes_t rotation;
+    };
+    static constexpr auto kGroup =
+        MakeRegisterGroup<Axes_t, int16_t, Axes_t>(kAccel, kTemperature, kGyro);
+    static_assert(1 == kGroup.GetBurstCount());
+
+    // Exercise
+    Returns<Sample_t> sample = kGroup.Read<Sample_t>(device);
+
+    // Verify
+    REQUIRE(sample);
+    CHECK(Axes_t{ 0x3B3C, 0x3D3E, 0x3F40 } == sample.value().acceleration);
+    CHECK(0x4142 == sample.value().temperature);
+    CHECK(Axes_t{ 0x4344, 0x4546, 0x4748 } == sample.value().rotation);
+    CHECK(decltype(device.bursts){ { 0x3B, 14 } } == device.bursts);
+  }
+
+  SECTION("Small gaps are read through and large gaps start a new burst")
+  {
+    // Setup
+    static constexpr auto kGroup =
+        MakeRegisterGroup<uint8_t, Axes_t, Axes_t>(kWhoAmI, kGyro, kAccel);
+
+    // Exercise
+    auto values = kGroup.Read(device);
+
+    // Verify
+    REQUIRE(values);
+    auto [who_am_i, rotation, acceleration] = values.value();
+    CHECK(0x75 == who_am_i);
+    CHECK(Axes_t{ 0x4344, 0x4546, 0x4748 } == rotation);
+    CHECK(Axes_t{ 0x3B3C, 0x3D3E, 0x3F40 } == acceleration);
+    CHECK(decltype(device.bursts){ { 0x3B, 14 }, { 0x75, 1 } } ==
+          device.bursts);
+  }
+
+  SECTION("Gaps are not read when max_gap is 0")
+  {
+    // Setup
+    static constexpr auto kGroup =
+        RegisterGroup<MemoryAccessProtocol::AddressWidth::kByte1,
+                      std::endian::big, Axes_t, Axes_t>({ kAccel, kGyro }, 0);
+
+    // Exercise & Verify
+    CHECK(kGroup.Read(device));
+    CHECK(decltype(device.bursts){ { 0x3B, 6 }, { 0x43, 6 } } ==
+          device.bursts);
+  }
+
+  SECTION("Bursts are limited to kMaxBurstLength bytes")
+  {
+    // Setup
+    static constexpr auto kFirst =
+        MemoryAccessProtocol::Address(kSpec, { .address = 0x00, .width = 20 });
+    static constexpr auto kSecond =
+        MemoryAccessProtocol::Address(kSpec, { .address = 0x14, .width = 20 });
+    using Block_t = std::array<uint8_t, 20>;
+    static constexpr auto kGroup =
+        MakeRegisterGroup<Block_t, Block_t>(kFirst, kSecond);
+
+    // Exercise
+    auto values = kGroup.Read(device);
+
+    // Verify
+    REQUIRE(values);
+    CHECK(0x14 == std::get<1>(values.value())[0]);
+    CHECK(decltype(device.bursts){ { 0x00, 20 }, { 0x14, 20 } } ==
+          device.bursts);
+  }
+
+  SECTION("Little endian registers narrower than their field")
+  {
+    // Setup
+    constexpr MemoryAccessProtocol::Specification_t<
+        MemoryAccessProtocol::AddressWidth::kByte1, std::endian::little>
+        kLittleSpec;
+    static constexpr auto kPressure = MemoryAccessProtocol::Address(
+        kLittleSpec, { .address = 0x10, .width = 3 });
+    static constexpr auto kGroup = MakeRegisterGroup<uint32_t>(kPressure);
+    device.endian                = std::endian::little;
+
+    // Exercise
+    auto values = kGroup.Read(device);
+
+    // Verify
+    REQUIRE(values);
+    CHECK(0x00'12'11'10 == std::get<0>(values.value()));
+  }
+
+  SECTION("Errors")
+  {
+    // Setup
+    static constexpr auto kWide =
+        MemoryAccessProtocol::Address(kSpec, { .address = 0x00, .width = 33 });
+    static constexpr auto kGroup       = MakeRegisterGroup<uint8_t>(kWide);
+    static constexpr auto kWhoAmIGroup = MakeRegisterGroup<uint8_t>(kWhoAmI);
+
+    // Exercise
+    auto too_wide = kGroup.Read(device);
+    device.fail   = true;
+    auto failed   = kWhoAmIGroup.Read(device);
+
+    // Verify
+    CHECK(Status::kOutOfBounds == too_wide.error()->status);
+    CHECK(Status::kBusError == failed.error()->status);
+  }
+}
 }  // namespace sjsu
 
 TYPE_TO_STRING(decltype(sjsu::MemoryAccessProtocol::Address(sjsu::kSpec1, {})));
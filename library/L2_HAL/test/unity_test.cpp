@@ -13,7 +13,9 @@
 // =============================================================================
 // Communication
 // =============================================================================
-#include "L2_HAL/communication/test/tsop752_test.cpp"  // NOLINT
+#include "L2_HAL/communication/test/tsop752_test.cpp"          // NOLINT
+#include "L2_HAL/communication/test/iso_tp_test.cpp"           // NOLINT
+#include "L2_HAL/communication/test/can_bus_monitor_test.cpp"  // NOLINT
 
 // =============================================================================
 // Displays
@@ -47,6 +49,7 @@
 // Sensor/Movement
 // =============================================================================
 #include "L2_HAL/sensors/movement/accelerometer/test/mma8452q_test.cpp"  // NOLINT
+#include "L2_HAL/sensors/movement/accelerometer/test/mpu6050_test.cpp"  // NOLINT
 
 // =============================================================================
 // Sensor/Distance
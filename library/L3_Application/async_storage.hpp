@@ -0,0 +1,237 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "semphr.h"
+
+#include "L1_Peripheral/storage.hpp"
+#include "L3_Application/task_scheduler.hpp"
+#include "utility/log.hpp"
+#include "utility/status.hpp"
+
+namespace sjsu
+{
+/// Describes a single read, write or erase operation to be performed by an
+/// AsyncStorage worker. The request is owned by the caller and must remain
+/// alive, along with the buffer it refers to, until IsComplete() returns true.
+struct StorageRequest
+{
+  /// The Storage method that this request will invoke.
+  enum class Operation : uint8_t
+  {
+    kRead,
+    kWrite,
+    kErase,
+  };
+
+  /// Called from the storage worker task once the request has been serviced.
+  using Callback = std::function<void(StorageRequest & request)>;
+
+  /// Create a request that reads `size` bytes at `address` into `destination`.
+  static StorageRequest Read(uint32_t address, void * destination, size_t size)
+  {
+    return StorageRequest(Operation::kRead, address, destination, nullptr,
+                          size);
+  }
+
+  /// Create a request that writes `size` bytes from `source` to `address`.
+  static StorageRequest Write(uint32_t address,
+                              const void * source,
+                              size_t size)
+  {
+    return StorageRequest(Operation::kWrite, address, nullptr, source, size);
+  }
+
+  /// Create a request that erases `count` blocks starting at `address`.
+  static StorageRequest Erase(uint32_t address, size_t count)
+  {
+    return StorageRequest(Operation::kErase, address, nullptr, nullptr, count);
+  }
+
+  StorageRequest() = default;
+
+  /// @return true once the storage worker has finished with this request. At
+  ///         that point `result` holds the outcome of the operation and the
+  ///         request may be reused.
+  bool IsComplete() const
+  {
+    return is_complete_.load();
+  }
+
+  /// Operation to perform.
+  Operation operation = Operation::kRead;
+  /// Storage address passed to the Storage method.
+  uint32_t address = 0;
+  /// Buffer filled by a kRead operation.
+  void * destination = nullptr;
+  /// Buffer written by a kWrite operation.
+  const void * source = nullptr;
+  /// Number of bytes for kRead and kWrite, number of blocks for kErase.
+  size_t size = 0;
+  /// Optional function called from the worker task when the request
+  /// completes.
+  Callback callback = nullptr;
+  /// Optional semaphore given by the worker task when the request completes.
+  /// Allows a task to block until the request finishes without polling.
+  SemaphoreHandle_t semaphore = nullptr;
+  /// Result of the operation, valid once IsComplete() returns true.
+  Returns<void> result = {};
+
+ private:
+  template <size_t, size_t>
+  friend class AsyncStorage;
+
+  StorageRequest(Operation request_operation,
+                 uint32_t request_address,
+                 void * request_destination,
+                 const void * request_source,
+                 size_t request_size)
+      : operation(request_operation),
+        address(request_address),
+        destination(request_destination),
+        source(request_source),
+        size(request_size)
+  {
+  }
+
+  std::atomic<bool> is_complete_ = true;
+};
+
+/// Services StorageRequests on behalf of other tasks so that producers, such
+/// as sensor loggers, can keep working while a slow storage device, like an
+/// SD card, is busy. Requests are placed in a bounded queue and are serviced
+/// in order by this task, which is the only task that touches the underlying
+/// Storage. Works with any Storage implementation.
+///
+/// @attention This task inherits from the Task interface and must be persistent
+///            or in global space.
+///
+/// @tparam kQueueDepth - maximum number of requests waiting to be serviced.
+/// @tparam kStackSize  - worker task stack size in bytes.
+template <size_t kQueueDepth, size_t kStackSize = 1024>
+class AsyncStorage final : public rtos::Task<kStackSize>
+{
+ public:
+  /// @param name     - name of the storage worker task.
+  /// @param priority - priority of the storage worker task.
+  /// @param storage  - storage device that requests will be performed on. The
+  ///                   storage device must already be initialized and enabled.
+  AsyncStorage(const char * name, rtos::Priority priority, Storage & storage)
+      : rtos::Task<kStackSize>(name, priority), storage_(storage)
+  {
+    queue_ = xQueueCreateStatic(kQueueDepth, sizeof(StorageRequest *),
+                                queue_storage_, &queue_buffer_);
+    SJ2_ASSERT_FATAL(queue_ != nullptr,
+                     "Error creating storage request queue for task: %s", name);
+  }
+
+  /// Place a request in the queue to be serviced by the worker task. Returns
+  /// immediately after the request is queued.
+  ///
+  /// @param request - request to perform. Must remain alive until
+  ///                  request.IsComplete() returns true.
+  /// @param timeout - amount of time to wait for space in the queue if it is
+  ///                  full.
+  /// @return an error if the request is malformed, already in flight or if
+  ///         the queue remained full for the whole timeout.
+  Returns<void> Submit(StorageRequest & request,
+                       std::chrono::milliseconds timeout = 0ms)
+  {
+    if (!request.IsComplete())
+    {
+      return Error(Status::kInvalidParameters,
+                   "Request has already been submitted.");
+    }
+
+    if ((request.operation == StorageRequest::Operation::kRead &&
+         request.destination == nullptr) ||
+        (request.operation == StorageRequest::Operation::kWrite &&
+         request.source == nullptr))
+    {
+      return Error(Status::kInvalidParameters, "Request buffer is null.");
+    }
+
+    request.is_complete_ = false;
+
+    StorageRequest * request_pointer = &request;
+    const TickType_t kTicksToWait    = static_cast<TickType_t>(
+        (timeout.count() * configTICK_RATE_HZ) / 1000);
+
+    if (xQueueSend(queue_, &request_pointer, kTicksToWait) != pdTRUE)
+    {
+      request.is_complete_ = true;
+      return Error(Status::kTimedOut, "Storage request queue is full.");
+    }
+
+    return {};
+  }
+
+  /// Wait for the next request and service it.
+  ///
+  /// @returns Always returns true.
+  bool Run() override
+  {
+    StorageRequest * request = nullptr;
+    if (xQueueReceive(queue_, &request, portMAX_DELAY) == pdTRUE)
+    {
+      Service(*request);
+    }
+    return true;
+  }
+
+  /// @return the number of requests that have been serviced by this worker.
+  uint32_t GetCompletedCount() const
+  {
+    return completed_count_;
+  }
+
+ private:
+  void Service(StorageRequest & request)
+  {
+    switch (request.operation)
+    {
+      case StorageRequest::Operation::kRead:
+        request.result =
+            storage_.Read(request.address, request.destination, request.size);
+        break;
+      case StorageRequest::Operation::kWrite:
+        request.result =
+            storage_.Write(request.address, request.source, request.size);
+        break;
+      case StorageRequest::Operation::kErase:
+        request.result = storage_.Erase(request.address, request.size);
+        break;
+    }
+
+    completed_count_++;
+
+    if (request.callback)
+    {
+      request.callback(request);
+    }
+
+    // Copy out the semaphore before marking the request as complete, as the
+    // owner is free to reuse or destroy the request after that point.
+    SemaphoreHandle_t semaphore = request.semaphore;
+
+    request.is_complete_ = true;
+
+    if (semaphore != nullptr)
+    {
+      xSemaphoreGive(semaphore);
+    }
+  }
+
+  Storage & storage_;
+  QueueHandle_t queue_;
+  StaticQueue_t queue_buffer_;
+  uint8_t queue_storage_[kQueueDepth * sizeof(StorageRequest *)];
+  uint32_t completed_count_ = 0;
+};
+}  // namespace sjsu
@@ -0,0 +1,372 @@
+// Usage:
+//
+//    sjsu::CanRouter<16> router;
+//    router.Register(0x100, [](const sjsu::Can::Message_t & message) {
+//      sjsu::LogInfo("Throttle: %u", message.payload[0]);
+//    });
+//    // Every diagnostic request from 0x7E0 to 0x7E7
+//    router.RegisterMasked(0x7E0, 0x7F8, DiagnosticHandler);
+//
+//    sjsu::CanRouterTask<16> router_task("CanRouter", sjsu::rtos::kHigh,
+//                                        router, can);
+//
+// Without an RTOS, call router.DispatchPending(can) from the main loop instead
+// of creating a CanRouterTask.
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "L1_Peripheral/can.hpp"
+#include "L3_Application/task_scheduler.hpp"
+#include "utility/delegate.hpp"
+#include "utility/time.hpp"
+#include "utility/units.hpp"
+
+namespace sjsu
+{
+/// Calls a handler for each received CAN message based on its ID, replacing
+/// the usual switch statement over message.id in a receive loop.
+///
+/// Handlers are registered for a single ID or for every ID that matches under
+/// a mask. Single IDs are found with a hash table that is filled as handlers
+/// are registered and kept at most half full, so lookups take a constant
+/// number of probes no matter how many routes exist. Masked routes are only
+/// checked, in the order they were registered, if no single ID route matched.
+///
+/// Each route keeps the number of messages it dispatched, when the last one
+/// was received and the rate messages are received at. A masked route counts
+/// every ID it matches together.
+///
+/// Dispatch() and DispatchPending() must only be called from a single task or
+/// main loop.
+///
+/// @tparam kMaxRoutes - maximum number of single ID and masked routes.
+template <size_t kMaxRoutes>
+class CanRouter
+{
+ public:
+  static_assert(kMaxRoutes > 0 && kMaxRoutes < UINT16_MAX,
+                "CanRouter must hold between 1 and 65534 routes.");
+
+  /// Function called with each message dispatched to a route. See Delegate
+  /// for the limits on what it can capture.
+  using Handler = Delegate<void(const Can::Message_t &)>;
+
+  /// ID format of a CAN message.
+  using Format = Can::Message_t::Format;
+
+  /// Largest standard (11-bit) ID.
+  static constexpr uint32_t kMaxStandardId = 0x7FF;
+  /// Largest extended (29-bit) ID.
+  static constexpr uint32_t kMaxExtendedId = 0x1FFF'FFFF;
+  /// Period that the message rate of each route is measured over.
+  static constexpr std::chrono::nanoseconds kRateWindow = 1s;
+
+  /// Statistics of the messages dispatched to a single route.
+  struct Statistics_t
+  {
+    /// Number of messages dispatched to the route.
+    uint32_t count = 0;
+    /// Uptime when the last message was dispatched to the route.
+    std::chrono::nanoseconds last_seen = std::chrono::nanoseconds(0);
+    /// Messages received per second, measured over the last complete window
+    /// of kRateWindow. Zero until the first window completes.
+    units::frequency::hertz_t rate = 0_Hz;
+  };
+
+  /// Route messages with a single ID to a handler.
+  ///
+  /// @param id - ID of the messages to route.
+  /// @param handler - function to call with each message.
+  /// @param format - ID format of the messages to route.
+  /// @return false if the ID is out of range for the format, already has a
+  ///         route, or there is no room left for another route.
+  bool Register(uint32_t id, Handler handler, Format format = Format::kStandard)
+  {
+    if (!IsValidId(id, format) || route_count_ == kMaxRoutes)
+    {
+      return false;
+    }
+
+    const uint32_t kKey = Key(id, format);
+    size_t slot         = Hash(kKey);
+    while (index_[slot] != kEmptySlot)
+    {
+      if (routes_[index_[slot]].key == kKey)
+      {
+        return false;
+      }
+      slot = (slot + 1) & kTableMask;
+    }
+
+    index_[slot]            = static_cast<uint16_t>(route_count_);
+    routes_[route_count_++] = Route_t{
+      .key     = kKey,
+      .mask    = kExactMask,
+      .handler = handler,
+    };
+    return true;
+  }
+
+  /// Route every message whose ID matches id in the bits set in mask to a
+  /// handler. For example, an id of 0x7E0 and a mask of 0x7F8 routes 0x7E0 to
+  /// 0x7E7. Messages are only routed to a masked route if no single ID route
+  /// matches them, and to the first masked route registered that matches.
+  ///
+  /// @param id - ID to match against.
+  /// @param mask - bits of the ID that must match.
+  /// @param handler - function to call with each message.
+  /// @param format - ID format of the messages to route.
+  /// @return false if the ID is out of range for the format or there is no
+  ///         room left for another route.
+  bool RegisterMasked(uint32_t id,
+                      uint32_t mask,
+                      Handler handler,
+                      Format format = Format::kStandard)
+  {
+    if (!IsValidId(id, format) || route_count_ == kMaxRoutes)
+    {
+      return false;
+    }
+
+    // The format flag is always part of the mask, so that standard and
+    // extended messages never match each other's routes.
+    const uint32_t kMask = mask | kExtendedFlag;
+
+    masked_[masked_count_++] = static_cast<uint16_t>(route_count_);
+    routes_[route_count_++]  = Route_t{
+      .key     = Key(id, format) & kMask,
+      .mask    = kMask,
+      .handler = handler,
+    };
+    return true;
+  }
+
+  /// Call the handler of the route that matches the message's ID.
+  ///
+  /// @param message - received message.
+  /// @return false if no route matched the message.
+  bool Dispatch(const Can::Message_t & message)
+  {
+    size_t index = Find(Key(message.id, message.format));
+    if (index == kNotFound)
+    {
+      unrouted_++;
+      return false;
+    }
+
+    Route_t & route = routes_[index];
+    route.Record(Uptime());
+    route.handler(message);
+    return true;
+  }
+
+  /// Receive and dispatch every message waiting in a CAN peripheral.
+  ///
+  /// @param can - CAN peripheral to receive from.
+  /// @return the number of messages received.
+  size_t DispatchPending(const Can & can)
+  {
+    size_t count = 0;
+    while (can.HasData())
+    {
+      Dispatch(can.Receive());
+      count++;
+    }
+    return count;
+  }
+
+  /// @param id - message ID to look up.
+  /// @param format - ID format of the message.
+  /// @return the statistics of the route that messages with this ID are
+  ///         dispatched to. Every statistic is zero if no route matches.
+  Statistics_t GetStatistics(uint32_t id,
+                             Format format = Format::kStandard) const
+  {
+    size_t index = Find(Key(id, format));
+    if (index == kNotFound)
+    {
+      return {};
+    }
+    return routes_[index].statistics;
+  }
+
+  /// @return the number of messages that did not match any route.
+  uint32_t GetUnroutedCount() const
+  {
+    return unrouted_;
+  }
+
+  /// @return the number of registered routes.
+  size_t GetRouteCount() const
+  {
+    return route_count_;
+  }
+
+ private:
+  /// Number of slots in the hash table. The smallest power of two that keeps
+  /// the table at most half full, so probes always end at an empty slot.
+  static constexpr size_t kTableSize = []() {
+    size_t size = 2;
+    while (size < 2 * kMaxRoutes)
+    {
+      size *= 2;
+    }
+    return size;
+  }();
+  static constexpr size_t kTableMask   = kTableSize - 1;
+  static constexpr uint32_t kHashShift =
+      32 - static_cast<uint32_t>(__builtin_ctzll(kTableSize));
+  static constexpr uint16_t kEmptySlot = UINT16_MAX;
+  static constexpr size_t kNotFound    = kMaxRoutes;
+  /// Set in a key to mark the ID as extended.
+  static constexpr uint32_t kExtendedFlag = 1U << 31;
+  /// Mask of a single ID route, every ID bit and the format flag.
+  static constexpr uint32_t kExactMask = UINT32_MAX;
+
+  /// A handler and the IDs that are dispatched to it.
+  struct Route_t
+  {
+    /// Key of the ID to match, with the bits outside of the mask cleared.
+    uint32_t key;
+    /// Bits of the key that must match.
+    uint32_t mask;
+    /// Function to call with each matching message.
+    Handler handler;
+    /// Statistics of the messages dispatched to this route.
+    Statistics_t statistics = {};
+    /// Start of the window the current rate is being measured over.
+    std::chrono::nanoseconds window_start = std::chrono::nanoseconds(0);
+    /// Number of messages received since the window started.
+    uint32_t window_count = 0;
+
+    /// Update the statistics with a message received at uptime now.
+    void Record(std::chrono::nanoseconds now)
+    {
+      if (statistics.count++ == 0)
+      {
+        window_start = now;
+      }
+      else
+      {
+        window_count++;
+      }
+      statistics.last_seen = now;
+
+      std::chrono::nanoseconds elapsed = now - window_start;
+      if (elapsed >= kRateWindow)
+      {
+        statistics.rate = units::frequency::hertz_t(
+            static_cast<float>(window_count) * 1e9f /
+            static_cast<float>(elapsed.count()));
+        window_start = now;
+        window_count = 0;
+      }
+    }
+  };
+
+  static constexpr bool IsValidId(uint32_t id, Format format)
+  {
+    if (format == Format::kExtended)
+    {
+      return id <= kMaxExtendedId;
+    }
+    return id <= kMaxStandardId;
+  }
+
+  static constexpr uint32_t Key(uint32_t id, Format format)
+  {
+    return (format == Format::kExtended) ? (id | kExtendedFlag) : id;
+  }
+
+  static constexpr size_t Hash(uint32_t key)
+  {
+    // Knuth's multiplicative hash keeps its best mixed bits at the top, which
+    // spreads runs of neighbouring IDs across the table.
+    return static_cast<size_t>((key * 2654435761U) >> kHashShift);
+  }
+
+  /// @return the index of the route that matches the key, or kNotFound.
+  size_t Find(uint32_t key) const
+  {
+    for (size_t slot = Hash(key); index_[slot] != kEmptySlot;
+         slot        = (slot + 1) & kTableMask)
+    {
+      if (routes_[index_[slot]].key == key)
+      {
+        return index_[slot];
+      }
+    }
+
+    for (size_t i = 0; i < masked_count_; i++)
+    {
+      const Route_t & route = routes_[masked_[i]];
+      if ((key & route.mask) == route.key)
+      {
+        return masked_[i];
+      }
+    }
+
+    return kNotFound;
+  }
+
+  static constexpr std::array<uint16_t, kTableSize> MakeEmptyIndex()
+  {
+    std::array<uint16_t, kTableSize> index = {};
+    index.fill(kEmptySlot);
+    return index;
+  }
+
+  std::array<Route_t, kMaxRoutes> routes_ = {};
+  std::array<uint16_t, kTableSize> index_ = MakeEmptyIndex();
+  std::array<uint16_t, kMaxRoutes> masked_ = {};
+  size_t route_count_                      = 0;
+  size_t masked_count_                     = 0;
+  uint32_t unrouted_                       = 0;
+};
+
+/// FreeRTOS task that polls a CAN peripheral and dispatches every received
+/// message through a CanRouter.
+///
+/// @attention This task inherits from the Task interface and must be persistent
+///            or in global space.
+///
+/// @tparam kMaxRoutes - maximum number of routes of the CanRouter to run.
+/// @tparam kStackSize - task stack size in bytes. Must fit the deepest
+///         handler.
+template <size_t kMaxRoutes, size_t kStackSize = 1024>
+class CanRouterTask final : public rtos::Task<kStackSize>
+{
+ public:
+  /// @param name     - name of the task.
+  /// @param priority - priority of the task.
+  /// @param router   - router to dispatch received messages through.
+  /// @param can      - CAN peripheral to receive messages from.
+  /// @param period   - rtos ticks between each poll of the CAN peripheral.
+  CanRouterTask(const char * name,
+                rtos::Priority priority,
+                CanRouter<kMaxRoutes> & router,
+                const Can & can,
+                uint32_t period = 1)
+      : rtos::Task<kStackSize>(name, priority), router_(router), can_(can)
+  {
+    this->SetDelayTime(period);
+  }
+
+  /// Dispatch every message waiting in the CAN peripheral.
+  ///
+  /// @returns Always returns true.
+  bool Run() override
+  {
+    router_.DispatchPending(can_);
+    return true;
+  }
+
+ private:
+  CanRouter<kMaxRoutes> & router_;
+  const Can & can_;
+};
+}  // namespace sjsu
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <cstdio>
+#include <cstring>
+
+#include "L2_HAL/communication/can_bus_monitor.hpp"
+#include "L3_Application/commandline.hpp"
+#include "utility/log.hpp"
+#include "utility/status.hpp"
+
+namespace sjsu
+{
+/// Displays and resets the CanBusMonitors that have been added to it.
+class CanCommand final : public Command
+{
+ public:
+  /// Maximum number of monitors that can be added to the command.
+  static constexpr size_t kMaxMonitors = 4;
+
+  /// CAN usage description and details.
+  static constexpr char kDescription[] = R"(Display CAN bus load and errors.
+                can                     display every bus
+                can <name>              display a single bus
+                can reset [name]        reset every bus or a single one
+  )";
+
+  /// Default constructor of the CAN command
+  constexpr CanCommand() : Command("can", kDescription) {}
+
+  /// Add a bus monitor to be displayed by this command.
+  ///
+  /// @param monitor - monitor to add. Must outlive this command.
+  /// @return an error if kMaxMonitors have already been added.
+  Returns<void> AddMonitor(CanBusMonitor * monitor)
+  {
+    if (monitor_count_ >= monitors_.size())
+    {
+      return Error(Status::kOutOfBounds,
+                   "CAN command cannot hold any more monitors.");
+    }
+    monitors_[monitor_count_++] = monitor;
+    return {};
+  }
+
+  int Program(int argc, const char * const argv[]) override
+  {
+    if (argc > 1 && strcmp(argv[1], "reset") == 0)
+    {
+      const char * name = (argc > 2) ? argv[2] : nullptr;
+      return ForEachMatch(name, [](CanBusMonitor & monitor) {
+        monitor.Reset();
+        printf("Reset %s\n", monitor.GetName());
+      });
+    }
+
+    const char * name = (argc > 1) ? argv[1] : nullptr;
+    return ForEachMatch(name, [](CanBusMonitor & monitor) {
+      monitor.Print();
+    });
+  }
+
+ private:
+  /// Call `action` on every monitor if `name` is nullptr, otherwise only on
+  /// the monitor with a matching name.
+  ///
+  /// @return 1 if a name was given but no monitor has that name, otherwise 0.
+  template <typename Action>
+  int ForEachMatch(const char * name, Action action)
+  {
+    bool found = false;
+    for (size_t i = 0; i < monitor_count_; i++)
+    {
+      if (name == nullptr || strcmp(monitors_[i]->GetName(), name) == 0)
+      {
+        action(*monitors_[i]);
+        found = true;
+      }
+    }
+
+    if (name != nullptr && !found)
+    {
+      LogError("No CAN bus named \"%s\"", name);
+    }
+
+    return (name == nullptr || found) ? 0 : 1;
+  }
+
+  std::array<CanBusMonitor *, kMaxMonitors> monitors_ = {};
+  size_t monitor_count_                               = 0;
+};
+}  // namespace sjsu
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "L1_Peripheral/interrupt.hpp"
+#include "L3_Application/commandline.hpp"
+#include "utility/log.hpp"
+
+namespace sjsu
+{
+/// Controls interrupt profiling and displays how often each interrupt fires
+/// and how long its handler takes.
+class IrqCommand final : public Command
+{
+ public:
+  /// Lowest interrupt request number searched for a profile. Cortex M
+  /// exceptions have negative interrupt request numbers.
+  static constexpr int kLowestIrq = -16;
+  /// Highest interrupt request number searched for a profile.
+  static constexpr int kHighestIrq = 255;
+
+  /// Irq usage description and details.
+  static constexpr char kDescription[] = R"(Profile interrupt handlers.
+                irq                     display every interrupt that has fired
+                irq start               start profiling interrupts
+                irq stop                stop profiling interrupts
+                irq reset               clear every interrupt's profile
+  )";
+
+  /// @param interrupt_controller - the interrupt controller to profile.
+  explicit constexpr IrqCommand(InterruptController & interrupt_controller)
+      : Command("irq", kDescription),
+        interrupt_controller_(interrupt_controller)
+  {
+  }
+
+  int Program(int argc, const char * const argv[]) override
+  {
+    if (argc > 1)
+    {
+      if (strcmp(argv[1], "start") == 0)
+      {
+        interrupt_controller_.EnableProfiling(true);
+        printf("Interrupt profiling started\n");
+      }
+      else if (strcmp(argv[1], "stop") == 0)
+      {
+        interrupt_controller_.EnableProfiling(false);
+        printf("Interrupt profiling stopped\n");
+      }
+      else if (strcmp(argv[1], "reset") == 0)
+      {
+        interrupt_controller_.ResetProfiles();
+        printf("Interrupt profiles cleared\n");
+      }
+      else
+      {
+        LogError("Invalid irq operation \"%s\"", argv[1]);
+        return 1;
+      }
+      return 0;
+    }
+
+    return PrintProfiles();
+  }
+
+ private:
+  /// Print a table of every interrupt that has fired since profiling started.
+  ///
+  /// @return 1 if the platform does not support profiling, otherwise 0.
+  int PrintProfiles()
+  {
+    bool supported = false;
+
+    printf("%5s %10s %14s %10s %10s %8s\n", "irq", "count", "total(cycles)",
+           "mean", "max", "nesting");
+
+    for (int irq = kLowestIrq; irq <= kHighestIrq; irq++)
+    {
+      const InterruptController::Profile_t * profile =
+          interrupt_controller_.GetProfile(irq);
+
+      if (profile == nullptr)
+      {
+        continue;
+      }
+
+      supported = true;
+      if (profile->count == 0)
+      {
+        continue;
+      }
+
+      printf("%5d %10" PRIu32 " %14" PRIu64 " %10" PRIu64 " %10" PRIu32
+             " %8" PRIu32 "\n",
+             irq, profile->count, profile->total_cycles,
+             profile->total_cycles / profile->count, profile->max_cycles,
+             profile->max_nesting);
+    }
+
+    if (!supported)
+    {
+      LogError("This platform cannot profile its interrupts");
+      return 1;
+    }
+
+    return 0;
+  }
+
+  InterruptController & interrupt_controller_;
+};
+}  // namespace sjsu
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <cstdio>
+#include <cstring>
+
+#include "L3_Application/commandline.hpp"
+#include "utility/latency_recorder.hpp"
+#include "utility/log.hpp"
+#include "utility/status.hpp"
+
+namespace sjsu
+{
+/// Displays and resets the LatencyRecorders that have been added to it.
+class LatencyCommand final : public Command
+{
+ public:
+  /// Maximum number of recorders that can be added to the command.
+  static constexpr size_t kMaxRecorders = 16;
+
+  /// Latency usage description and details.
+  static constexpr char kDescription[] = R"(Display latency statistics.
+                latency                 display every recorder
+                latency <name>          display a single recorder
+                latency reset [name]    reset every recorder or a single one
+  )";
+
+  /// Default constructor of the latency command
+  constexpr LatencyCommand() : Command("latency", kDescription) {}
+
+  /// Add a recorder to be displayed by this command.
+  ///
+  /// @param recorder - recorder to add. Must outlive this command.
+  /// @return an error if kMaxRecorders have already been added.
+  Returns<void> AddRecorder(LatencyRecorder * recorder)
+  {
+    if (recorder_count_ >= recorders_.size())
+    {
+      return Error(Status::kOutOfBounds,
+                   "Latency command cannot hold any more recorders.");
+    }
+    recorders_[recorder_count_++] = recorder;
+    return {};
+  }
+
+  int Program(int argc, const char * const argv[]) override
+  {
+    if (argc > 1 && strcmp(argv[1], "reset") == 0)
+    {
+      const char * name = (argc > 2) ? argv[2] : nullptr;
+      return ForEachMatch(name, [](LatencyRecorder & recorder) {
+        recorder.Reset();
+        printf("Reset %s\n", recorder.GetName());
+      });
+    }
+
+    const char * name = (argc > 1) ? argv[1] : nullptr;
+    LatencyRecorder::PrintHeader();
+    return ForEachMatch(name, [](LatencyRecorder & recorder) {
+      recorder.Print();
+    });
+  }
+
+ private:
+  /// Call `action` on every recorder if `name` is nullptr, otherwise only on
+  /// the recorder with a matching name.
+  ///
+  /// @return 1 if a name was given but no recorder has that name, otherwise 0.
+  template <typename Action>
+  int ForEachMatch(const char * name, Action action)
+  {
+    bool found = false;
+    for (size_t i = 0; i < recorder_count_; i++)
+    {
+      if (name == nullptr || strcmp(recorders_[i]->GetName(), name) == 0)
+      {
+        action(*recorders_[i]);
+        found = true;
+      }
+    }
+
+    if (name != nullptr && !found)
+    {
+      LogError("No latency recorder named \"%s\"", name);
+    }
+
+    return (name == nullptr || found) ? 0 : 1;
+  }
+
+  std::array<LatencyRecorder *, kMaxRecorders> recorders_ = {};
+  size_t recorder_count_                                  = 0;
+};
+}  // namespace sjsu
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "L1_Peripheral/sampling_profiler.hpp"
+#include "L3_Application/commandline.hpp"
+#include "utility/log.hpp"
+#include "utility/units.hpp"
+
+namespace sjsu
+{
+/// Controls a sampling profiler and displays the most sampled addresses.
+class ProfileCommand final : public Command
+{
+ public:
+  /// Sample rate used if "profile start" is not given one.
+  static constexpr units::frequency::hertz_t kDefaultSampleRate = 1_kHz;
+  /// Number of addresses displayed if "profile" is not given a count.
+  static constexpr size_t kDefaultCount = 20;
+
+  /// Profile usage description and details.
+  static constexpr char kDescription[] = R"(Sample where the CPU spends its time.
+                profile                 display the 20 most sampled addresses
+                profile <count>         display the most sampled addresses
+                profile start           start sampling 1000 times a second
+                profile start <hz>      start sampling at a given rate
+                profile stop            stop sampling
+                profile clear           discard every sample
+  )";
+
+  /// @param profiler - the sampling profiler to control.
+  explicit constexpr ProfileCommand(SamplingProfiler & profiler)
+      : Command("profile", kDescription), profiler_(profiler)
+  {
+  }
+
+  int Program(int argc, const char * const argv[]) override
+  {
+    if (argc == 1)
+    {
+      PauseSampling();
+      profiler_.GetSamples().Print(kDefaultCount);
+      return ResumeSampling();
+    }
+    else if (strcmp(argv[1], "start") == 0)
+    {
+      return StartProfiler(argc, argv);
+    }
+    else if (strcmp(argv[1], "stop") == 0)
+    {
+      profiler_.Stop();
+      sample_rate_ = 0_Hz;
+      printf("Profiling stopped\n");
+    }
+    else if (strcmp(argv[1], "clear") == 0)
+    {
+      PauseSampling();
+      profiler_.GetSamples().Clear();
+      printf("Profile samples cleared\n");
+      return ResumeSampling();
+    }
+    else
+    {
+      char * end   = nullptr;
+      size_t count = std::strtoul(argv[1], &end, 10);
+      if (*end != '\0' || count == 0)
+      {
+        LogError("Invalid profile operation \"%s\"", argv[1]);
+        return 1;
+      }
+      PauseSampling();
+      profiler_.GetSamples().Print(count);
+      return ResumeSampling();
+    }
+    return 0;
+  }
+
+ private:
+  int StartProfiler(int argc, const char * const argv[])
+  {
+    units::frequency::hertz_t sample_rate = kDefaultSampleRate;
+    if (argc > 2)
+    {
+      char * end     = nullptr;
+      uint32_t hertz = static_cast<uint32_t>(std::strtoul(argv[2], &end, 10));
+      sample_rate    = units::frequency::hertz_t(static_cast<float>(hertz));
+      if (*end != '\0')
+      {
+        LogError("Invalid sample rate \"%s\"", argv[2]);
+        return 1;
+      }
+    }
+
+    Status status = profiler_.Start(sample_rate);
+    if (!IsOk(status))
+    {
+      LogError("Failed to start profiling: %s", status.name.data());
+      return 1;
+    }
+
+    sample_rate_ = sample_rate;
+    printf("Profiling started at %" PRIu32 " Hz\n",
+           sample_rate.to<uint32_t>());
+    return 0;
+  }
+
+  /// The sampling interrupt records into the same table that is printed and
+  /// cleared, so sampling started by this command is stopped around both.
+  void PauseSampling()
+  {
+    if (sample_rate_ != 0_Hz)
+    {
+      profiler_.Stop();
+    }
+  }
+
+  int ResumeSampling()
+  {
+    if (sample_rate_ == 0_Hz)
+    {
+      return 0;
+    }
+
+    Status status = profiler_.Start(sample_rate_);
+    if (!IsOk(status))
+    {
+      sample_rate_ = 0_Hz;
+      LogError("Failed to resume profiling: %s", status.name.data());
+      return 1;
+    }
+    return 0;
+  }
+
+  SamplingProfiler & profiler_;
+  /// Rate this command is sampling at, or 0 Hz if it is not sampling.
+  units::frequency::hertz_t sample_rate_ = 0_Hz;
+};
+}  // namespace sjsu
@@ -0,0 +1,65 @@
+#include "L4_Testing/testing_frameworks.hpp"
+#include "L3_Application/commands/can_command.hpp"
+
+namespace sjsu
+{
+TEST_CASE("Testing CAN Command")
+{
+  Mock<Can> mock_can;
+  Fake(ConstOverloadedMethod(mock_can, Send, void(const Can::Message_t &)));
+  When(Method(mock_can, GetErrorStatistics))
+      .AlwaysReturn(Can::ErrorStatistics_t{});
+
+  CanCommand test_subject;
+  CanBusMonitor can1("can1", mock_can.get());
+  CanBusMonitor can2("can2", mock_can.get());
+
+  REQUIRE(test_subject.AddMonitor(&can1));
+  REQUIRE(test_subject.AddMonitor(&can2));
+  can1.Send(Can::Message_t{ .id = 0x100 });
+  can2.Send(Can::Message_t{ .id = 0x200 });
+
+  SECTION("Display")
+  {
+    const char * const kAll[]    = { "can" };
+    const char * const kSingle[] = { "can", "can1" };
+    const char * const kBogus[]  = { "can", "can3" };
+
+    CHECK(0 == test_subject.Program(1, kAll));
+    CHECK(0 == test_subject.Program(2, kSingle));
+    CHECK(1 == test_subject.Program(2, kBogus));
+  }
+
+  SECTION("Reset a single monitor")
+  {
+    const char * const kArgs[] = { "can", "reset", "can1" };
+
+    CHECK(0 == test_subject.Program(3, kArgs));
+
+    CHECK(0 == can1.GetWindow().frames_sent);
+    CHECK(1 == can2.GetWindow().frames_sent);
+  }
+
+  SECTION("Reset every monitor")
+  {
+    const char * const kArgs[] = { "can", "reset" };
+
+    CHECK(0 == test_subject.Program(2, kArgs));
+
+    CHECK(0 == can1.GetWindow().frames_sent);
+    CHECK(0 == can2.GetWindow().frames_sent);
+  }
+
+  SECTION("Too many monitors")
+  {
+    for (size_t i = 2; i < CanCommand::kMaxMonitors; i++)
+    {
+      CHECK(test_subject.AddMonitor(&can1));
+    }
+
+    auto result = test_subject.AddMonitor(&can1);
+    CHECK(!result);
+    CHECK(result.error()->status == Status::kOutOfBounds);
+  }
+}
+}  // namespace sjsu
@@ -0,0 +1,88 @@
+#include "L4_Testing/testing_frameworks.hpp"
+#include "L3_Application/commands/irq_command.hpp"
+
+namespace sjsu
+{
+TEST_CASE("Testing Irq Command")
+{
+  Mock<InterruptController> mock_interrupt_controller;
+  Fake(Method(mock_interrupt_controller, EnableProfiling));
+  Fake(Method(mock_interrupt_controller, ResetProfiles));
+
+  IrqCommand test_subject(mock_interrupt_controller.get());
+
+  SECTION("start and stop")
+  {
+    // Setup
+    const char * const kStart[] = { "irq", "start" };
+    const char * const kStop[]  = { "irq", "stop" };
+
+    // Exercise & Verify
+    CHECK(0 == test_subject.Program(2, kStart));
+    Verify(Method(mock_interrupt_controller, EnableProfiling).Using(true));
+
+    CHECK(0 == test_subject.Program(2, kStop));
+    Verify(Method(mock_interrupt_controller, EnableProfiling).Using(false));
+  }
+
+  SECTION("reset")
+  {
+    // Setup
+    const char * const kArgs[] = { "irq", "reset" };
+
+    // Exercise & Verify
+    CHECK(0 == test_subject.Program(2, kArgs));
+    Verify(Method(mock_interrupt_controller, ResetProfiles)).Once();
+  }
+
+  SECTION("Invalid operation")
+  {
+    // Setup
+    const char * const kArgs[] = { "irq", "bogus" };
+
+    // Exercise & Verify
+    CHECK(1 == test_subject.Program(2, kArgs));
+  }
+
+  SECTION("Display")
+  {
+    // Setup
+    const char * const kArgs[] = { "irq" };
+    InterruptController::Profile_t profile = {
+      .count        = 4,
+      .max_cycles   = 300,
+      .total_cycles = 1000,
+      .max_nesting  = 2,
+    };
+    InterruptController::Profile_t unused_profile;
+
+    When(Method(mock_interrupt_controller, GetProfile))
+        .AlwaysDo([&](int irq) -> const InterruptController::Profile_t * {
+          if (irq == 5)
+          {
+            return &profile;
+          }
+          if (-16 <= irq && irq < 40)
+          {
+            return &unused_profile;
+          }
+          return nullptr;
+        });
+
+    // Exercise & Verify
+    CHECK(0 == test_subject.Program(1, kArgs));
+    Verify(Method(mock_interrupt_controller, GetProfile)
+               .Using(IrqCommand::kHighestIrq));
+  }
+
+  SECTION("Display on a platform without profiling")
+  {
+    // Setup
+    const char * const kArgs[] = { "irq" };
+    When(Method(mock_interrupt_controller, GetProfile)).AlwaysReturn(nullptr);
+
+    // Exercise & Verify
+    CHECK(1 == test_subject.Program(1, kArgs));
+  }
+}
+}  // namespace sjsu
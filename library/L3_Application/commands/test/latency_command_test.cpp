@@ -0,0 +1,60 @@
+#include "L4_Testing/testing_frameworks.hpp"
+#include "L3_Application/commands/latency_command.hpp"
+
+namespace sjsu
+{
+TEST_CASE("Testing Latency Command")
+{
+  LatencyCommand test_subject;
+  LatencyRecorder spi("spi");
+  LatencyRecorder i2c("i2c");
+
+  REQUIRE(test_subject.AddRecorder(&spi));
+  REQUIRE(test_subject.AddRecorder(&i2c));
+  spi.Record(10us);
+  i2c.Record(20us);
+
+  SECTION("Display")
+  {
+    const char * const kAll[]    = { "latency" };
+    const char * const kSingle[] = { "latency", "spi" };
+    const char * const kBogus[]  = { "latency", "uart" };
+
+    CHECK(0 == test_subject.Program(1, kAll));
+    CHECK(0 == test_subject.Program(2, kSingle));
+    CHECK(1 == test_subject.Program(2, kBogus));
+  }
+
+  SECTION("Reset a single recorder")
+  {
+    const char * const kArgs[] = { "latency", "reset", "spi" };
+
+    CHECK(0 == test_subject.Program(3, kArgs));
+
+    CHECK(0 == spi.GetCount());
+    CHECK(1 == i2c.GetCount());
+  }
+
+  SECTION("Reset every recorder")
+  {
+    const char * const kArgs[] = { "latency", "reset" };
+
+    CHECK(0 == test_subject.Program(2, kArgs));
+
+    CHECK(0 == spi.GetCount());
+    CHECK(0 == i2c.GetCount());
+  }
+
+  SECTION("Too many recorders")
+  {
+    for (size_t i = 2; i < LatencyCommand::kMaxRecorders; i++)
+    {
+      CHECK(test_subject.AddRecorder(&spi));
+    }
+
+    auto result = test_subject.AddRecorder(&spi);
+    CHECK(!result);
+    CHECK(result.error()->status == Status::kOutOfBounds);
+  }
+}
+}  // namespace sjsu
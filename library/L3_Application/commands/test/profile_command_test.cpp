@@ -0,0 +1,139 @@
+#include "L4_Testing/testing_frameworks.hpp"
+#include "L3_Application/commands/profile_command.hpp"
+
+namespace sjsu
+{
+TEST_CASE("Testing Profile Command")
+{
+  Mock<SamplingProfiler> mock_profiler;
+  When(Method(mock_profiler, Start)).AlwaysReturn(Status::kSuccess);
+  Fake(Method(mock_profiler, Stop));
+
+  // The mock's samples are not constructed, so start them out empty.
+  SamplingProfiler & profiler = mock_profiler.get();
+  profiler.GetSamples().Clear();
+  ProfileCommand test_subject(profiler);
+
+  SECTION("start")
+  {
+    // Setup
+    const char * const kDefault[] = { "profile", "start" };
+    const char * const kRate[]    = { "profile", "start", "250" };
+
+    // Exercise & Verify
+    CHECK(0 == test_subject.Program(2, kDefault));
+    CHECK(0 == test_subject.Program(3, kRate));
+    Verify(Method(mock_profiler, Start).Using(1_kHz),
+           Method(mock_profiler, Start).Using(250_Hz));
+  }
+
+  SECTION("start with an invalid sample rate")
+  {
+    // Setup
+    const char * const kArgs[] = { "profile", "start", "fast" };
+
+    // Exercise & Verify
+    CHECK(1 == test_subject.Program(3, kArgs));
+    Verify(Method(mock_profiler, Start)).Never();
+  }
+
+  SECTION("start fails")
+  {
+    // Setup
+    const char * const kArgs[] = { "profile", "start" };
+    When(Method(mock_profiler, Start))
+        .AlwaysReturn(Status::kInvalidParameters);
+
+    // Exercise & Verify
+    CHECK(1 == test_subject.Program(2, kArgs));
+  }
+
+  SECTION("stop")
+  {
+    // Setup
+    const char * const kArgs[] = { "profile", "stop" };
+
+    // Exercise & Verify
+    CHECK(0 == test_subject.Program(2, kArgs));
+    Verify(Method(mock_profiler, Stop)).Once();
+  }
+
+  SECTION("clear")
+  {
+    // Setup
+    const char * const kArgs[] = { "profile", "clear" };
+    profiler.GetSamples().Record(0x1000);
+
+    // Exercise & Verify
+    CHECK(0 == test_subject.Program(2, kArgs));
+    CHECK(0 == profiler.GetSamples().GetTotal());
+  }
+
+  SECTION("Sampling is paused while samples are displayed or cleared")
+  {
+    // Setup
+    const char * const kStart[]   = { "profile", "start", "250" };
+    const char * const kDisplay[] = { "profile" };
+    const char * const kCount[]   = { "profile", "5" };
+    const char * const kClear[]   = { "profile", "clear" };
+    REQUIRE(0 == test_subject.Program(3, kStart));
+    mock_profiler.ClearInvocationHistory();
+
+    // Exercise
+    CHECK(0 == test_subject.Program(1, kDisplay));
+    CHECK(0 == test_subject.Program(2, kCount));
+    CHECK(0 == test_subject.Program(2, kClear));
+
+    // Verify
+    Verify(Method(mock_profiler, Stop),
+           Method(mock_profiler, Start).Using(250_Hz))
+        .Exactly(3);
+  }
+
+  SECTION("Samples are displayed without restarting a stopped profiler")
+  {
+    // Setup
+    const char * const kStart[]   = { "profile", "start" };
+    const char * const kStop[]    = { "profile", "stop" };
+    const char * const kDisplay[] = { "profile" };
+    REQUIRE(0 == test_subject.Program(2, kStart));
+    REQUIRE(0 == test_subject.Program(2, kStop));
+    mock_profiler.ClearInvocationHistory();
+
+    // Exercise
+    CHECK(0 == test_subject.Program(1, kDisplay));
+
+    // Verify
+    Verify(Method(mock_profiler, Start)).Never();
+    Verify(Method(mock_profiler, Stop)).Never();
+  }
+
+  SECTION("Resuming sampling fails")
+  {
+    // Setup
+    const char * const kStart[]   = { "profile", "start" };
+    const char * const kDisplay[] = { "profile" };
+    REQUIRE(0 == test_subject.Program(2, kStart));
+    When(Method(mock_profiler, Start)).AlwaysReturn(Status::kBusError);
+
+    // Exercise & Verify
+    CHECK(1 == test_subject.Program(1, kDisplay));
+    // The failed restart leaves the command no longer sampling.
+    CHECK(0 == test_subject.Program(1, kDisplay));
+  }
+
+  SECTION("Display and invalid operation")
+  {
+    // Setup
+    const char * const kDisplay[] = { "profile" };
+    const char * const kCount[]   = { "profile", "5" };
+    const char * const kBogus[]   = { "profile", "bogus" };
+    profiler.GetSamples().Record(0x1000);
+
+    // Exercise & Verify
+    CHECK(0 == test_subject.Program(1, kDisplay));
+    CHECK(0 == test_subject.Program(2, kCount));
+    CHECK(1 == test_subject.Program(2, kBogus));
+  }
+}
+}  // namespace sjsu
@@ -0,0 +1,61 @@
+#include "L4_Testing/testing_frameworks.hpp"
+#include "L3_Application/commands/trace_command.hpp"
+
+namespace sjsu
+{
+TEST_CASE("Testing Trace Command")
+{
+  trace::SystemRecorder recorder;
+  TraceCommand test_subject(recorder);
+
+  SECTION("start and stop")
+  {
+    // Setup
+    const char * const kStart[] = { "trace", "start" };
+    const char * const kStop[]  = { "trace", "stop" };
+
+    // Exercise & Verify
+    CHECK(0 == test_subject.Program(2, kStart));
+    CHECK(recorder.IsRunning());
+
+    CHECK(0 == test_subject.Program(2, kStop));
+    CHECK(!recorder.IsRunning());
+  }
+
+  SECTION("clear")
+  {
+    // Setup
+    const char * const kArgs[] = { "trace", "clear" };
+    recorder.Start();
+    recorder.Record(trace::Type::kBegin, 0);
+
+    // Exercise & Verify
+    CHECK(0 == test_subject.Program(2, kArgs));
+    CHECK(0 == recorder.Size());
+  }
+
+  SECTION("dump stops the recorder")
+  {
+    // Setup
+    const char * const kArgs[] = { "trace", "dump" };
+    recorder.Start();
+    recorder.Record(trace::Type::kInterruptEnter, 3);
+
+    // Exercise & Verify
+    CHECK(0 == test_subject.Program(2, kArgs));
+    CHECK(!recorder.IsRunning());
+    CHECK(1 == recorder.Size());
+  }
+
+  SECTION("Display and invalid operation")
+  {
+    // Setup
+    const char * const kStatus[] = { "trace" };
+    const char * const kBogus[]  = { "trace", "bogus" };
+
+    // Exercise & Verify
+    CHECK(0 == test_subject.Program(1, kStatus));
+    CHECK(1 == test_subject.Program(2, kBogus));
+  }
+}
+}  // namespace sjsu
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdio>
+#include <cstring>
+
+#include "L3_Application/commandline.hpp"
+#include "config.hpp"
+#include "utility/log.hpp"
+#include "utility/trace_recorder.hpp"
+
+namespace sjsu
+{
+/// Controls the trace recorder and dumps its events for
+/// tools/trace/trace_to_chrome.py.
+class TraceCommand final : public Command
+{
+ public:
+  /// Trace usage description and details.
+  static constexpr char kDescription[] = R"(Record a timeline trace.
+                trace                   display the state of the recorder
+                trace start             start recording events
+                trace stop              stop recording events
+                trace clear             discard every recorded event
+                trace dump              stop recording and print every event
+  )";
+
+  /// @param recorder - the trace recorder to control.
+  explicit constexpr TraceCommand(
+      trace::SystemRecorder & recorder = trace::recorder)
+      : Command("trace", kDescription), recorder_(recorder)
+  {
+  }
+
+  int Program(int argc, const char * const argv[]) override
+  {
+    if constexpr (!config::kEnableTrace)
+    {
+      LogError("Tracing is disabled. Set SJ2_ENABLE_TRACE to true.");
+      return 1;
+    }
+
+    if (argc == 1)
+    {
+      printf("Recorder is %s with %zu events, %zu overwritten\n",
+             recorder_.IsRunning() ? "running" : "stopped", recorder_.Size(),
+             recorder_.GetOverwritten());
+    }
+    else if (strcmp(argv[1], "start") == 0)
+    {
+      recorder_.Start();
+      printf("Trace recording started\n");
+    }
+    else if (strcmp(argv[1], "stop") == 0)
+    {
+      recorder_.Stop();
+      printf("Trace recording stopped\n");
+    }
+    else if (strcmp(argv[1], "clear") == 0)
+    {
+      recorder_.Clear();
+      printf("Trace events cleared\n");
+    }
+    else if (strcmp(argv[1], "dump") == 0)
+    {
+      recorder_.Stop();
+      recorder_.Dump();
+    }
+    else
+    {
+      LogError("Invalid trace operation \"%s\"", argv[1]);
+      return 1;
+    }
+    return 0;
+  }
+
+ private:
+  trace::SystemRecorder & recorder_;
+};
+}  // namespace sjsu
@@ -0,0 +1,417 @@
+#pragma once
+
+#include <ff.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "L3_Application/fatfs.hpp"
+#include "utility/log.hpp"
+#include "utility/status.hpp"
+#include "utility/stopwatch.hpp"
+#include "utility/time.hpp"
+
+namespace sjsu
+{
+/// High throughput, append only logger for streaming records, such as sensor
+/// samples, into files on a FAT filesystem.
+///
+/// Calling f_write() with small buffers causes FatFs to perform partial sector
+/// read-modify-writes and to update the FAT every time the file grows into a
+/// new cluster. DataLogger avoids both:
+///
+///   1. Each log file is preallocated as a single contiguous run of clusters
+///      with f_expand(), so the FAT is not touched while the file is written.
+///   2. Records are packed into one of two RAM buffers. Once a buffer is full
+///      it is handed over to be written while records continue to be packed
+///      into the other buffer. Every write is a whole, sector aligned buffer,
+///      which FatFs passes straight through to the storage device.
+///
+/// Log() only copies data into RAM and never touches the filesystem, which
+/// allows it to be called from a producer task while Service() is called from
+/// a lower priority writer task. Log() and Service() must each only be called
+/// from one task. If the producer fills both buffers before the writer can
+/// write one out, records are dropped and counted in the statistics.
+///
+/// A new file is started when the current file is full or, optionally, when it
+/// has been open for longer than a set period of time. Files are named
+/// `<prefix><5 digit index>.BIN`, and the first unused index is used when the
+/// logger is opened, so existing logs are never overwritten. The files form one
+/// continuous stream of bytes, so a record may be split across two consecutive
+/// files unless the record size evenly divides kBufferSize.
+///
+/// Usage:
+///
+///     sjsu::DataLogger<4096> logger({ .prefix = "IMU" });
+///     logger.Open();
+///     // Producer task
+///     logger.Log(&sample, sizeof(sample));
+///     // Writer task
+///     logger.Service();
+///
+/// @tparam kBufferSize - size of each of the two RAM buffers in bytes. Must be
+///         a multiple of the sector size. Making this equal to the cluster size
+///         of the filesystem gives the best throughput.
+template <size_t kBufferSize = 4096>
+class DataLogger
+{
+ public:
+  static_assert(kBufferSize != 0 && (kBufferSize % FF_MIN_SS) == 0,
+                "Buffer size must be a multiple of the sector size.");
+
+  /// Settings for the data logger
+  struct Settings_t
+  {
+    /// Beginning of each file's path. May include a drive number and directory
+    /// such as "1:/LOG". As long file names are not enabled, the file name
+    /// portion must be 3 characters or fewer.
+    const char * prefix = "LOG";
+    /// Number of bytes preallocated for each file. Once a file is full a new
+    /// file is started. Must be a multiple of kBufferSize.
+    uint32_t file_size = 1024 * 1024;
+    /// Start a new file once a file has been open for this long. Set to 0ns to
+    /// only start new files when the current file is full.
+    std::chrono::nanoseconds roll_period = 0ns;
+  };
+
+  /// Performance and health counters
+  struct Statistics_t
+  {
+    /// Number of bytes written to files.
+    uint64_t bytes_written = 0;
+    /// Number of calls made to f_write().
+    uint32_t writes = 0;
+    /// Number of files that have been created.
+    uint32_t files_created = 0;
+    /// Number of records that were not logged because both buffers were full.
+    uint32_t dropped_records = 0;
+    /// Total amount of time spent in f_write().
+    std::chrono::nanoseconds write_time = 0ns;
+    /// Longest amount of time spent in a single f_write().
+    std::chrono::nanoseconds worst_write_latency = 0ns;
+
+    /// @return the sustained write throughput in bytes per second.
+    float GetThroughput() const
+    {
+      if (write_time == 0ns)
+      {
+        return 0;
+      }
+      std::chrono::duration<float> seconds = write_time;
+      return static_cast<float>(bytes_written) / seconds.count();
+    }
+  };
+
+  /// @param settings - see Settings_t.
+  explicit DataLogger(const Settings_t & settings) : settings_(settings) {}
+
+  /// Create and preallocate the first log file. Must be called after the
+  /// filesystem has been mounted.
+  Returns<void> Open()
+  {
+    if (is_open_)
+    {
+      return Error(Status::kInvalidSettings, "Data logger is already open.");
+    }
+
+    if (settings_.file_size == 0 || (settings_.file_size % kBufferSize) != 0)
+    {
+      return Error(Status::kInvalidSettings,
+                   "File size must be a non-zero multiple of the buffer size.");
+    }
+
+    file_index_ = 0;
+    SJ2_RETURN_ON_ERROR(OpenNextFile());
+    has_file_ = true;
+
+    active_      = 0;
+    fill_        = 0;
+    write_index_ = 0;
+    ready_[0]    = false;
+    ready_[1]    = false;
+    is_open_     = true;
+
+    return {};
+  }
+
+  /// Copy a record into the log buffers. Does not access the filesystem.
+  ///
+  /// @param record - data to log.
+  /// @param size - number of bytes in the record. Records may span buffers
+  ///        but cannot be larger than kBufferSize.
+  /// @return an error if the logger is not open, if the record is too large or
+  ///         if there is no room in the buffers, in which case the record is
+  ///         dropped.
+  Returns<void> Log(const void * record, size_t size)
+  {
+    if (!is_open_)
+    {
+      return Error(Status::kNotReadyYet, "Data logger has not been opened.");
+    }
+
+    if (size > kBufferSize)
+    {
+      return Error(Status::kInvalidParameters,
+                   "Record cannot be larger than the buffer size.");
+    }
+
+    const size_t kOther = active_ ^ 1;
+
+    // The active buffer was handed over when it filled up, move on to the
+    // other buffer as soon as it has been written out.
+    if (fill_ == kBufferSize)
+    {
+      if (ready_[kOther])
+      {
+        statistics_.dropped_records++;
+        return Error(Status::kNotReadyYet,
+                     "Both log buffers are full, record dropped.");
+      }
+      active_ = kOther;
+      fill_   = 0;
+    }
+
+    size_t available = kBufferSize - fill_;
+    if (!ready_[active_ ^ 1])
+    {
+      available += kBufferSize;
+    }
+
+    if (size > available)
+    {
+      statistics_.dropped_records++;
+      return Error(Status::kNotReadyYet,
+                   "Both log buffers are full, record dropped.");
+    }
+
+    const uint8_t * bytes   = reinterpret_cast<const uint8_t *>(record);
+    const size_t kFirstPart = std::min(size, kBufferSize - fill_);
+
+    memcpy(&buffers_[active_][fill_], bytes, kFirstPart);
+    fill_ += kFirstPart;
+
+    if (fill_ == kBufferSize)
+    {
+      ready_[active_] = true;
+
+      if (kFirstPart < size)
+      {
+        active_ ^= 1;
+        memcpy(&buffers_[active_][0], &bytes[kFirstPart], size - kFirstPart);
+        fill_ = size - kFirstPart;
+      }
+    }
+
+    return {};
+  }
+
+  /// Write every full buffer to the log file, starting new files as needed.
+  /// Should be called periodically from the writer task.
+  ///
+  /// If a new file could not be started, an error is returned and the next
+  /// call tries again. Full buffers are kept until they can be written, so the
+  /// producer only starts dropping records once both buffers are full.
+  Returns<void> Service()
+  {
+    if (!is_open_)
+    {
+      return Error(Status::kNotReadyYet, "Data logger has not been opened.");
+    }
+
+    if (!has_file_)
+    {
+      SJ2_RETURN_ON_ERROR(OpenNextFile());
+      has_file_ = true;
+    }
+
+    while (ready_[write_index_])
+    {
+      SJ2_RETURN_ON_ERROR(WriteToFile(buffers_[write_index_].data(),
+                                      kBufferSize));
+      ready_[write_index_] = false;
+      write_index_ ^= 1;
+    }
+
+    return {};
+  }
+
+  /// Write out all buffered records, release the unused preallocated space of
+  /// the current file and close it. The producer must not call Log() while
+  /// the logger is being closed.
+  Returns<void> Close()
+  {
+    SJ2_RETURN_ON_ERROR(Service());
+
+    // A full active buffer has already been written by Service()
+    if (fill_ != 0 && fill_ != kBufferSize)
+    {
+      SJ2_RETURN_ON_ERROR(WriteToFile(buffers_[active_].data(), fill_));
+    }
+
+    is_open_ = false;
+    fill_    = 0;
+
+    has_file_ = false;
+
+    return CloseFile();
+  }
+
+  /// @return true if the logger has been opened and not yet closed.
+  bool IsOpen() const
+  {
+    return is_open_;
+  }
+
+  /// @return the path of the file currently being written to.
+  const char * GetFilePath() const
+  {
+    return path_.data();
+  }
+
+  /// @return performance and health counters for this logger.
+  const Statistics_t & GetStatistics() const
+  {
+    return statistics_;
+  }
+
+ private:
+  Returns<void> OpenNextFile()
+  {
+    static constexpr uint32_t kMaxFileIndex = 99'999;
+
+    FRESULT result = FR_EXIST;
+    for (; file_index_ <= kMaxFileIndex && result == FR_EXIST; file_index_++)
+    {
+      snprintf(path_.data(), path_.size(), "%s%05u.BIN", settings_.prefix,
+               static_cast<unsigned>(file_index_));
+      result = f_open(&file_, path_.data(), FA_WRITE | FA_CREATE_NEW);
+    }
+
+    if (result == FR_EXIST)
+    {
+      return Error(Status::kOutOfBounds, "All log file names are in use.");
+    }
+
+    if (result != FR_OK)
+    {
+      LogDebug("f_open(%s): %s", path_.data(), Stringify(result));
+      return Error(Status::kBusError, "Failed to create log file.");
+    }
+
+    result = f_expand(&file_, settings_.file_size, 1);
+    if (result != FR_OK)
+    {
+      LogDebug("f_expand(%s): %s", path_.data(), Stringify(result));
+      f_close(&file_);
+      f_unlink(path_.data());
+      // Reuse this file name when the next file is created.
+      file_index_--;
+      return Error(Status::kOutOfBounds,
+                   "Not enough contiguous free space to preallocate log file.");
+    }
+
+    file_opened_at_ = Uptime();
+    statistics_.files_created++;
+
+    return {};
+  }
+
+  Returns<void> CloseFile()
+  {
+    // Give back the clusters that were preallocated but never written. The
+    // file is closed even if that fails, so that its size is still saved to
+    // its directory entry and FIL can be reused for the next file.
+    FRESULT result       = f_truncate(&file_);
+    FRESULT close_result = f_close(&file_);
+    if (result == FR_OK)
+    {
+      result = close_result;
+    }
+
+    if (result != FR_OK)
+    {
+      LogDebug("Closing %s: %s", path_.data(), Stringify(result));
+      return Error(Status::kBusError, "Failed to close log file.");
+    }
+
+    return {};
+  }
+
+  bool ShouldRoll(size_t size)
+  {
+    if (f_tell(&file_) + size > settings_.file_size)
+    {
+      return true;
+    }
+
+    return settings_.roll_period != 0ns &&
+           (Uptime() - file_opened_at_) >= settings_.roll_period;
+  }
+
+  Returns<void> WriteToFile(const uint8_t * data, size_t size)
+  {
+    if (!has_file_ || ShouldRoll(size))
+    {
+      // If either step fails there is no file left to write to until a later
+      // call manages to open the next one.
+      if (has_file_)
+      {
+        has_file_ = false;
+        SJ2_RETURN_ON_ERROR(CloseFile());
+      }
+      SJ2_RETURN_ON_ERROR(OpenNextFile());
+      has_file_ = true;
+    }
+
+    UINT bytes_written = 0;
+
+    stopwatch_.Start();
+    FRESULT result = f_write(&file_, data, static_cast<UINT>(size),
+                             &bytes_written);
+    auto latency = stopwatch_.Stop();
+
+    statistics_.writes++;
+    statistics_.bytes_written += bytes_written;
+    statistics_.write_time += latency;
+    statistics_.worst_write_latency =
+        std::max(statistics_.worst_write_latency, latency);
+
+    if (result != FR_OK || bytes_written != size)
+    {
+      LogDebug("f_write(%s): %s", path_.data(), Stringify(result));
+      return Error(Status::kBusError, "Failed to write to log file.");
+    }
+
+    return {};
+  }
+
+  const Settings_t settings_;
+  Statistics_t statistics_;
+  StopWatch stopwatch_;
+  FIL file_ = {};
+  std::array<char, 32> path_ = {};
+  uint32_t file_index_       = 0;
+  std::chrono::nanoseconds file_opened_at_ = 0ns;
+  bool is_open_                            = false;
+
+  // Buffers are aligned for storage devices that use DMA.
+  alignas(4) std::array<std::array<uint8_t, kBufferSize>, 2> buffers_;
+  /// Set by the producer when a buffer is full and cleared by the writer once
+  /// it has been written.
+  std::array<std::atomic<bool>, 2> ready_ = { false, false };
+  /// Owned by the producer
+  size_t active_ = 0;
+  size_t fill_   = 0;
+  /// Owned by the writer
+  size_t write_index_ = 0;
+  /// Owned by the writer. False while no file is open because starting a new
+  /// file failed.
+  bool has_file_ = false;
+};
+}  // namespace sjsu
@@ -0,0 +1,263 @@
+// Usage:
+//
+//    sjsu::DeferredWork<16> deferred_work;
+//    sjsu::DeferredWorkTask<16> deferred_work_task("DeferredWork",
+//                                                  sjsu::rtos::kCritical,
+//                                                  deferred_work);
+//
+//    // Inside of an interrupt service routine:
+//    deferred_work.Post([]() { sjsu::LogInfo("Button pressed!"); });
+//
+// Without an RTOS, call deferred_work.RunPending() from the main loop instead
+// of creating a DeferredWorkTask.
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "L3_Application/task_scheduler.hpp"
+#include "utility/build_info.hpp"
+#include "utility/containers/mpsc_queue.hpp"
+#include "utility/delegate.hpp"
+#include "utility/enum.hpp"
+#include "utility/rtos.hpp"
+
+namespace sjsu
+{
+/// Lets interrupt service routines defer work to task context, so that they
+/// return quickly and stop delaying every other interrupt in the system.
+///
+/// An ISR Post()s a small work item, such as a lambda that captures `this`,
+/// which is later run by a DeferredWorkTask or by a main loop calling
+/// RunPending(). Each priority has its own lock-free queue, so Post() never
+/// blocks or disables interrupts and is safe to call from any interrupt or
+/// task. High priority work always runs before normal priority work.
+///
+/// @tparam kQueueDepth - maximum number of work items waiting at each priority.
+///         Must be a power of two.
+template <size_t kQueueDepth>
+class DeferredWork
+{
+ public:
+  /// A unit of work. See Delegate for the limits on what it can capture.
+  using Work = Delegate<void(void)>;
+
+  /// Order in which posted work is run.
+  enum class Priority : uint8_t
+  {
+    kHigh   = 0,
+    kNormal = 1,
+  };
+
+  /// Number of priority levels.
+  static constexpr size_t kPriorityCount = 2;
+
+  /// Counters describing the use of a single priority's queue.
+  struct Statistics_t
+  {
+    /// Number of work items successfully posted.
+    uint32_t posted = 0;
+    /// Number of work items that have been run.
+    uint32_t executed = 0;
+    /// Number of work items dropped because the queue was full.
+    uint32_t overflows = 0;
+    /// Most work items that have been waiting in the queue at once.
+    uint32_t high_water_mark = 0;
+  };
+
+  /// Queue a work item to be run later in task context. Safe to call from any
+  /// interrupt or task.
+  ///
+  /// @param work - work to run.
+  /// @param priority - priority of the work.
+  /// @return false if the queue for this priority is full and the work was
+  ///         dropped.
+  bool Post(Work work, Priority priority = Priority::kNormal)
+  {
+    Level_t & level = levels_[Value(priority)];
+
+    if (!level.queue.Push(work))
+    {
+      level.overflows.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    level.posted.fetch_add(1, std::memory_order_relaxed);
+
+    uint32_t depth    = static_cast<uint32_t>(level.queue.Size());
+    uint32_t previous = level.high_water_mark.load(std::memory_order_relaxed);
+    // On failure, previous is updated with the latest high water mark.
+    while (depth > previous)
+    {
+      if (level.high_water_mark.compare_exchange_weak(
+              previous, depth, std::memory_order_relaxed))
+      {
+        break;
+      }
+    }
+
+    if (wake_handler_)
+    {
+      wake_handler_();
+    }
+    return true;
+  }
+
+  /// Run every queued work item, including work posted while running. High
+  /// priority work is checked for before each item, so it never waits behind
+  /// more than one normal priority item. Must only be called from a single
+  /// task or main loop.
+  ///
+  /// @return the number of work items that were run.
+  size_t RunPending()
+  {
+    size_t count = 0;
+    Work work;
+
+    while (PopNext(work))
+    {
+      work();
+      count++;
+    }
+
+    return count;
+  }
+
+  /// @return the number of work items waiting to be run.
+  size_t GetPendingCount() const
+  {
+    size_t count = 0;
+    for (const auto & level : levels_)
+    {
+      count += level.queue.Size();
+    }
+    return count;
+  }
+
+  /// @param priority - the priority to get the statistics of.
+  /// @return a snapshot of the statistics of the priority's queue.
+  Statistics_t GetStatistics(Priority priority) const
+  {
+    const Level_t & level = levels_[Value(priority)];
+    return {
+      .posted          = level.posted.load(std::memory_order_relaxed),
+      .executed        = level.executed.load(std::memory_order_relaxed),
+      .overflows       = level.overflows.load(std::memory_order_relaxed),
+      .high_water_mark = level.high_water_mark.load(std::memory_order_relaxed),
+    };
+  }
+
+  /// Clear the statistics of every priority.
+  void ResetStatistics()
+  {
+    for (auto & level : levels_)
+    {
+      level.posted          = 0;
+      level.executed        = 0;
+      level.overflows       = 0;
+      level.high_water_mark = 0;
+    }
+  }
+
+  /// Set a function to be called after each successful Post(), such as one
+  /// that wakes the task that runs the work. Must be set before interrupts
+  /// start posting work, as it is called from interrupt context.
+  ///
+  /// @param wake_handler - function to call.
+  void SetWakeHandler(Delegate<void(void)> wake_handler)
+  {
+    wake_handler_ = wake_handler;
+  }
+
+ private:
+  /// Queue and counters of a single priority.
+  struct Level_t
+  {
+    MpscQueue<Work, kQueueDepth> queue;
+    std::atomic<uint32_t> posted          = 0;
+    std::atomic<uint32_t> executed        = 0;
+    std::atomic<uint32_t> overflows       = 0;
+    std::atomic<uint32_t> high_water_mark = 0;
+  };
+
+  bool PopNext(Work & work)
+  {
+    for (auto & level : levels_)
+    {
+      if (level.queue.Pop(work))
+      {
+        level.executed.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  std::array<Level_t, kPriorityCount> levels_;
+  Delegate<void(void)> wake_handler_ = nullptr;
+};
+
+/// FreeRTOS task that runs the work posted to a DeferredWork object. The task
+/// sleeps until work is posted, so give it a high priority to keep the delay
+/// between an interrupt and its deferred work short.
+///
+/// @attention Waking the task uses the FreeRTOS FromISR API, so interrupts
+///            that post work must have a priority that is allowed to call
+///            FreeRTOS functions (see configMAX_SYSCALL_INTERRUPT_PRIORITY).
+///
+/// @attention This task inherits from the Task interface and must be persistent
+///            or in global space.
+///
+/// @tparam kQueueDepth - queue depth of the DeferredWork object to run.
+/// @tparam kStackSize  - task stack size in bytes. Must fit the deepest work
+///         item.
+template <size_t kQueueDepth, size_t kStackSize = 1024>
+class DeferredWorkTask final : public rtos::Task<kStackSize>
+{
+ public:
+  /// @param name     - name of the task.
+  /// @param priority - priority of the task.
+  /// @param work     - deferred work to run.
+  DeferredWorkTask(const char * name,
+                   rtos::Priority priority,
+                   DeferredWork<kQueueDepth> & work)
+      : rtos::Task<kStackSize>(name, priority), work_(work)
+  {
+    work_.SetWakeHandler([this]() { Wake(); });
+  }
+
+  /// Run all pending work, then sleep until more work is posted.
+  ///
+  /// @returns Always returns true.
+  bool Run() override
+  {
+    work_.RunPending();
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    return true;
+  }
+
+ private:
+  void Wake()
+  {
+    TaskHandle_t handle = *this->GetHandle();
+
+    // Work posted before the scheduler starts is run on the first Run().
+    if (handle == nullptr)
+    {
+      return;
+    }
+
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    vTaskNotifyGiveFromISR(handle, &higher_priority_task_woken);
+
+    if constexpr (!build::IsPlatform(build::Platform::host))
+    {
+      portEND_SWITCHING_ISR(higher_priority_task_woken);
+    }
+  }
+
+  DeferredWork<kQueueDepth> & work_;
+};
+}  // namespace sjsu
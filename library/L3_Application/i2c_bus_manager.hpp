@@ -0,0 +1,573 @@
+// Usage:
+//
+//    sjsu::lpc40xx::I2c i2c2(sjsu::lpc40xx::I2c::Bus::kI2c2);
+//    sjsu::I2cBusManager<8> i2c2_manager(i2c2);
+//
+//    // Give every driver on the bus the manager instead of the peripheral.
+//    sjsu::Mpu6050 accelerometer(i2c2_manager);
+//    sjsu::Tmp102 temperature(i2c2_manager);
+//
+//    // Or queue a transaction without waiting for it.
+//    i2c2_manager.Submit(transaction, on_complete,
+//                        sjsu::I2cBusManager<8>::Priority::kHigh);
+//
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "L1_Peripheral/i2c.hpp"
+#include "utility/enum.hpp"
+#include "utility/log.hpp"
+#include "utility/status.hpp"
+#include "utility/time.hpp"
+
+namespace sjsu
+{
+/// Shares a single I2C bus between every driver and task that uses it.
+///
+/// Transactions are copied into a queue and performed one at a time, highest
+/// priority first and in the order they were submitted within a priority.
+/// When a transaction finishes, the next one is started from the completion
+/// handler of the underlying driver. With an interrupt driven driver, such as
+/// lpc40xx::I2c, queued transactions therefore run back to back from the
+/// interrupt without waiting for a task to be scheduled.
+///
+/// I2cBusManager is itself an I2c, so drivers such as Mpu6050 take it in place
+/// of the peripheral. Transaction() queues the transaction and blocks until it
+/// has finished. TransactionAsync() and Submit() return as soon as the
+/// transaction is queued.
+///
+/// Submitting and completing transactions are lock-free and never disable
+/// interrupts, so every method may be called from any task or interrupt. The
+/// latency and error statistics of each device are updated as transactions
+/// finish and may be slightly out of date when read from another task.
+///
+/// If the underlying driver completes transactions before
+/// TransactionAsync() returns, as the default implementation does, each
+/// queued transaction is started from the completion of the previous one, so
+/// the stack grows with the number of transactions in the queue.
+///
+/// @tparam kQueueDepth - maximum number of queued transactions, including the
+///         transaction on the bus.
+/// @tparam kMaxDevices - maximum number of device addresses to keep statistics
+///         for.
+template <size_t kQueueDepth, size_t kMaxDevices = 8>
+class I2cBusManager final : public I2c
+{
+ public:
+  static_assert(kQueueDepth > 0 && kQueueDepth < UINT8_MAX,
+                "I2cBusManager queue depth must be between 1 and 254.");
+
+  using I2c::Read;
+  using I2c::Write;
+  using I2c::WriteThenRead;
+
+  /// Order in which queued transactions are performed.
+  enum class Priority : uint8_t
+  {
+    kHigh   = 0,
+    kNormal = 1,
+    kLow    = 2,
+  };
+
+  /// Identifies a queued transaction so that it can be withdrawn.
+  struct Ticket_t
+  {
+    /// Index of the queue slot holding the transaction.
+    uint8_t slot;
+    /// Generation of the slot when the transaction was queued.
+    uint32_t generation;
+  };
+
+  /// Statistics of the transactions performed with a single device.
+  struct DeviceStatistics_t
+  {
+    /// 7-bit address of the device.
+    uint8_t address = 0;
+    /// Number of transactions that have finished, including failed ones.
+    uint32_t transactions = 0;
+    /// Number of transactions that finished with an error.
+    uint32_t errors = 0;
+    /// Number of transactions withdrawn from the queue because they did not
+    /// start before their timeout.
+    uint32_t timeouts = 0;
+    /// Status of the last transaction that finished with an error.
+    Status last_error = Status::kSuccess;
+    /// Sum of the time from submission to completion of every transaction.
+    std::chrono::nanoseconds total_latency = 0ns;
+    /// Longest time from submission to completion of any transaction.
+    std::chrono::nanoseconds max_latency = 0ns;
+    /// Sum of the time every transaction spent on the bus.
+    std::chrono::nanoseconds total_bus_time = 0ns;
+  };
+
+  /// @param i2c - bus to manage. Must not be used directly once the manager
+  ///        is in use.
+  explicit I2cBusManager(const I2c & i2c) : i2c_(i2c) {}
+
+  Returns<void> Initialize() const override
+  {
+    return i2c_.Initialize();
+  }
+
+  /// Queue a transaction at normal priority and wait for it to finish.
+  ///
+  /// The transaction's timeout is applied twice: once to the time spent
+  /// waiting in the queue and once to the time spent on the bus. A
+  /// transaction still queued after its timeout is withdrawn. A transaction
+  /// that has not finished within its timeout of starting is cancelled with
+  /// the underlying driver's CancelTransactionAsync(), so that a stuck bus
+  /// does not hold up the rest of the queue. Either way a timeout error is
+  /// returned.
+  Returns<void> Transaction(Transaction_t transaction) const override
+  {
+    struct Result_t
+    {
+      std::atomic<bool> is_complete = false;
+      Status status                 = Status::kSuccess;
+    };
+
+    Result_t result;
+    auto ticket = Submit(transaction, [&result](Status status) {
+      result.status = status;
+      result.is_complete.store(true, std::memory_order_release);
+    });
+    if (!ticket)
+    {
+      return tl::unexpected(ticket.error());
+    }
+
+    auto is_complete = [&result]() {
+      return result.is_complete.load(std::memory_order_acquire);
+    };
+    if (Wait(transaction.timeout, is_complete) == Status::kTimedOut)
+    {
+      if (Withdraw(ticket.value()))
+      {
+        return DefinedError(CommonErrors::kTimeout);
+      }
+      // The transaction started within the last timeout, so waiting for
+      // another gives it at least its timeout on the bus.
+      if (Wait(transaction.timeout, is_complete) == Status::kTimedOut)
+      {
+        Abort(ticket.value());
+      }
+    }
+
+    if (result.status == Status::kSuccess)
+    {
+      return {};
+    }
+    else if (result.status == Status::kDeviceNotFound)
+    {
+      return DefinedError(CommonErrors::kDeviceNotFound);
+    }
+    else if (result.status == Status::kTimedOut)
+    {
+      return DefinedError(CommonErrors::kTimeout);
+    }
+    // Any other failure of the underlying driver.
+    return DefinedError(CommonErrors::kBusError);
+  }
+
+  /// Queue a transaction at normal priority without waiting for it.
+  Returns<void> TransactionAsync(Transaction_t transaction,
+                                 CompletionHandler on_complete) const override
+  {
+    auto ticket = Submit(transaction, on_complete);
+    if (!ticket)
+    {
+      return tl::unexpected(ticket.error());
+    }
+    return {};
+  }
+
+  /// Cancel the transaction on the bus, whichever task queued it, and start
+  /// the next one.
+  bool CancelTransactionAsync() const override
+  {
+    return i2c_.CancelTransactionAsync();
+  }
+
+  /// Queue a transaction without waiting for it.
+  ///
+  /// @param transaction - transaction to perform. Its buffers must remain
+  ///        valid until `on_complete` is called or it is withdrawn.
+  /// @param on_complete - called with the status of the transaction when it
+  ///        has finished. May be called from within an interrupt service
+  ///        routine or from within this call.
+  /// @param priority - priority of the transaction.
+  /// @return a ticket that can be used to withdraw the transaction, or
+  ///         Status::kOutOfBounds if the queue is full.
+  Returns<Ticket_t> Submit(Transaction_t transaction,
+                           CompletionHandler on_complete,
+                           Priority priority = Priority::kNormal) const
+  {
+    for (size_t i = 0; i < slots_.size(); i++)
+    {
+      Slot_t & slot  = slots_[i];
+      uint32_t state = slot.state.load(std::memory_order_relaxed);
+      if (StateOf(state) != State::kFree ||
+          !slot.state.compare_exchange_strong(
+              state, MakeState(GenerationOf(state), State::kFilling),
+              std::memory_order_acquire))
+      {
+        continue;
+      }
+
+      slot.transaction = transaction;
+      slot.on_complete = on_complete;
+      slot.priority    = priority;
+      slot.sequence    = next_sequence_.fetch_add(1);
+      slot.submitted   = Uptime();
+      slot.state.store(MakeState(GenerationOf(state), State::kQueued),
+                       std::memory_order_release);
+
+      const Ticket_t kTicket = { .slot       = static_cast<uint8_t>(i),
+                                 .generation = GenerationOf(state) };
+
+      // Whoever queues a transaction onto an idle bus starts it.
+      if (outstanding_.fetch_add(1, std::memory_order_acq_rel) == 0)
+      {
+        StartNext();
+      }
+      return kTicket;
+    }
+
+    overflows_.fetch_add(1, std::memory_order_relaxed);
+    return Error(Status::kOutOfBounds, "I2C bus manager queue is full.");
+  }
+
+  /// Remove a transaction from the queue if it has not started yet. Its
+  /// completion handler is never called.
+  ///
+  /// @param ticket - ticket returned by Submit().
+  /// @return true if the transaction was withdrawn, false if it has already
+  ///         started or finished.
+  bool Withdraw(Ticket_t ticket) const
+  {
+    Slot_t & slot     = slots_[ticket.slot];
+    uint32_t expected = MakeState(ticket.generation, State::kQueued);
+    if (!slot.state.compare_exchange_strong(
+            expected, MakeState(ticket.generation, State::kWithdrawn),
+            std::memory_order_acq_rel))
+    {
+      return false;
+    }
+    return true;
+  }
+
+  /// @return statistics of the device with `address`, or statistics with a
+  ///         transaction count of 0 if the device has never been used.
+  DeviceStatistics_t GetStatistics(uint8_t address) const
+  {
+    for (size_t i = 0; i < device_count_; i++)
+    {
+      if (devices_[i].address == address)
+      {
+        return devices_[i];
+      }
+    }
+    return DeviceStatistics_t{ .address = address };
+  }
+
+  /// @return statistics of every device that has been used, in the order they
+  ///         were first used.
+  std::span<const DeviceStatistics_t> GetAllStatistics() const
+  {
+    return std::span<const DeviceStatistics_t>(devices_.data(), device_count_);
+  }
+
+  /// @return the number of transactions rejected because the queue was full.
+  uint32_t GetOverflowCount() const
+  {
+    return overflows_.load(std::memory_order_relaxed);
+  }
+
+  /// @return the number of transactions queued or on the bus.
+  size_t GetPendingCount() const
+  {
+    return outstanding_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  /// Life cycle of a queue slot.
+  enum class State : uint32_t
+  {
+    kFree,
+    kFilling,
+    kQueued,
+    kWithdrawn,
+    kActive,
+  };
+
+  /// A transaction waiting in the queue or on the bus.
+  struct Slot_t
+  {
+    /// State in the lower 8 bits and the slot's generation above them. The
+    /// generation is incremented each time the slot is freed, so a stale
+    /// ticket can never withdraw a later transaction in the same slot.
+    std::atomic<uint32_t> state        = MakeState(0, State::kFree);
+    Transaction_t transaction          = {};
+    CompletionHandler on_complete      = nullptr;
+    Priority priority                  = Priority::kNormal;
+    uint32_t sequence                  = 0;
+    std::chrono::nanoseconds submitted = 0ns;
+    std::chrono::nanoseconds started   = 0ns;
+    /// Number of the run on the bus, set when the transaction starts.
+    uint32_t run = 0;
+    /// Set by Abort() while it cancels this slot's run. If the run completes
+    /// in the meantime, Complete() clears it and leaves starting the next
+    /// transaction to Abort(), so that the bus stays idle until Abort() is
+    /// done with the driver.
+    std::atomic<bool> aborting = false;
+  };
+
+  static constexpr uint32_t MakeState(uint32_t generation, State state)
+  {
+    return (generation << 8) | Value(state);
+  }
+
+  static constexpr State StateOf(uint32_t state)
+  {
+    return static_cast<State>(state & 0xFF);
+  }
+
+  static constexpr uint32_t GenerationOf(uint32_t state)
+  {
+    return state >> 8;
+  }
+
+  /// Start the highest priority queued transaction. Only called by the one
+  /// context that owns the bus, which is whoever made outstanding_ non-zero or
+  /// the completion of the previous transaction.
+  void StartNext() const
+  {
+    while (true)
+    {
+      // There is always a queued or withdrawn slot to find, as slots are
+      // queued before outstanding_ is incremented and only leave those states
+      // here.
+      Slot_t & slot  = slots_[FindNext()];
+      uint32_t state = slot.state.load(std::memory_order_acquire);
+      // Set before the slot becomes active, so that Abort() can rely on them
+      // once it sees the active state.
+      slot.run     = runs_started_ + 1;
+      slot.started = Uptime();
+      if (StateOf(state) == State::kQueued &&
+          slot.state.compare_exchange_strong(
+              state, MakeState(GenerationOf(state), State::kActive),
+              std::memory_order_acq_rel))
+      {
+        const uint32_t kRun = ++runs_started_;
+        active_             = &slot;
+        auto result         = i2c_.TransactionAsync(
+            slot.transaction,
+            [this, kRun](Status status) { Complete(kRun, status); });
+        if (!result)
+        {
+          Complete(kRun, result.error()->status);
+        }
+        return;
+      }
+
+      // Withdrawn by its owner, so skip it.
+      RecordTimeout(slot.transaction.address);
+      Free(slot);
+      if (outstanding_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      {
+        return;
+      }
+    }
+  }
+
+  /// @return the index of the queued or withdrawn slot with the highest
+  ///         priority, submitted first.
+  size_t FindNext() const
+  {
+    size_t best = 0;
+    bool found  = false;
+    for (size_t i = 0; i < slots_.size(); i++)
+    {
+      State state = StateOf(slots_[i].state.load(std::memory_order_acquire));
+      if (state != State::kQueued && state != State::kWithdrawn)
+      {
+        continue;
+      }
+
+      const Slot_t & candidate = slots_[i];
+      const Slot_t & current   = slots_[best];
+      // Sequence numbers are compared by their difference so that they can
+      // wrap around.
+      if (!found || candidate.priority < current.priority ||
+          (candidate.priority == current.priority &&
+           static_cast<int32_t>(candidate.sequence - current.sequence) < 0))
+      {
+        best  = i;
+        found = true;
+      }
+    }
+    return best;
+  }
+
+  /// Cancel the active transaction of `ticket`, once its caller has stopped
+  /// waiting for it. Only that transaction is ever cancelled, even if it
+  /// finishes on its own while this runs.
+  void Abort(Ticket_t ticket) const
+  {
+    Slot_t & slot         = slots_[ticket.slot];
+    const uint32_t kState = MakeState(ticket.generation, State::kActive);
+    if (slot.state.load(std::memory_order_acquire) != kState)
+    {
+      return;
+    }
+    // The slot can only be reused after it is freed, which changes its
+    // generation, so checking the state again confirms that the run belongs
+    // to this ticket.
+    const uint32_t kRun = slot.run;
+    if (slot.state.load(std::memory_order_acquire) != kState)
+    {
+      return;
+    }
+
+    // Once the flag is set, a completion of this run no longer starts the
+    // next transaction. So if the run has not completed yet, it is the only
+    // transaction the driver can be working on when it is cancelled.
+    slot.aborting.store(true);
+    if (runs_completed_.load() == kRun - 1)
+    {
+      // A driver that cannot cancel, or that has just finished the
+      // transaction, returns false. Completing the run here is ignored if it
+      // already has.
+      if (!i2c_.CancelTransactionAsync())
+      {
+        Complete(kRun, Status::kTimedOut);
+      }
+    }
+
+    // Complete() cleared the flag, so starting the next transaction was left
+    // to this call.
+    if (!slot.aborting.exchange(false))
+    {
+      ReleaseBus();
+    }
+  }
+
+  /// Called when the active transaction has finished, which is run `run` on
+  /// the bus. Completions of a run that has already finished, such as a
+  /// driver's late completion of a cancelled transaction, are ignored.
+  void Complete(uint32_t run, Status status) const
+  {
+    // Sequentially consistent, along with the accesses to Slot_t::aborting,
+    // so that either Abort() sees this run as completed or this call sees that
+    // the run is being aborted.
+    uint32_t expected = run - 1;
+    if (!runs_completed_.compare_exchange_strong(expected, run))
+    {
+      return;
+    }
+
+    Slot_t & slot = *active_;
+    active_       = nullptr;
+    RecordCompletion(slot, status);
+
+    // Free the slot before calling the handler so that the handler can queue
+    // another transaction into it.
+    CompletionHandler on_complete = slot.on_complete;
+    Free(slot);
+    if (on_complete)
+    {
+      on_complete(status);
+    }
+
+    if (slot.aborting.exchange(false))
+    {
+      return;
+    }
+    ReleaseBus();
+  }
+
+  /// Hand the bus to the next queued transaction, if there is one, once the
+  /// active transaction has completed.
+  void ReleaseBus() const
+  {
+    if (outstanding_.fetch_sub(1, std::memory_order_acq_rel) > 1)
+    {
+      StartNext();
+    }
+  }
+
+  void Free(Slot_t & slot) const
+  {
+    uint32_t state = slot.state.load(std::memory_order_relaxed);
+    slot.state.store(MakeState(GenerationOf(state) + 1, State::kFree),
+                     std::memory_order_release);
+  }
+
+  /// @return statistics of the device, or nullptr if there is no room to keep
+  ///         statistics for another device.
+  DeviceStatistics_t * FindOrAddDevice(uint8_t address) const
+  {
+    for (size_t i = 0; i < device_count_; i++)
+    {
+      if (devices_[i].address == address)
+      {
+        return &devices_[i];
+      }
+    }
+    if (device_count_ >= devices_.size())
+    {
+      return nullptr;
+    }
+    devices_[device_count_] = { .address = address };
+    return &devices_[device_count_++];
+  }
+
+  void RecordCompletion(const Slot_t & slot, Status status) const
+  {
+    DeviceStatistics_t * device = FindOrAddDevice(slot.transaction.address);
+    if (device == nullptr)
+    {
+      return;
+    }
+
+    const std::chrono::nanoseconds kNow     = Uptime();
+    const std::chrono::nanoseconds kLatency = kNow - slot.submitted;
+    device->transactions++;
+    device->total_latency += kLatency;
+    device->max_latency = std::max(device->max_latency, kLatency);
+    device->total_bus_time += kNow - slot.started;
+    if (status != Status::kSuccess)
+    {
+      device->errors++;
+      device->last_error = status;
+    }
+  }
+
+  void RecordTimeout(uint8_t address) const
+  {
+    DeviceStatistics_t * device = FindOrAddDevice(address);
+    if (device != nullptr)
+    {
+      device->timeouts++;
+    }
+  }
+
+  const I2c & i2c_;
+  mutable std::array<Slot_t, kQueueDepth> slots_;
+  mutable std::array<DeviceStatistics_t, kMaxDevices> devices_ = {};
+  mutable size_t device_count_                                 = 0;
+  mutable Slot_t * active_                                     = nullptr;
+  mutable std::atomic<uint32_t> outstanding_                   = 0;
+  mutable std::atomic<uint32_t> next_sequence_                 = 0;
+  mutable std::atomic<uint32_t> overflows_                     = 0;
+  mutable uint32_t runs_started_                               = 0;
+  mutable std::atomic<uint32_t> runs_completed_                = 0;
+};
+}  // namespace sjsu
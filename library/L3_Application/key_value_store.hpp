@@ -0,0 +1,787 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "L1_Peripheral/storage.hpp"
+#include "utility/crc.hpp"
+#include "utility/log.hpp"
+#include "utility/status.hpp"
+
+namespace sjsu
+{
+/// Log structured, wear leveled key/value store built on top of a Storage
+/// device such as the lpc40xx::Eeprom or a NOR flash.
+///
+/// The region of storage given to the store is split into equally sized
+/// sectors that are used as a ring. Records are only ever appended to the
+/// active sector. When the active sector fills up, the next sector in the ring
+/// is erased and opened, and any live records still held in the oldest sector
+/// are copied into it. This spreads erase/program cycles evenly across every
+/// sector of the region.
+///
+/// Calls to Set() and Remove() are staged in a RAM buffer and are written to
+/// storage with a single Write() when Commit() is called. Each batch ends with
+/// a commit record, and a batch whose commit record is not found when the
+/// store is scanned at boot (for example due to a power loss in the middle of
+/// the write) is ignored in its entirety. Staged values are not visible to
+/// Get() until they are committed.
+///
+/// On Initialize(), every sector is scanned and an in-RAM hash index of the
+/// location of each key's latest value is rebuilt, making lookups O(1).
+///
+/// Storage addresses passed to the Storage device are byte addresses, the
+/// convention used by lpc40xx::Eeprom. Reads and writes are always 4-byte
+/// aligned and a multiple of 4 bytes in length.
+///
+/// @tparam kMaxKeys   - maximum number of unique keys that can be stored.
+/// @tparam kBatchSize - size of the RAM buffer used to stage records before
+///                      they are committed. Must be a multiple of 4 bytes.
+template <size_t kMaxKeys, size_t kBatchSize = 128>
+class KeyValueStore
+{
+ public:
+  /// Every read and write to storage is a multiple of this many bytes.
+  static constexpr size_t kAlignment = 4;
+
+  /// Key value reserved to mark empty index slots and commit records.
+  static constexpr uint16_t kInvalidKey = 0xFFFF;
+
+  /// Value written at the start of every sector to signify that it belongs to
+  /// a key/value store. Spells "SJKV" in ASCII.
+  static constexpr uint32_t kMagic = 0x534A'4B56;
+
+  /// Written at the start of every sector.
+  struct SectorHeader_t
+  {
+    /// Must be equal to kMagic for the sector to be considered valid.
+    uint32_t magic;
+    /// Number that increases by one every time a sector is opened. Used to
+    /// determine the order of sectors in the ring.
+    uint32_t sequence;
+  };
+
+  /// Written before every record's data.
+  struct RecordHeader_t
+  {
+    /// Key of this record.
+    uint16_t key;
+    /// Length of the value in bytes, not including padding.
+    uint16_t length;
+    /// Type of record, see RecordType.
+    uint8_t type;
+    /// Reserved, always 0xFF.
+    uint8_t reserved;
+    /// CRC16 of the sector sequence number, the header fields and the value.
+    /// Including the sequence number invalidates stale records left behind in
+    /// storage that does not need to be erased, like EEPROM.
+    uint16_t crc;
+  };
+
+  /// Types of records that can be stored in a sector
+  enum class RecordType : uint8_t
+  {
+    kValue  = 0x5A,
+    kRemove = 0xA5,
+    kCommit = 0x3C,
+  };
+
+  static_assert(sizeof(SectorHeader_t) % kAlignment == 0);
+  static_assert(sizeof(RecordHeader_t) % kAlignment == 0);
+  static_assert(kMaxKeys > 0 && (kMaxKeys & (kMaxKeys - 1)) == 0,
+                "kMaxKeys must be a power of 2.");
+  static_assert(kBatchSize % kAlignment == 0,
+                "Batch size must be a multiple of 4 bytes.");
+  static_assert(kBatchSize >= 2 * sizeof(RecordHeader_t) + kAlignment,
+                "Batch size must be large enough to hold at least a record "
+                "with a 4 byte value and a commit record.");
+
+  /// Largest value that can be stored in the store.
+  static constexpr size_t kMaxValueSize =
+      kBatchSize - (2 * sizeof(RecordHeader_t));
+
+  /// @param storage - storage device to hold the key/value store. Must have
+  ///        been initialized and enabled before calling Initialize().
+  /// @param address - byte address of the start of the region within the
+  ///        storage reserved for the store. Must be a multiple of 4.
+  /// @param sector_size - size of each sector in bytes. Should be a multiple of
+  ///        the storage's erase size and must be a multiple of 4.
+  /// @param sector_count - number of sectors in the region. Must be 2 or more.
+  constexpr KeyValueStore(Storage & storage,
+                          uint32_t address,
+                          uint32_t sector_size,
+                          uint32_t sector_count)
+      : storage_(storage),
+        address_(address),
+        sector_size_(sector_size),
+        sector_count_(sector_count),
+        index_{},
+        batch_{}
+  {
+  }
+
+  /// Scan every sector of the store and rebuild the in-RAM index. If no valid
+  /// sectors are found, the store is considered empty. Must be called before
+  /// any other method.
+  Returns<void> Initialize()
+  {
+    if (sector_count_ < 2 || sector_size_ % kAlignment != 0 ||
+        address_ % kAlignment != 0 ||
+        sector_size_ < kMinimumSectorSize)
+    {
+      return Error(Status::kInvalidSettings,
+                   "Key/value store requires at least 2 sectors that are 4 "
+                   "byte aligned and larger than the batch size.");
+    }
+
+    ClearIndex();
+    batch_length_  = 0;
+    staged_keys_   = 0;
+    sequence_      = 0;
+    active_        = sector_count_ - 1;
+    write_offset_  = sector_size_;
+    bool found_any = false;
+
+    // Find the most recently opened sector, which is the active sector.
+    for (uint32_t sector = 0; sector < sector_count_; sector++)
+    {
+      SectorHeader_t header = SJ2_RETURN_ON_ERROR(ReadSectorHeader(sector));
+      if (header.magic == kMagic && (!found_any || header.sequence > sequence_))
+      {
+        found_any = true;
+        sequence_ = header.sequence;
+        active_   = sector;
+      }
+    }
+
+    if (!found_any)
+    {
+      LogDebug("No key/value store found, starting with an empty store.");
+      return {};
+    }
+
+    // Replay every sector from the oldest (the one after the active sector)
+    // to the newest (the active sector).
+    for (uint32_t i = 1; i <= sector_count_; i++)
+    {
+      uint32_t sector       = (active_ + i) % sector_count_;
+      SectorHeader_t header = SJ2_RETURN_ON_ERROR(ReadSectorHeader(sector));
+      if (header.magic != kMagic)
+      {
+        continue;
+      }
+
+      ScanResult_t scan =
+          SJ2_RETURN_ON_ERROR(ScanSector(sector, header.sequence));
+
+      if (sector != active_)
+      {
+        continue;
+      }
+
+      if (scan.committed_end == sizeof(SectorHeader_t))
+      {
+        // The active sector does not even contain the commit record written
+        // when a sector is opened. This means power was lost while live
+        // records were being moved out of the oldest sector, so open the
+        // sector again to finish the job.
+        active_ = (active_ + sector_count_ - 1) % sector_count_;
+        SJ2_RETURN_ON_ERROR(OpenNextSector());
+      }
+      else if (scan.committed_end != scan.scan_end)
+      {
+        // Records without a commit record were found after the last commit.
+        // They cannot be written over, so close this sector.
+        write_offset_ = sector_size_;
+      }
+      else
+      {
+        write_offset_ = scan.committed_end;
+      }
+    }
+
+    return {};
+  }
+
+  /// Stage a value to be written to storage on the next Commit(). If the
+  /// staging buffer is full, the staged records will be committed first.
+  ///
+  /// @param key - key to associate the value with. Must not be kInvalidKey.
+  /// @param data - pointer to the value.
+  /// @param size - size of the value in bytes. Must be less than or equal to
+  ///               kMaxValueSize.
+  Returns<void> Set(uint16_t key, const void * data, size_t size)
+  {
+    if (key == kInvalidKey || size > kMaxValueSize)
+    {
+      return Error(Status::kInvalidParameters,
+                   "Key is reserved or value is larger than kMaxValueSize.");
+    }
+
+    if (Find(key) == nullptr && key_count_ + staged_keys_ >= kMaxKeys)
+    {
+      return Error(Status::kOutOfBounds,
+                   "Key/value store index is full, increase kMaxKeys.");
+    }
+
+    SJ2_RETURN_ON_ERROR(Stage(key, RecordType::kValue, data, size));
+    staged_keys_++;
+
+    return {};
+  }
+
+  /// Stage the removal of a key to be written to storage on the next Commit().
+  ///
+  /// @param key - key to remove.
+  Returns<void> Remove(uint16_t key)
+  {
+    if (key == kInvalidKey)
+    {
+      return Error(Status::kInvalidParameters, "Key is reserved.");
+    }
+
+    return Stage(key, RecordType::kRemove, nullptr, 0);
+  }
+
+  /// Write every staged record to storage using a single write followed by a
+  /// commit record, then make them visible to Get().
+  Returns<void> Commit()
+  {
+    if (batch_length_ == 0)
+    {
+      return {};
+    }
+
+    // Append the commit record to the end of the batch.
+    RecordHeader_t commit = {
+      .key      = kInvalidKey,
+      .length   = 0,
+      .type     = static_cast<uint8_t>(RecordType::kCommit),
+      .reserved = 0xFF,
+      .crc      = 0,
+    };
+    memcpy(&batch_[batch_length_], &commit, sizeof(commit));
+    size_t total_length = batch_length_ + sizeof(commit);
+
+    // The batch is dropped whether or not it could be written.
+    batch_length_ = 0;
+    staged_keys_  = 0;
+
+    SJ2_RETURN_ON_ERROR(Reserve(total_length));
+
+    // Now that the sector, and thus the sequence number, is known, each
+    // record's CRC can be calculated.
+    for (size_t offset = 0; offset < total_length;)
+    {
+      RecordHeader_t header;
+      memcpy(&header, &batch_[offset], sizeof(header));
+      header.crc =
+          RecordCrc(sequence_, header, batch_.data() + offset + sizeof(header));
+      memcpy(&batch_[offset], &header, sizeof(header));
+      offset += RecordSize(header.length);
+    }
+
+    uint32_t batch_address = SectorAddress(active_) + write_offset_;
+    auto write_result = storage_.Write(batch_address, batch_.data(),
+                                       total_length);
+    if (!write_result)
+    {
+      // Part of the batch may have made it to storage, so nothing else can be
+      // appended to this sector.
+      write_offset_ = sector_size_;
+      return write_result;
+    }
+    write_offset_ += static_cast<uint32_t>(total_length);
+
+    // Apply every record to the index.
+    for (size_t offset = 0; offset < total_length;)
+    {
+      RecordHeader_t header;
+      memcpy(&header, &batch_[offset], sizeof(header));
+      SJ2_RETURN_ON_ERROR(
+          Apply(header, batch_address + static_cast<uint32_t>(offset)));
+      offset += RecordSize(header.length);
+    }
+
+    return {};
+  }
+
+  /// Read the committed value of a key.
+  ///
+  /// @param key - key to read.
+  /// @param data - buffer to hold the value.
+  /// @param size - size of the buffer. If the value is larger than the buffer,
+  ///               only the first size bytes are copied.
+  /// @return the length of the stored value in bytes.
+  Returns<size_t> Get(uint16_t key, void * data, size_t size)
+  {
+    const IndexEntry_t * entry = Find(key);
+    if (entry == nullptr)
+    {
+      return Error(Status::kInvalidParameters, "Key does not exist.");
+    }
+
+    uint8_t * destination = reinterpret_cast<uint8_t *>(data);
+    size_t copy_length    = std::min<size_t>(size, entry->length);
+    uint32_t address      = entry->address + sizeof(RecordHeader_t);
+
+    for (size_t offset = 0; offset < copy_length; offset += kChunkSize)
+    {
+      std::array<uint8_t, kChunkSize> chunk;
+      size_t chunk_length = std::min(kChunkSize, copy_length - offset);
+      SJ2_RETURN_ON_ERROR(storage_.Read(
+          address + static_cast<uint32_t>(offset), chunk.data(),
+          AlignUp(chunk_length)));
+      memcpy(&destination[offset], chunk.data(), chunk_length);
+    }
+
+    return entry->length;
+  }
+
+  /// @param key - key to look for.
+  /// @return true if the key has a committed value.
+  bool Contains(uint16_t key) const
+  {
+    return Find(key) != nullptr;
+  }
+
+  /// @return the number of keys with committed values.
+  size_t GetKeyCount() const
+  {
+    return key_count_;
+  }
+
+  /// @return the index of the sector that records are currently appended to.
+  uint32_t GetActiveSector() const
+  {
+    return active_;
+  }
+
+ private:
+  /// Location of the latest record of a key.
+  struct IndexEntry_t
+  {
+    uint16_t key = kInvalidKey;
+    uint16_t length;
+    uint32_t address;
+  };
+
+  /// Result of scanning a sector's records.
+  struct ScanResult_t
+  {
+    /// Offset just past the last commit record in the sector.
+    uint32_t committed_end;
+    /// Offset just past the last valid record in the sector.
+    uint32_t scan_end;
+  };
+
+  /// Number of index slots. Twice the number of keys to keep probe sequences
+  /// short.
+  static constexpr size_t kIndexSize = kMaxKeys * 2;
+
+  /// A sector must be able to hold its header, the commit record written when
+  /// it is opened and a full batch.
+  static constexpr size_t kMinimumSectorSize =
+      sizeof(SectorHeader_t) + sizeof(RecordHeader_t) + kBatchSize;
+
+  /// Size of the stack buffer used to stream record data from storage.
+  static constexpr size_t kChunkSize = 32;
+
+  static constexpr crc::CrcTableConfig_t<uint16_t> kCrcTable16 =
+      crc::GenerateCrc16Table();
+
+  static constexpr size_t AlignUp(size_t size)
+  {
+    return (size + kAlignment - 1) & ~(kAlignment - 1);
+  }
+
+  static constexpr uint32_t RecordSize(uint16_t length)
+  {
+    return static_cast<uint32_t>(sizeof(RecordHeader_t) + AlignUp(length));
+  }
+
+  static uint16_t Crc16(uint16_t crc, const void * data, size_t size)
+  {
+    const uint8_t * bytes = reinterpret_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; i++)
+    {
+      crc = static_cast<uint16_t>(
+          kCrcTable16.crc_table[((crc >> 8) ^ bytes[i]) & 0xFF] ^ (crc << 8));
+    }
+    return crc;
+  }
+
+  /// CRC of the header fields that precede the CRC field itself.
+  static uint16_t HeaderCrc(uint32_t sequence, const RecordHeader_t & header)
+  {
+    uint16_t crc = Crc16(0, &sequence, sizeof(sequence));
+    return Crc16(crc, &header, offsetof(RecordHeader_t, crc));
+  }
+
+  static uint16_t RecordCrc(uint32_t sequence,
+                            const RecordHeader_t & header,
+                            const uint8_t * data)
+  {
+    return Crc16(HeaderCrc(sequence, header), data, header.length);
+  }
+
+  /// Same as RecordCrc(), but streams the record's data from storage.
+  Returns<uint16_t> RecordCrcFromStorage(uint32_t sequence,
+                                         const RecordHeader_t & header,
+                                         uint32_t data_address)
+  {
+    uint16_t crc = HeaderCrc(sequence, header);
+    for (size_t offset = 0; offset < header.length; offset += kChunkSize)
+    {
+      std::array<uint8_t, kChunkSize> chunk;
+      size_t chunk_length = std::min<size_t>(kChunkSize, header.length - offset);
+      SJ2_RETURN_ON_ERROR(storage_.Read(
+          data_address + static_cast<uint32_t>(offset), chunk.data(),
+          AlignUp(chunk_length)));
+      crc = Crc16(crc, chunk.data(), chunk_length);
+    }
+    return crc;
+  }
+
+  uint32_t SectorAddress(uint32_t sector) const
+  {
+    return address_ + (sector * sector_size_);
+  }
+
+  bool IsInSector(uint32_t address, uint32_t sector) const
+  {
+    return SectorAddress(sector) <= address &&
+           address < SectorAddress(sector) + sector_size_;
+  }
+
+  Returns<SectorHeader_t> ReadSectorHeader(uint32_t sector)
+  {
+    SectorHeader_t header;
+    SJ2_RETURN_ON_ERROR(
+        storage_.Read(SectorAddress(sector), &header, sizeof(header)));
+    return header;
+  }
+
+  /// Walk the records of a sector until an invalid record is found, then
+  /// apply every record that precedes the last commit record to the index.
+  ///
+  /// @param sector - sector to scan.
+  /// @param sequence - sequence number of the sector.
+  Returns<ScanResult_t> ScanSector(uint32_t sector, uint32_t sequence)
+  {
+    ScanResult_t result = {
+      .committed_end = sizeof(SectorHeader_t),
+      .scan_end      = sizeof(SectorHeader_t),
+    };
+
+    uint32_t offset = sizeof(SectorHeader_t);
+    while (offset + sizeof(RecordHeader_t) <= sector_size_)
+    {
+      uint32_t address = SectorAddress(sector) + offset;
+      RecordHeader_t header;
+      SJ2_RETURN_ON_ERROR(storage_.Read(address, &header, sizeof(header)));
+
+      bool is_known_type =
+          header.type == static_cast<uint8_t>(RecordType::kValue) ||
+          header.type == static_cast<uint8_t>(RecordType::kRemove) ||
+          header.type == static_cast<uint8_t>(RecordType::kCommit);
+
+      if (!is_known_type || header.length > kMaxValueSize ||
+          offset + RecordSize(header.length) > sector_size_)
+      {
+        break;
+      }
+
+      uint16_t crc = SJ2_RETURN_ON_ERROR(RecordCrcFromStorage(
+          sequence, header, address + sizeof(RecordHeader_t)));
+      if (crc != header.crc)
+      {
+        break;
+      }
+
+      offset += RecordSize(header.length);
+      result.scan_end = offset;
+
+      if (header.type == static_cast<uint8_t>(RecordType::kCommit))
+      {
+        result.committed_end = offset;
+      }
+    }
+
+    // Apply every record before the last commit record.
+    offset = sizeof(SectorHeader_t);
+    while (offset < result.committed_end)
+    {
+      uint32_t address = SectorAddress(sector) + offset;
+      RecordHeader_t header;
+      SJ2_RETURN_ON_ERROR(storage_.Read(address, &header, sizeof(header)));
+      SJ2_RETURN_ON_ERROR(Apply(header, address));
+      offset += RecordSize(header.length);
+    }
+
+    return result;
+  }
+
+  /// Update the index using a committed record.
+  Returns<void> Apply(const RecordHeader_t & header, uint32_t address)
+  {
+    switch (static_cast<RecordType>(header.type))
+    {
+      case RecordType::kValue:
+        return Insert(header.key, header.length, address);
+      case RecordType::kRemove: Erase(header.key); break;
+      case RecordType::kCommit: break;
+    }
+    return {};
+  }
+
+  /// Copy a record into the staging buffer, committing first if it does not
+  /// fit.
+  Returns<void> Stage(uint16_t key,
+                      RecordType type,
+                      const void * data,
+                      size_t size)
+  {
+    size_t record_size = RecordSize(static_cast<uint16_t>(size));
+    if (batch_length_ + record_size + sizeof(RecordHeader_t) > kBatchSize)
+    {
+      SJ2_RETURN_ON_ERROR(Commit());
+    }
+
+    RecordHeader_t header = {
+      .key      = key,
+      .length   = static_cast<uint16_t>(size),
+      .type     = static_cast<uint8_t>(type),
+      .reserved = 0xFF,
+      .crc      = 0,
+    };
+
+    uint8_t * record = &batch_[batch_length_];
+    memcpy(record, &header, sizeof(header));
+    // Fill the padding with the erased value of flash memory.
+    std::fill_n(&record[sizeof(header)], record_size - sizeof(header), 0xFF);
+    if (size > 0)
+    {
+      memcpy(&record[sizeof(header)], data, size);
+    }
+    batch_length_ += record_size;
+
+    return {};
+  }
+
+  /// Make sure that the active sector has room for the given number of bytes,
+  /// opening new sectors as needed.
+  Returns<void> Reserve(size_t length)
+  {
+    for (uint32_t attempt = 0; attempt <= sector_count_; attempt++)
+    {
+      if (write_offset_ + length <= sector_size_)
+      {
+        return {};
+      }
+      SJ2_RETURN_ON_ERROR(OpenNextSector());
+    }
+
+    return Error(Status::kOutOfBounds,
+                 "Key/value store is full, increase the sector count or size.");
+  }
+
+  /// Erase and open the sector after the active sector, then move the live
+  /// records of the oldest sector into it, so that the oldest sector can be
+  /// erased when it is next opened.
+  Returns<void> OpenNextSector()
+  {
+    uint32_t sector = (active_ + 1) % sector_count_;
+    uint32_t oldest = (sector + 1) % sector_count_;
+
+    LogDebug("Opening sector %" PRIu32, sector);
+
+    // Close the sector first, in case anything below fails.
+    write_offset_ = sector_size_;
+
+    SJ2_RETURN_ON_ERROR(storage_.Erase(SectorAddress(sector), sector_size_));
+
+    SectorHeader_t header = {
+      .magic    = kMagic,
+      .sequence = sequence_ + 1,
+    };
+    SJ2_RETURN_ON_ERROR(
+        storage_.Write(SectorAddress(sector), &header, sizeof(header)));
+
+    active_       = sector;
+    sequence_     = header.sequence;
+    write_offset_ = sizeof(SectorHeader_t);
+
+    // Copy every live record of the oldest sector into the new sector. The
+    // index is walked in the same order twice, once to copy and then, once the
+    // copies are committed, again to update the addresses.
+    uint32_t offset = write_offset_;
+    for (const auto & entry : index_)
+    {
+      if (entry.key == kInvalidKey || !IsInSector(entry.address, oldest))
+      {
+        continue;
+      }
+      SJ2_RETURN_ON_ERROR(
+          CopyRecord(entry.address, SectorAddress(sector) + offset));
+      offset += RecordSize(entry.length);
+    }
+
+    // Always write a commit record, even if nothing was copied, to mark that
+    // the sector was opened successfully.
+    RecordHeader_t commit = {
+      .key      = kInvalidKey,
+      .length   = 0,
+      .type     = static_cast<uint8_t>(RecordType::kCommit),
+      .reserved = 0xFF,
+      .crc      = 0,
+    };
+    commit.crc = RecordCrc(sequence_, commit, nullptr);
+    SJ2_RETURN_ON_ERROR(storage_.Write(SectorAddress(sector) + offset, &commit,
+                                       sizeof(commit)));
+
+    uint32_t new_address = SectorAddress(sector) + write_offset_;
+    for (auto & entry : index_)
+    {
+      if (entry.key == kInvalidKey || !IsInSector(entry.address, oldest))
+      {
+        continue;
+      }
+      entry.address = new_address;
+      new_address += RecordSize(entry.length);
+    }
+
+    write_offset_ = offset + sizeof(commit);
+
+    return {};
+  }
+
+  /// Copy a record from one location in storage to another, updating its CRC
+  /// to use the active sector's sequence number.
+  Returns<void> CopyRecord(uint32_t source, uint32_t destination)
+  {
+    RecordHeader_t header;
+    SJ2_RETURN_ON_ERROR(storage_.Read(source, &header, sizeof(header)));
+
+    header.crc = SJ2_RETURN_ON_ERROR(
+        RecordCrcFromStorage(sequence_, header, source + sizeof(header)));
+    SJ2_RETURN_ON_ERROR(storage_.Write(destination, &header, sizeof(header)));
+
+    size_t data_length = AlignUp(header.length);
+    for (size_t offset = sizeof(header); offset < sizeof(header) + data_length;
+         offset += kChunkSize)
+    {
+      std::array<uint8_t, kChunkSize> chunk;
+      size_t chunk_length =
+          std::min(kChunkSize, sizeof(header) + data_length - offset);
+      uint32_t chunk_offset = static_cast<uint32_t>(offset);
+      SJ2_RETURN_ON_ERROR(
+          storage_.Read(source + chunk_offset, chunk.data(), chunk_length));
+      SJ2_RETURN_ON_ERROR(storage_.Write(destination + chunk_offset,
+                                         chunk.data(), chunk_length));
+    }
+
+    return {};
+  }
+
+  // ===========================================================================
+  // Index
+  // ===========================================================================
+
+  static constexpr size_t Hash(uint16_t key)
+  {
+    // Fibonacci hashing to spread sequential keys across the index.
+    return (key * 40503U) & (kIndexSize - 1);
+  }
+
+  void ClearIndex()
+  {
+    index_.fill(IndexEntry_t{});
+    key_count_ = 0;
+  }
+
+  const IndexEntry_t * Find(uint16_t key) const
+  {
+    for (size_t i = Hash(key); index_[i].key != kInvalidKey;
+         i = (i + 1) & (kIndexSize - 1))
+    {
+      if (index_[i].key == key)
+      {
+        return &index_[i];
+      }
+    }
+    return nullptr;
+  }
+
+  Returns<void> Insert(uint16_t key, uint16_t length, uint32_t address)
+  {
+    size_t i = Hash(key);
+    while (index_[i].key != kInvalidKey && index_[i].key != key)
+    {
+      i = (i + 1) & (kIndexSize - 1);
+    }
+
+    if (index_[i].key == kInvalidKey)
+    {
+      if (key_count_ >= kMaxKeys)
+      {
+        return Error(Status::kOutOfBounds,
+                     "Key/value store index is full, increase kMaxKeys.");
+      }
+      key_count_++;
+    }
+
+    index_[i] = IndexEntry_t{ .key = key, .length = length, .address = address };
+    return {};
+  }
+
+  void Erase(uint16_t key)
+  {
+    size_t i = Hash(key);
+    while (index_[i].key != key)
+    {
+      if (index_[i].key == kInvalidKey)
+      {
+        return;
+      }
+      i = (i + 1) & (kIndexSize - 1);
+    }
+
+    index_[i] = IndexEntry_t{};
+    key_count_--;
+
+    // Shift back entries that are part of the same probe sequence so that
+    // lookups never stop early at the slot that was just emptied.
+    for (size_t j = (i + 1) & (kIndexSize - 1); index_[j].key != kInvalidKey;
+         j = (j + 1) & (kIndexSize - 1))
+    {
+      size_t home = Hash(index_[j].key);
+      // Distance from each entry's home slot to its current slot.
+      size_t distance_to_empty = (i - home) & (kIndexSize - 1);
+      size_t distance_to_entry = (j - home) & (kIndexSize - 1);
+      if (distance_to_empty < distance_to_entry)
+      {
+        index_[i] = index_[j];
+        index_[j] = IndexEntry_t{};
+        i         = j;
+      }
+    }
+  }
+
+  Storage & storage_;
+  uint32_t address_;
+  uint32_t sector_size_;
+  uint32_t sector_count_;
+  std::array<IndexEntry_t, kIndexSize> index_;
+  size_t key_count_ = 0;
+  std::array<uint8_t, kBatchSize> batch_;
+  size_t batch_length_ = 0;
+  size_t staged_keys_  = 0;
+  uint32_t sequence_   = 0;
+  uint32_t active_     = 0;
+  uint32_t write_offset_ = 0;
+};
+}  // namespace sjsu
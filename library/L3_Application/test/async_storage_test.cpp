@@ -0,0 +1,237 @@
+#include <array>
+#include <cstdint>
+#include <deque>
+
+#include "L3_Application/async_storage.hpp"
+#include "L4_Testing/testing_frameworks.hpp"
+
+namespace  // private namespace for custom fakes
+{
+constexpr size_t kAsyncStorageQueueDepth = 3;
+
+std::array<uint8_t, 16> async_storage_queue_id;
+std::array<uint8_t, 16> async_storage_semaphore_id;
+std::deque<sjsu::StorageRequest *> async_storage_queue;
+int async_storage_semaphore_gives = 0;
+
+QueueHandle_t AsyncStorageQueueHandle()
+{
+  return reinterpret_cast<QueueHandle_t>(async_storage_queue_id.data());
+}
+
+SemaphoreHandle_t AsyncStorageSemaphoreHandle()
+{
+  return reinterpret_cast<SemaphoreHandle_t>(
+      async_storage_semaphore_id.data());
+}
+
+QueueHandle_t AsyncStorageCreateQueue(UBaseType_t,
+                                      UBaseType_t item_size,
+                                      uint8_t *,
+                                      StaticQueue_t *,
+                                      uint8_t)
+{
+  CHECK(item_size == sizeof(sjsu::StorageRequest *));
+  return AsyncStorageQueueHandle();
+}
+
+BaseType_t AsyncStorageQueueSend(QueueHandle_t queue,
+                                 const void * item,
+                                 TickType_t,
+                                 BaseType_t)
+{
+  if (queue == AsyncStorageSemaphoreHandle())
+  {
+    async_storage_semaphore_gives++;
+    return pdTRUE;
+  }
+
+  if (async_storage_queue.size() >= kAsyncStorageQueueDepth)
+  {
+    return pdFALSE;
+  }
+
+  async_storage_queue.push_back(
+      *reinterpret_cast<sjsu::StorageRequest * const *>(item));
+  return pdTRUE;
+}
+
+BaseType_t AsyncStorageQueueReceive(QueueHandle_t, void * item, TickType_t)
+{
+  if (async_storage_queue.empty())
+  {
+    return pdFALSE;
+  }
+
+  *reinterpret_cast<sjsu::StorageRequest **>(item) =
+      async_storage_queue.front();
+  async_storage_queue.pop_front();
+  return pdTRUE;
+}
+}  // namespace
+
+namespace sjsu
+{
+TEST_CASE("Testing AsyncStorage")
+{
+  RESET_FAKE(xQueueGenericCreateStatic);
+  RESET_FAKE(xQueueGenericSend);
+  RESET_FAKE(xQueueReceive);
+
+  xQueueGenericCreateStatic_fake.custom_fake = AsyncStorageCreateQueue;
+  xQueueGenericSend_fake.custom_fake         = AsyncStorageQueueSend;
+  xQueueReceive_fake.custom_fake             = AsyncStorageQueueReceive;
+  async_storage_queue.clear();
+  async_storage_semaphore_gives = 0;
+
+  Mock<Storage> mock_storage;
+  Fake(Method(mock_storage, Read), Method(mock_storage, Write),
+       Method(mock_storage, Erase));
+
+  AsyncStorage<kAsyncStorageQueueDepth> test_subject(
+      "Storage", rtos::Priority::kMedium, mock_storage.get());
+
+  CHECK(xQueueGenericCreateStatic_fake.call_count == 1);
+
+  std::array<uint8_t, 8> buffer = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+  SECTION("Requests are serviced in submission order by the worker")
+  {
+    // Setup
+    StorageRequest write = StorageRequest::Write(0x100, buffer.data(), 8);
+    StorageRequest read  = StorageRequest::Read(0x200, buffer.data(), 4);
+    StorageRequest erase = StorageRequest::Erase(0x300, 2);
+
+    // Exercise: Submitting does not touch the storage device
+    CHECK(test_subject.Submit(write));
+    CHECK(test_subject.Submit(read));
+    CHECK(test_subject.Submit(erase));
+
+    // Verify
+    CHECK(!write.IsComplete());
+    CHECK(!read.IsComplete());
+    CHECK(!erase.IsComplete());
+    VerifyNoOtherInvocations(mock_storage);
+
+    // Exercise
+    CHECK(test_subject.Run());
+
+    // Verify
+    CHECK(write.IsComplete());
+    CHECK(!read.IsComplete());
+    Verify(Method(mock_storage, Write).Using(0x100, buffer.data(), 8));
+
+    // Exercise
+    CHECK(test_subject.Run());
+    CHECK(test_subject.Run());
+
+    // Verify
+    CHECK(read.IsComplete());
+    CHECK(erase.IsComplete());
+    Verify(Method(mock_storage, Write),
+           Method(mock_storage, Read).Using(0x200, buffer.data(), 4),
+           Method(mock_storage, Erase).Using(0x300, 2));
+    CHECK(test_subject.GetCompletedCount() == 3);
+  }
+
+  SECTION("Run() without any requests does nothing")
+  {
+    // Exercise
+    CHECK(test_subject.Run());
+
+    // Verify
+    VerifyNoOtherInvocations(mock_storage);
+    CHECK(test_subject.GetCompletedCount() == 0);
+  }
+
+  SECTION("Completion callback and semaphore")
+  {
+    // Setup
+    int callback_count = 0;
+    StorageRequest request = StorageRequest::Read(0, buffer.data(), 4);
+    request.semaphore      = AsyncStorageSemaphoreHandle();
+    request.callback       = [&callback_count](StorageRequest & completed) {
+      // The result is available to the callback.
+      CHECK(completed.result);
+      callback_count++;
+    };
+
+    // Exercise
+    CHECK(test_subject.Submit(request));
+    CHECK(callback_count == 0);
+    CHECK(test_subject.Run());
+
+    // Verify
+    CHECK(callback_count == 1);
+    CHECK(async_storage_semaphore_gives == 1);
+    CHECK(request.IsComplete());
+  }
+
+  SECTION("Storage errors are returned through the request")
+  {
+    // Setup
+    When(Method(mock_storage, Write))
+        .AlwaysReturn(Error(Status::kBusError, "Write failed"));
+    StorageRequest request = StorageRequest::Write(0, buffer.data(), 4);
+
+    // Exercise
+    CHECK(test_subject.Submit(request));
+    CHECK(test_subject.Run());
+
+    // Verify
+    CHECK(request.IsComplete());
+    CHECK(!request.result);
+    CHECK(request.result.error()->status == Status::kBusError);
+  }
+
+  SECTION("Full queue")
+  {
+    // Setup
+    std::array<StorageRequest, kAsyncStorageQueueDepth + 1> requests;
+    for (auto & request : requests)
+    {
+      request.operation = StorageRequest::Operation::kErase;
+      request.size      = 1;
+    }
+
+    // Exercise
+    for (size_t i = 0; i < kAsyncStorageQueueDepth; i++)
+    {
+      CHECK(test_subject.Submit(requests[i]));
+    }
+    auto result = test_subject.Submit(requests.back(), 10ms);
+
+    // Verify
+    CHECK(!result);
+    CHECK(result.error()->status == Status::kTimedOut);
+    CHECK(xQueueGenericSend_fake.arg2_val == 10);
+    // Verify: The rejected request is free to be submitted again
+    CHECK(requests.back().IsComplete());
+
+    // Exercise: Servicing one request makes room for another
+    CHECK(test_subject.Run());
+    CHECK(test_subject.Submit(requests.back()));
+  }
+
+  SECTION("Invalid requests are rejected")
+  {
+    // Setup
+    StorageRequest no_buffer = StorageRequest::Read(0, nullptr, 4);
+    StorageRequest in_flight = StorageRequest::Erase(0, 1);
+    CHECK(test_subject.Submit(in_flight));
+
+    // Exercise
+    auto no_buffer_result = test_subject.Submit(no_buffer);
+    auto in_flight_result = test_subject.Submit(in_flight);
+
+    // Verify
+    CHECK(no_buffer_result.error()->status == Status::kInvalidParameters);
+    CHECK(in_flight_result.error()->status == Status::kInvalidParameters);
+    CHECK(async_storage_queue.size() == 1);
+  }
+
+  RESET_FAKE(xQueueGenericCreateStatic);
+  RESET_FAKE(xQueueGenericSend);
+  RESET_FAKE(xQueueReceive);
+}
+}  // namespace sjsu
@@ -0,0 +1,77 @@
+#include <array>
+#include <cstdint>
+
+#include "L3_Application/can_router.hpp"
+#include "L4_Testing/benchmark.hpp"
+
+namespace sjsu
+{
+namespace
+{
+/// Route 64 standard IDs spread across the ID space, like the messages of a
+/// typical vehicle bus, to a handler that sums their first byte.
+template <size_t kRoutes>
+void RegisterSpreadRoutes(CanRouter<kRoutes> & router, uint32_t & sum)
+{
+  for (uint32_t i = 0; i < 64; i++)
+  {
+    router.Register(i * 31, [&sum](const Can::Message_t & message) {
+      sum += message.payload[0];
+    });
+  }
+}
+}  // namespace
+
+// Each iteration dispatches a single message, so messages/second dispatched is
+// 1e9 / (ns/iteration).
+BENCHMARK("CanRouter::Dispatch() 64 routes")
+{
+  static CanRouter<64> router;
+  static uint32_t sum = 0;
+  if (router.GetRouteCount() == 0)
+  {
+    RegisterSpreadRoutes(router, sum);
+  }
+
+  Can::Message_t message = {};
+  uint32_t route         = 0;
+  for (auto _ : state)
+  {
+    message.id         = route * 31;
+    message.payload[0] = static_cast<uint8_t>(route);
+    route              = (route + 1) & 63;
+    router.Dispatch(message);
+  }
+
+  benchmark::DoNotOptimize(sum);
+}
+
+BENCHMARK("CanRouter::Dispatch() 8 masked routes")
+{
+  static CanRouter<8> router;
+  static uint32_t sum = 0;
+  if (router.GetRouteCount() == 0)
+  {
+    // Each route handles a block of 256 IDs, so messages rotating through
+    // every block scan half of the masked routes on average.
+    for (uint32_t i = 0; i < 8; i++)
+    {
+      router.RegisterMasked(i << 8, 0x700, [](const Can::Message_t & message) {
+        sum += message.payload[0];
+      });
+    }
+  }
+
+  Can::Message_t message = {};
+  uint32_t id            = 0;
+  for (auto _ : state)
+  {
+    message.id         = id;
+    message.payload[0] = static_cast<uint8_t>(id);
+    id                 = (id + 0x101) & 0x7FF;
+    router.Dispatch(message);
+  }
+
+  benchmark::DoNotOptimize(sum);
+}
+}  // namespace sjsu
@@ -0,0 +1,195 @@
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+#include "L3_Application/can_router.hpp"
+#include "L4_Testing/testing_frameworks.hpp"
+
+namespace sjsu
+{
+namespace
+{
+Can::Message_t CanMessage(uint32_t id,
+                          Can::Message_t::Format format =
+                              Can::Message_t::Format::kStandard)
+{
+  Can::Message_t message = {};
+  message.id             = id;
+  message.format         = format;
+  return message;
+}
+
+/// Records the IDs of the messages that a handler was called with.
+struct IdRecorder_t
+{
+  /// @return a handler that records the IDs of its messages.
+  auto Record()
+  {
+    return [this](const Can::Message_t & message) {
+      ids[count++] = message.id;
+    };
+  }
+
+  std::array<uint32_t, 8> ids = { 0 };
+  size_t count                = 0;
+};
+}  // namespace
+
+TEST_CASE("Testing CanRouter")
+{
+  using Format = Can::Message_t::Format;
+
+  CanRouter<4> test_subject;
+  IdRecorder_t first;
+  IdRecorder_t second;
+
+  SECTION("Dispatches messages to the route of their ID")
+  {
+    // Setup
+    REQUIRE(test_subject.Register(0x100, first.Record()));
+    REQUIRE(test_subject.Register(0x200, second.Record()));
+
+    // Exercise
+    CHECK(test_subject.Dispatch(CanMessage(0x200)));
+    CHECK(test_subject.Dispatch(CanMessage(0x100)));
+    CHECK(test_subject.Dispatch(CanMessage(0x100)));
+    CHECK(!test_subject.Dispatch(CanMessage(0x300)));
+
+    // Verify
+    CHECK(2 == first.count);
+    CHECK(0x100 == first.ids[0]);
+    CHECK(1 == second.count);
+    CHECK(0x200 == second.ids[0]);
+    CHECK(1 == test_subject.GetUnroutedCount());
+  }
+
+  SECTION("Standard and extended IDs are routed separately")
+  {
+    // Setup
+    REQUIRE(test_subject.Register(0x100, first.Record()));
+    REQUIRE(
+        test_subject.Register(0x100, second.Record(), Format::kExtended));
+
+    // Exercise
+    test_subject.Dispatch(CanMessage(0x100, Format::kExtended));
+
+    // Verify
+    CHECK(0 == first.count);
+    CHECK(1 == second.count);
+  }
+
+  SECTION("Masked routes")
+  {
+    // Setup
+    REQUIRE(test_subject.Register(0x7E3, first.Record()));
+    REQUIRE(test_subject.RegisterMasked(0x7E0, 0x7F8, second.Record()));
+
+    // Exercise
+    CHECK(test_subject.Dispatch(CanMessage(0x7E0)));
+    CHECK(test_subject.Dispatch(CanMessage(0x7E3)));
+    CHECK(test_subject.Dispatch(CanMessage(0x7E7)));
+    CHECK(!test_subject.Dispatch(CanMessage(0x7E8)));
+    CHECK(!test_subject.Dispatch(CanMessage(0x7E0, Format::kExtended)));
+
+    // Verify: single ID routes take priority over masked routes
+    CHECK(1 == first.count);
+    CHECK(0x7E3 == first.ids[0]);
+    REQUIRE(2 == second.count);
+    CHECK(0x7E0 == second.ids[0]);
+    CHECK(0x7E7 == second.ids[1]);
+    CHECK(2 == test_subject.GetStatistics(0x7E5).count);
+  }
+
+  SECTION("Rejects invalid routes")
+  {
+    // Exercise & Verify
+    CHECK(!test_subject.Register(0x800, first.Record()));
+    CHECK(!test_subject.Register(0x2000'0000, first.Record(),
+                                 Format::kExtended));
+    CHECK(!test_subject.RegisterMasked(0x800, 0x7FF, first.Record()));
+    CHECK(test_subject.Register(0x100, first.Record()));
+    CHECK(!test_subject.Register(0x100, second.Record()));
+    CHECK(test_subject.Register(0x101, first.Record()));
+    CHECK(test_subject.Register(0x102, first.Record()));
+    CHECK(test_subject.RegisterMasked(0x200, 0x700, first.Record()));
+    CHECK(!test_subject.Register(0x103, first.Record()));
+    CHECK(!test_subject.RegisterMasked(0x300, 0x700, first.Record()));
+    CHECK(4 == test_subject.GetRouteCount());
+  }
+
+  SECTION("Statistics")
+  {
+    // Setup
+    static std::chrono::nanoseconds fake_uptime = 0ns;
+    SetUptimeFunction([]() { return fake_uptime; });
+    REQUIRE(test_subject.Register(0x100, first.Record()));
+
+    // Exercise: 11 messages, 100ms apart
+    for (int i = 0; i <= 10; i++)
+    {
+      fake_uptime = 5s + (i * 100ms);
+      test_subject.Dispatch(CanMessage(0x100));
+    }
+
+    // Verify
+    auto statistics = test_subject.GetStatistics(0x100);
+    CHECK(11 == statistics.count);
+    CHECK(6s == statistics.last_seen);
+    CHECK(10_Hz == statistics.rate);
+    CHECK(0 == test_subject.GetStatistics(0x200).count);
+
+    SetUptimeFunction(DefaultUptime);
+  }
+
+  SECTION("DispatchPending()")
+  {
+    // Setup
+    Mock<Can> mock_can;
+    std::array<Can::Message_t, 3> received = {
+      CanMessage(0x100),
+      CanMessage(0x200),
+      CanMessage(0x100),
+    };
+    size_t position = 0;
+    When(Method(mock_can, HasData)).AlwaysDo([&position, &received]() {
+      return position < received.size();
+    });
+    When(Method(mock_can, Receive)).AlwaysDo([&position, &received]() {
+      return received[position++];
+    });
+    REQUIRE(test_subject.Register(0x100, first.Record()));
+
+    // Exercise
+    size_t count = test_subject.DispatchPending(mock_can.get());
+
+    // Verify
+    CHECK(3 == count);
+    CHECK(2 == first.count);
+    CHECK(1 == test_subject.GetUnroutedCount());
+  }
+}
+
+TEST_CASE("Testing CanRouterTask")
+{
+  Mock<Can> mock_can;
+  bool has_data = true;
+  When(Method(mock_can, HasData)).AlwaysDo([&has_data]() {
+    return std::exchange(has_data, false);
+  });
+  When(Method(mock_can, Receive)).AlwaysReturn(CanMessage(0x100));
+
+  CanRouter<2> router;
+  IdRecorder_t recorder;
+  REQUIRE(router.Register(0x100, recorder.Record()));
+  CanRouterTask<2> test_subject("CanRouter", rtos::Priority::kHigh, router,
+                                mock_can.get(), 5);
+
+  // Exercise
+  bool result = test_subject.Run();
+
+  // Verify
+  CHECK(result);
+  CHECK(5 == test_subject.GetDelayTime());
+  CHECK(1 == recorder.count);
+}
+}  // namespace sjsu
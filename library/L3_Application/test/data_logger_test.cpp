@@ -0,0 +1,412 @@
+#include <ff.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "L3_Application/data_logger.hpp"
+#include "L3_Application/fatfs.hpp"
+#include "L4_Testing/testing_frameworks.hpp"
+
+namespace sjsu
+{
+namespace
+{
+/// Storage device backed by RAM with 512 byte blocks, like an SD card.
+class RamDisk final : public Storage
+{
+ public:
+  static constexpr size_t kBlockSize = 512;
+
+  explicit RamDisk(size_t size) : memory(size, 0) {}
+
+  Type GetMemoryType() override
+  {
+    return Type::kSD;
+  }
+  Returns<void> Initialize() override
+  {
+    return {};
+  }
+  Returns<void> Enable() override
+  {
+    return {};
+  }
+  bool IsMediaPresent() override
+  {
+    return true;
+  }
+  bool IsReadOnly() override
+  {
+    return false;
+  }
+  units::data::byte_t GetCapacity() override
+  {
+    return units::data::byte_t(static_cast<double>(memory.size()));
+  }
+  units::data::byte_t GetBlockSize() override
+  {
+    return units::data::byte_t(kBlockSize);
+  }
+  Returns<void> Erase(uint32_t, size_t) override
+  {
+    return {};
+  }
+  Returns<void> Write(uint32_t block_address,
+                      const void * data,
+                      size_t size) override
+  {
+    if (failing_writes > 0)
+    {
+      failing_writes--;
+      return Error(Status::kBusError, "Injected write failure.");
+    }
+    CHECK((block_address * kBlockSize) + size <= memory.size());
+    memcpy(&memory[block_address * kBlockSize], data, size);
+    write_sizes.push_back(size);
+    return {};
+  }
+  Returns<void> Read(uint32_t block_address, void * data, size_t size) override
+  {
+    CHECK((block_address * kBlockSize) + size <= memory.size());
+    memcpy(data, &memory[block_address * kBlockSize], size);
+    read_count++;
+    return {};
+  }
+  Returns<void> Disable() override
+  {
+    return {};
+  }
+
+  std::vector<uint8_t> memory;
+  std::vector<size_t> write_sizes;
+  int read_count = 0;
+  /// Number of upcoming writes that fail.
+  int failing_writes = 0;
+};
+
+struct LogRecord_t
+{
+  uint32_t sequence;
+  int16_t x;
+  int16_t y;
+  int16_t z;
+  uint16_t checksum;
+};
+
+LogRecord_t MakeRecord(uint32_t sequence)
+{
+  return LogRecord_t{
+    .sequence = sequence,
+    .x        = static_cast<int16_t>(sequence * 3),
+    .y        = static_cast<int16_t>(sequence * 5),
+    .z        = static_cast<int16_t>(sequence * 7),
+    .checksum = static_cast<uint16_t>(~sequence),
+  };
+}
+
+/// @return the bytes that are expected to be logged after logging records
+///         with sequence numbers 0 to `count - 1`.
+std::vector<uint8_t> ExpectedLogStream(uint32_t count)
+{
+  std::vector<uint8_t> stream;
+  for (uint32_t i = 0; i < count; i++)
+  {
+    auto record        = MakeRecord(i);
+    const auto * bytes = reinterpret_cast<const uint8_t *>(&record);
+    stream.insert(stream.end(), bytes, bytes + sizeof(record));
+  }
+  return stream;
+}
+
+/// Append the contents of the file at `path` to `contents`.
+void ReadLogFile(const char * path, std::vector<uint8_t> & contents)
+{
+  FIL file;
+  REQUIRE(f_open(&file, path, FA_READ) == FR_OK);
+
+  const size_t kOffset = contents.size();
+  contents.resize(kOffset + f_size(&file));
+
+  UINT bytes_read = 0;
+  CHECK(f_read(&file, &contents[kOffset], static_cast<UINT>(f_size(&file)),
+               &bytes_read) == FR_OK);
+  CHECK(bytes_read == f_size(&file));
+
+  f_close(&file);
+}
+}  // namespace
+
+TEST_CASE("Testing DataLogger")
+{
+  constexpr size_t kBufferSize = 4096;
+  using TestLogger             = DataLogger<kBufferSize>;
+
+  // Setup: Format and mount a 2 MiB volume with clusters the same size as the
+  // logger's buffers.
+  static RamDisk ram_disk(2 * 1024 * 1024);
+  std::fill(ram_disk.memory.begin(), ram_disk.memory.end(), 0);
+  REQUIRE(RegisterFatFsDrive(&ram_disk));
+
+  std::array<uint8_t, FF_MAX_SS> work;
+  FATFS fat_fs;
+  REQUIRE(f_mkfs("", FM_FAT, kBufferSize, work.data(), work.size()) == FR_OK);
+  REQUIRE(f_mount(&fat_fs, "", 1) == FR_OK);
+
+  ram_disk.write_sizes.clear();
+  ram_disk.read_count     = 0;
+  ram_disk.failing_writes = 0;
+
+  SECTION("Records are written in whole buffers and can be read back")
+  {
+    // Setup
+    TestLogger logger({ .prefix = "LOG", .file_size = 64 * 1024 });
+    REQUIRE(logger.Open());
+    CHECK(0 == strcmp(logger.GetFilePath(), "LOG00000.BIN"));
+
+    // Setup: Ignore FAT updates made while preallocating the file
+    ram_disk.write_sizes.clear();
+    ram_disk.read_count = 0;
+
+    // Exercise: Log enough records to fill exactly 3 buffers
+    constexpr uint32_t kRecords =
+        (3 * kBufferSize) / sizeof(LogRecord_t) + 1;
+    for (uint32_t i = 0; i < kRecords; i++)
+    {
+      auto record = MakeRecord(i);
+      CHECK(logger.Log(&record, sizeof(record)));
+      CHECK(logger.Service());
+    }
+
+    // Verify: Each buffer reaches the storage device in a single write with
+    //         no read-modify-writes.
+    CHECK(ram_disk.write_sizes == std::vector<size_t>(3, kBufferSize));
+    CHECK(ram_disk.read_count == 0);
+    CHECK(logger.GetStatistics().writes == 3);
+    CHECK(logger.GetStatistics().bytes_written == 3 * kBufferSize);
+    CHECK(logger.GetStatistics().worst_write_latency > 0ns);
+    CHECK(logger.GetStatistics().GetThroughput() > 0);
+
+    // Exercise
+    CHECK(logger.Close());
+
+    // Verify: Closing writes the partially filled buffer and releases the
+    //         unused preallocated space.
+    CHECK(!logger.IsOpen());
+    std::vector<uint8_t> contents;
+    ReadLogFile("LOG00000.BIN", contents);
+    CHECK(contents == ExpectedLogStream(kRecords));
+  }
+
+  SECTION("Files roll over once full")
+  {
+    // Setup
+    TestLogger logger({ .prefix = "DAT", .file_size = 2 * kBufferSize });
+    REQUIRE(logger.Open());
+
+    // Exercise
+    constexpr uint32_t kRecords = 1000;
+    for (uint32_t i = 0; i < kRecords; i++)
+    {
+      auto record = MakeRecord(i);
+      CHECK(logger.Log(&record, sizeof(record)));
+      CHECK(logger.Service());
+    }
+    CHECK(logger.Close());
+
+    // Verify: 1000 records * 12 bytes = 12000 bytes, which spans 2 files
+    CHECK(logger.GetStatistics().files_created == 2);
+    std::vector<uint8_t> contents;
+    ReadLogFile("DAT00000.BIN", contents);
+    CHECK(contents.size() == 2 * kBufferSize);
+    ReadLogFile("DAT00001.BIN", contents);
+    CHECK(contents == ExpectedLogStream(kRecords));
+  }
+
+  SECTION("Files roll over after the roll period")
+  {
+    // Setup
+    static std::chrono::nanoseconds fake_uptime = 0ns;
+    SetUptimeFunction([]() { return fake_uptime; });
+    TestLogger logger(
+        { .prefix = "T", .file_size = 16 * kBufferSize, .roll_period = 10s });
+    REQUIRE(logger.Open());
+    std::array<uint8_t, kBufferSize> payload = {};
+
+    // Exercise
+    CHECK(logger.Log(payload.data(), payload.size()));
+    CHECK(logger.Service());
+    fake_uptime = 5s;
+    CHECK(logger.Log(payload.data(), payload.size()));
+    CHECK(logger.Service());
+    fake_uptime = 11s;
+    CHECK(logger.Log(payload.data(), payload.size()));
+    CHECK(logger.Service());
+
+    // Verify
+    CHECK(logger.GetStatistics().files_created == 2);
+    CHECK(0 == strcmp(logger.GetFilePath(), "T00001.BIN"));
+
+    CHECK(logger.Close());
+    SetUptimeFunction(DefaultUptime);
+  }
+
+  SECTION("Records are kept while a new file cannot be started")
+  {
+    // Setup: A second file sits right after the first log file, so once the
+    // roll period expires there is no contiguous space for the next log file.
+    static std::chrono::nanoseconds fake_uptime = 0ns;
+    fake_uptime                                  = 0ns;
+    SetUptimeFunction([]() { return fake_uptime; });
+    TestLogger logger(
+        { .prefix = "R", .file_size = 256 * kBufferSize, .roll_period = 10s });
+    REQUIRE(logger.Open());
+    FIL blocker;
+    REQUIRE(f_open(&blocker, "BLOCK.BIN", FA_WRITE | FA_CREATE_NEW) == FR_OK);
+    REQUIRE(f_expand(&blocker, 128 * kBufferSize, 1) == FR_OK);
+    f_close(&blocker);
+    std::array<uint8_t, kBufferSize> payload = {};
+
+    CHECK(logger.Log(payload.data(), payload.size()));
+    CHECK(logger.Service());
+    fake_uptime = 11s;
+    CHECK(logger.Log(payload.data(), payload.size()));
+
+    // Exercise
+    auto failed_roll = logger.Service();
+    auto logged      = logger.Log(payload.data(), payload.size());
+
+    // Verify
+    CHECK(!failed_roll);
+    CHECK(failed_roll.error()->status == Status::kOutOfBounds);
+    CHECK(logged);
+    CHECK(logger.IsOpen());
+    CHECK(logger.GetStatistics().dropped_records == 0);
+
+    // Exercise: Once there is space again, the buffered records are written
+    REQUIRE(f_unlink("BLOCK.BIN") == FR_OK);
+    CHECK(logger.Service());
+    CHECK(logger.Close());
+
+    // Verify
+    CHECK(logger.GetStatistics().files_created == 2);
+    FILINFO info;
+    REQUIRE(f_stat("R00000.BIN", &info) == FR_OK);
+    CHECK(info.fsize == kBufferSize);
+    REQUIRE(f_stat("R00001.BIN", &info) == FR_OK);
+    CHECK(info.fsize == 2 * kBufferSize);
+
+    SetUptimeFunction(DefaultUptime);
+  }
+
+  SECTION("A file is closed even if it cannot be truncated")
+  {
+    // Setup: A failed write leaves the file in an error state, which makes
+    //        f_truncate() fail when the file is rolled over.
+    static std::chrono::nanoseconds fake_uptime = 0ns;
+    fake_uptime                                  = 0ns;
+    SetUptimeFunction([]() { return fake_uptime; });
+    TestLogger logger(
+        { .prefix = "E", .file_size = 16 * kBufferSize, .roll_period = 10s });
+    REQUIRE(logger.Open());
+    std::array<uint8_t, kBufferSize> payload = {};
+
+    CHECK(logger.Log(payload.data(), payload.size()));
+    CHECK(logger.Service());
+    ram_disk.failing_writes = 1;
+    CHECK(logger.Log(payload.data(), payload.size()));
+    CHECK(!logger.Service());
+    fake_uptime = 11s;
+
+    // Exercise
+    auto failed_roll = logger.Service();
+
+    // Verify: The file was closed, so its directory entry holds its
+    //         preallocated size rather than the size it was created with.
+    CHECK(!failed_roll);
+    FILINFO info;
+    REQUIRE(f_stat("E00000.BIN", &info) == FR_OK);
+    CHECK(info.fsize == 16 * kBufferSize);
+
+    // Exercise & Verify: The buffered records go into the next file
+    CHECK(logger.Service());
+    CHECK(logger.Close());
+    REQUIRE(f_stat("E00001.BIN", &info) == FR_OK);
+    CHECK(info.fsize == kBufferSize);
+
+    SetUptimeFunction(DefaultUptime);
+  }
+
+  SECTION("Existing files are not overwritten")
+  {
+    // Setup
+    FIL existing;
+    REQUIRE(f_open(&existing, "LOG00000.BIN", FA_WRITE | FA_CREATE_NEW) ==
+            FR_OK);
+    f_close(&existing);
+    TestLogger logger({ .prefix = "LOG", .file_size = kBufferSize });
+
+    // Exercise
+    CHECK(logger.Open());
+
+    // Verify
+    CHECK(0 == strcmp(logger.GetFilePath(), "LOG00001.BIN"));
+    CHECK(logger.Close());
+  }
+
+  SECTION("Records are dropped when the writer falls behind")
+  {
+    // Setup
+    TestLogger logger({ .prefix = "LOG", .file_size = 4 * kBufferSize });
+    REQUIRE(logger.Open());
+    std::array<uint8_t, kBufferSize / 2> payload = {};
+
+    // Exercise: Fill both buffers without servicing the logger
+    for (int i = 0; i < 4; i++)
+    {
+      CHECK(logger.Log(payload.data(), payload.size()));
+    }
+    auto dropped = logger.Log(payload.data(), 1);
+
+    // Verify
+    CHECK(!dropped);
+    CHECK(dropped.error()->status == Status::kNotReadyYet);
+    CHECK(logger.GetStatistics().dropped_records == 1);
+
+    // Exercise: Once serviced, records can be logged again
+    CHECK(logger.Service());
+    CHECK(logger.Log(payload.data(), 1));
+    CHECK(logger.Close());
+
+    // Verify
+    FILINFO info;
+    REQUIRE(f_stat("LOG00000.BIN", &info) == FR_OK);
+    CHECK(info.fsize == 2 * kBufferSize + 1);
+  }
+
+  SECTION("Invalid usage")
+  {
+    // Setup
+    TestLogger unaligned({ .file_size = kBufferSize + 1 });
+    TestLogger too_large({ .file_size = 4 * 1024 * 1024 });
+    TestLogger logger({ .file_size = kBufferSize });
+    std::array<uint8_t, kBufferSize + 1> payload = {};
+
+    // Exercise + Verify
+    CHECK(logger.Log(payload.data(), 1).error()->status ==
+          Status::kNotReadyYet);
+    CHECK(logger.Service().error()->status == Status::kNotReadyYet);
+    CHECK(unaligned.Open().error()->status == Status::kInvalidSettings);
+    CHECK(too_large.Open().error()->status == Status::kOutOfBounds);
+
+    REQUIRE(logger.Open());
+    CHECK(logger.Open().error()->status == Status::kInvalidSettings);
+    CHECK(logger.Log(payload.data(), payload.size()).error()->status ==
+          Status::kInvalidParameters);
+    CHECK(logger.Close());
+  }
+
+  f_mount(nullptr, "", 0);
+}
+}  // namespace sjsu
@@ -0,0 +1,211 @@
+#include <array>
+#include <cstdint>
+
+#include "L3_Application/deferred_work.hpp"
+#include "L4_Testing/testing_frameworks.hpp"
+
+namespace sjsu
+{
+namespace
+{
+/// Records the order that work items were run in.
+struct OrderRecorder_t
+{
+  /// @return a work item that records id when run.
+  auto Record(int id)
+  {
+    return [this, id]() { order[position++] = id; };
+  }
+
+  std::array<int, 8> order = { 0 };
+  size_t position          = 0;
+};
+}  // namespace
+
+TEST_CASE("Testing DeferredWork")
+{
+  using Priority = DeferredWork<4>::Priority;
+
+  DeferredWork<4> test_subject;
+  OrderRecorder_t recorder;
+  auto & order = recorder.order;
+  auto record  = [&recorder](int id) { return recorder.Record(id); };
+
+  SECTION("Runs work in the order it was posted")
+  {
+    // Setup
+    CHECK(test_subject.Post(record(1)));
+    CHECK(test_subject.Post(record(2)));
+    CHECK(test_subject.Post(record(3)));
+    CHECK(3 == test_subject.GetPendingCount());
+
+    // Exercise
+    size_t executed = test_subject.RunPending();
+
+    // Verify
+    CHECK(3 == executed);
+    CHECK(0 == test_subject.GetPendingCount());
+    CHECK(1 == order[0]);
+    CHECK(2 == order[1]);
+    CHECK(3 == order[2]);
+  }
+
+  SECTION("Runs high priority work first")
+  {
+    // Setup
+    test_subject.Post(record(1), Priority::kNormal);
+    test_subject.Post(record(2), Priority::kNormal);
+    test_subject.Post(record(3), Priority::kHigh);
+
+    // Exercise
+    test_subject.RunPending();
+
+    // Verify
+    CHECK(3 == order[0]);
+    CHECK(1 == order[1]);
+    CHECK(2 == order[2]);
+  }
+
+  SECTION("Runs high priority work posted by running work next")
+  {
+    // Setup
+    test_subject.Post([&test_subject, &recorder]() {
+      recorder.Record(1)();
+      test_subject.Post(recorder.Record(3), Priority::kHigh);
+    });
+    test_subject.Post(record(2));
+
+    // Exercise
+    size_t executed = test_subject.RunPending();
+
+    // Verify
+    CHECK(3 == executed);
+    CHECK(1 == order[0]);
+    CHECK(3 == order[1]);
+    CHECK(2 == order[2]);
+  }
+
+  SECTION("Drops and counts work when full")
+  {
+    // Setup
+    for (int i = 0; i < 4; i++)
+    {
+      CHECK(test_subject.Post(record(i)));
+    }
+
+    // Exercise
+    bool accepted = test_subject.Post(record(4));
+
+    // Verify
+    CHECK(!accepted);
+    CHECK(test_subject.Post(record(5), Priority::kHigh));
+
+    auto normal = test_subject.GetStatistics(Priority::kNormal);
+    CHECK(4 == normal.posted);
+    CHECK(1 == normal.overflows);
+    CHECK(4 == normal.high_water_mark);
+    CHECK(0 == normal.executed);
+
+    auto high = test_subject.GetStatistics(Priority::kHigh);
+    CHECK(1 == high.posted);
+    CHECK(0 == high.overflows);
+    CHECK(1 == high.high_water_mark);
+  }
+
+  SECTION("Statistics")
+  {
+    // Setup
+    test_subject.Post(record(1));
+    test_subject.Post(record(2));
+    test_subject.RunPending();
+    test_subject.Post(record(3));
+
+    // Exercise
+    auto before = test_subject.GetStatistics(Priority::kNormal);
+    test_subject.ResetStatistics();
+    auto after = test_subject.GetStatistics(Priority::kNormal);
+
+    // Verify
+    CHECK(3 == before.posted);
+    CHECK(2 == before.executed);
+    CHECK(0 == before.overflows);
+    CHECK(2 == before.high_water_mark);
+
+    CHECK(0 == after.posted);
+    CHECK(0 == after.executed);
+    CHECK(0 == after.overflows);
+    CHECK(0 == after.high_water_mark);
+    CHECK(1 == test_subject.GetPendingCount());
+  }
+
+  SECTION("Calls the wake handler after each successful post")
+  {
+    // Setup
+    int wake_count = 0;
+    test_subject.SetWakeHandler([&wake_count]() { wake_count++; });
+
+    // Exercise
+    for (int i = 0; i < 5; i++)
+    {
+      test_subject.Post(record(i));
+    }
+
+    // Verify
+    CHECK(4 == wake_count);
+  }
+}
+
+TEST_CASE("Testing DeferredWorkTask")
+{
+  RESET_FAKE(vTaskNotifyGiveFromISR);
+  RESET_FAKE(ulTaskNotifyTake);
+
+  DeferredWork<4> work;
+  DeferredWorkTask<4> test_subject("Deferred", rtos::Priority::kHigh, work);
+  int calls = 0;
+
+  SECTION("Does not notify before the task is created")
+  {
+    // Exercise
+    work.Post([&calls]() { calls++; });
+
+    // Verify
+    CHECK(0 == vTaskNotifyGiveFromISR_fake.call_count);
+    CHECK(1 == work.GetPendingCount());
+  }
+
+  SECTION("Notifies the task when work is posted")
+  {
+    // Setup
+    int task_control_block;
+    auto handle = reinterpret_cast<TaskHandle_t>(&task_control_block);
+    *test_subject.GetHandle() = handle;
+
+    // Exercise
+    work.Post([&calls]() { calls++; });
+    work.Post([&calls]() { calls++; });
+
+    // Verify
+    CHECK(2 == vTaskNotifyGiveFromISR_fake.call_count);
+    CHECK(handle == vTaskNotifyGiveFromISR_fake.arg0_val);
+  }
+
+  SECTION("Run() runs pending work then waits for more")
+  {
+    // Setup
+    work.Post([&calls]() { calls++; });
+    work.Post([&calls]() { calls++; });
+
+    // Exercise
+    bool result = test_subject.Run();
+
+    // Verify
+    CHECK(result);
+    CHECK(2 == calls);
+    CHECK(0 == work.GetPendingCount());
+    CHECK(1 == ulTaskNotifyTake_fake.call_count);
+    CHECK(pdTRUE == ulTaskNotifyTake_fake.arg0_val);
+    CHECK(portMAX_DELAY == ulTaskNotifyTake_fake.arg1_val);
+  }
+}
+}  // namespace sjsu
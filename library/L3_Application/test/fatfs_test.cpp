@@ -168,8 +168,78 @@ TEST_CASE("Testing FAT FS")
 
   SECTION("disk_ioctl()")
   {
-    // Setup + Exercise + Verify
-    CHECK(RES_PARERR == disk_ioctl(0, 0, nullptr));
+    // Setup
+    Mock<sjsu::Storage> mock_storage;
+    When(Method(mock_storage, GetCapacity)).AlwaysReturn(2_MiB);
+    When(Method(mock_storage, GetBlockSize)).AlwaysReturn(4_KiB);
+    RegisterFatFsDrive(&mock_storage.get());
+
+    SECTION("Invalid drive number")
+    {
+      // Exercise + Verify
+      CHECK(RES_PARERR == disk_ioctl(5, CTRL_SYNC, nullptr));
+    }
+
+    SECTION("Unsupported command")
+    {
+      // Exercise + Verify
+      CHECK(RES_PARERR == disk_ioctl(0, CTRL_TRIM, nullptr));
+    }
+
+    SECTION("CTRL_SYNC")
+    {
+      // Exercise + Verify
+      CHECK(RES_OK == disk_ioctl(0, CTRL_SYNC, nullptr));
+    }
+
+    SECTION("GET_SECTOR_COUNT")
+    {
+      // Setup
+      DWORD sector_count = 0;
+
+      // Exercise
+      CHECK(RES_OK == disk_ioctl(0, GET_SECTOR_COUNT, &sector_count));
+
+      // Verify
+      CHECK(sector_count == (2 * 1024 * 1024) / FF_MIN_SS);
+    }
+
+    SECTION("GET_SECTOR_SIZE")
+    {
+      // Setup
+      WORD sector_size = 0;
+
+      // Exercise
+      CHECK(RES_OK == disk_ioctl(0, GET_SECTOR_SIZE, &sector_size));
+
+      // Verify
+      CHECK(sector_size == FF_MIN_SS);
+    }
+
+    SECTION("GET_BLOCK_SIZE")
+    {
+      // Setup
+      DWORD block_size = 0;
+
+      // Exercise
+      CHECK(RES_OK == disk_ioctl(0, GET_BLOCK_SIZE, &block_size));
+
+      // Verify
+      CHECK(block_size == 4096 / FF_MIN_SS);
+    }
+
+    SECTION("GET_BLOCK_SIZE of media with small blocks")
+    {
+      // Setup
+      When(Method(mock_storage, GetBlockSize)).AlwaysReturn(4_B);
+      DWORD block_size = 0;
+
+      // Exercise
+      CHECK(RES_OK == disk_ioctl(0, GET_BLOCK_SIZE, &block_size));
+
+      // Verify
+      CHECK(block_size == 1);
+    }
   }
 
   SECTION("RegisterFatFsDrive() Fails when driver number is out of bounds")
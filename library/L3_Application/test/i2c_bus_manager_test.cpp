@@ -0,0 +1,330 @@
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "L3_Application/i2c_bus_manager.hpp"
+#include "L4_Testing/testing_frameworks.hpp"
+
+namespace sjsu
+{
+namespace
+{
+/// I2c stand-in that holds each asynchronous transaction until the test
+/// completes it, like an interrupt driven driver waiting on the bus.
+class FakeAsyncI2c final : public I2c
+{
+ public:
+  Returns<void> Initialize() const override
+  {
+    return {};
+  }
+
+  Returns<void> Transaction(Transaction_t) const override
+  {
+    return {};
+  }
+
+  Returns<void> TransactionAsync(Transaction_t transaction,
+                                 CompletionHandler on_complete) const override
+  {
+    REQUIRE(!on_complete_);
+    started.push_back(transaction.address);
+    on_complete_ = on_complete;
+    if (complete_immediately)
+    {
+      Finish();
+    }
+    return {};
+  }
+
+  /// Finish the transaction on the bus, as the driver's interrupt would.
+  void Finish(Status status = Status::kSuccess) const
+  {
+    REQUIRE(on_complete_);
+    CompletionHandler on_complete = on_complete_;
+    on_complete_                  = nullptr;
+    on_complete(status);
+  }
+
+  bool CancelTransactionAsync() const override
+  {
+    if (before_cancel)
+    {
+      before_cancel();
+    }
+    if (!supports_cancel || !on_complete_)
+    {
+      return false;
+    }
+    cancelled++;
+    Finish(Status::kTimedOut);
+    return true;
+  }
+
+  /// Address of every transaction started, in order.
+  mutable std::vector<uint8_t> started;
+  /// Number of transactions cancelled.
+  mutable int cancelled = 0;
+  /// Finish transactions as soon as they are started.
+  bool complete_immediately = false;
+  /// Cancel transactions when asked to, rather than leave them on the bus.
+  bool supports_cancel = true;
+  /// Called at the start of CancelTransactionAsync(), as an interrupt that
+  /// fires just before the cancellation would.
+  void (*before_cancel)() = nullptr;
+
+ private:
+  mutable CompletionHandler on_complete_ = nullptr;
+};
+
+I2c::Transaction_t ToDevice(uint8_t address)
+{
+  return I2c::Transaction_t{ .address = address };
+}
+}  // namespace
+
+TEST_CASE("Testing I2cBusManager")
+{
+  using Manager_t = I2cBusManager<4>;
+  using Priority  = Manager_t::Priority;
+
+  static std::chrono::nanoseconds fake_uptime;
+  fake_uptime = 0ns;
+  SetUptimeFunction([]() { return fake_uptime; });
+
+  static std::vector<Status> completed;
+  completed.clear();
+  auto record = [](Status status) { completed.push_back(status); };
+
+  FakeAsyncI2c bus;
+  Manager_t test_subject(bus);
+
+  SECTION("Transactions run back to back by priority")
+  {
+    // Exercise: the first transaction starts straight away
+    REQUIRE(test_subject.Submit(ToDevice(0x10), record));
+    REQUIRE(test_subject.Submit(ToDevice(0x20), record, Priority::kLow));
+    REQUIRE(test_subject.Submit(ToDevice(0x30), record, Priority::kHigh));
+    REQUIRE(test_subject.Submit(ToDevice(0x40), record));
+
+    // Verify
+    REQUIRE(1 == bus.started.size());
+    CHECK(4 == test_subject.GetPendingCount());
+
+    // Exercise: each completion starts the next transaction
+    bus.Finish();
+    bus.Finish();
+    bus.Finish();
+    bus.Finish();
+
+    // Verify
+    CHECK(std::vector<uint8_t>{ 0x10, 0x30, 0x40, 0x20 } == bus.started);
+    CHECK(4 == completed.size());
+    CHECK(0 == test_subject.GetPendingCount());
+  }
+
+  SECTION("Completion handlers can queue the next transaction")
+  {
+    // Setup
+    static const Manager_t * manager;
+    manager = &test_subject;
+    auto resubmit = [](Status) {
+      manager->Submit(ToDevice(0x11), [](Status status) {
+        completed.push_back(status);
+      });
+    };
+
+    // Exercise
+    REQUIRE(test_subject.Submit(ToDevice(0x10), resubmit));
+    bus.Finish();
+    bus.Finish(Status::kDeviceNotFound);
+
+    // Verify
+    CHECK(std::vector<uint8_t>{ 0x10, 0x11 } == bus.started);
+    REQUIRE(1 == completed.size());
+    CHECK(Status::kDeviceNotFound == completed[0]);
+  }
+
+  SECTION("Queue full")
+  {
+    // Exercise
+    for (size_t i = 0; i < 4; i++)
+    {
+      CHECK(test_subject.Submit(ToDevice(0x10), record));
+    }
+    auto result = test_subject.Submit(ToDevice(0x10), record);
+
+    // Verify
+    CHECK(!result);
+    CHECK(Status::kOutOfBounds == result.error()->status);
+    CHECK(1 == test_subject.GetOverflowCount());
+
+    // Exercise: slots are reused once transactions finish
+    bus.Finish();
+    CHECK(test_subject.Submit(ToDevice(0x10), record));
+  }
+
+  SECTION("Withdraw()")
+  {
+    // Setup
+    auto active = test_subject.Submit(ToDevice(0x10), record);
+    auto queued = test_subject.Submit(ToDevice(0x20), record);
+    REQUIRE(active);
+    REQUIRE(queued);
+
+    // Exercise
+    CHECK(!test_subject.Withdraw(active.value()));
+    CHECK(test_subject.Withdraw(queued.value()));
+    CHECK(!test_subject.Withdraw(queued.value()));
+    bus.Finish();
+
+    // Verify
+    CHECK(std::vector<uint8_t>{ 0x10 } == bus.started);
+    CHECK(1 == completed.size());
+    CHECK(0 == test_subject.GetPendingCount());
+    CHECK(1 == test_subject.GetStatistics(0x20).timeouts);
+  }
+
+  SECTION("Statistics")
+  {
+    // Exercise: the second transaction waits 2ms for the first
+    test_subject.Submit(ToDevice(0x10), record);
+    test_subject.Submit(ToDevice(0x20), record);
+    fake_uptime = 2ms;
+    bus.Finish();
+    fake_uptime = 3ms;
+    bus.Finish(Status::kDeviceNotFound);
+
+    // Verify
+    auto first  = test_subject.GetStatistics(0x10);
+    auto second = test_subject.GetStatistics(0x20);
+    CHECK(1 == first.transactions);
+    CHECK(0 == first.errors);
+    CHECK(2ms == first.max_latency);
+    CHECK(1 == second.transactions);
+    CHECK(1 == second.errors);
+    CHECK(Status::kDeviceNotFound == second.last_error);
+    CHECK(3ms == second.total_latency);
+    CHECK(1ms == second.total_bus_time);
+    CHECK(2 == test_subject.GetAllStatistics().size());
+    CHECK(0 == test_subject.GetStatistics(0x30).transactions);
+  }
+
+  SECTION("Transaction() blocks until the transaction finishes")
+  {
+    // Setup
+    bus.complete_immediately = true;
+    std::array<uint8_t, 2> buffer;
+
+    // Exercise & Verify
+    CHECK(test_subject.Read(0x10, buffer));
+    CHECK(std::vector<uint8_t>{ 0x10 } == bus.started);
+    CHECK(1 == test_subject.GetStatistics(0x10).transactions);
+  }
+
+  SECTION("Transaction() withdraws transactions that never start")
+  {
+    // Setup
+    SetUptimeFunction(DefaultUptime);
+    REQUIRE(test_subject.Submit(ToDevice(0x10), record));
+    std::array<uint8_t, 2> buffer;
+
+    // Exercise
+    auto result = test_subject.Read(0x20, buffer, 1ms);
+
+    // Verify
+    CHECK(!result);
+    CHECK(Status::kTimedOut == result.error()->status);
+    bus.Finish();
+    CHECK(std::vector<uint8_t>{ 0x10 } == bus.started);
+    CHECK(1 == test_subject.GetStatistics(0x20).timeouts);
+  }
+
+  SECTION("Transaction() cancels transactions stuck on the bus")
+  {
+    // Setup: the bus never finishes the transaction
+    SetUptimeFunction(DefaultUptime);
+    std::array<uint8_t, 2> buffer;
+
+    // Exercise
+    auto result = test_subject.Read(0x10, buffer, 1ms);
+
+    // Verify
+    CHECK(!result);
+    CHECK(Status::kTimedOut == result.error()->status);
+    CHECK(1 == bus.cancelled);
+    CHECK(0 == test_subject.GetPendingCount());
+    CHECK(Status::kTimedOut == test_subject.GetStatistics(0x10).last_error);
+
+    // Exercise & Verify: the next transaction gets the bus
+    REQUIRE(test_subject.Submit(ToDevice(0x20), record));
+    CHECK(std::vector<uint8_t>{ 0x10, 0x20 } == bus.started);
+  }
+
+  SECTION("Transaction() only cancels its own transaction")
+  {
+    // Setup: while the transaction is on the bus, another task queues a
+    // transaction, and the bus finishes the first one just before it is
+    // cancelled.
+    SetUptimeFunction(DefaultUptime);
+    static const Manager_t * manager;
+    static const FakeAsyncI2c * fake_bus;
+    manager           = &test_subject;
+    fake_bus          = &bus;
+    bus.before_cancel = []() {
+      manager->Submit(ToDevice(0x20), [](Status status) {
+        completed.push_back(status);
+      });
+      fake_bus->Finish();
+    };
+    std::array<uint8_t, 2> buffer;
+
+    // Exercise
+    auto result = test_subject.Read(0x10, buffer, 1ms);
+
+    // Verify: the other task's transaction was started, not cancelled
+    CHECK(result);
+    CHECK(0 == bus.cancelled);
+    CHECK(std::vector<uint8_t>{ 0x10, 0x20 } == bus.started);
+    CHECK(completed.empty());
+    CHECK(1 == test_subject.GetPendingCount());
+
+    // Exercise & Verify
+    bus.before_cancel = nullptr;
+    bus.Finish();
+    CHECK(std::vector<Status>{ Status::kSuccess } == completed);
+    CHECK(0 == test_subject.GetPendingCount());
+  }
+
+  SECTION("Transaction() abandons stuck transactions the bus cannot cancel")
+  {
+    // Setup
+    SetUptimeFunction(DefaultUptime);
+    bus.supports_cancel = false;
+    std::array<uint8_t, 2> buffer;
+
+    // Exercise
+    auto result = test_subject.Read(0x10, buffer, 1ms);
+
+    // Verify
+    CHECK(Status::kTimedOut == result.error()->status);
+    CHECK(0 == test_subject.GetPendingCount());
+
+    // Exercise: the driver finishes the abandoned transaction late
+    bus.Finish();
+
+    // Verify: the late completion is ignored
+    CHECK(0 == test_subject.GetPendingCount());
+    CHECK(1 == test_subject.GetStatistics(0x10).transactions);
+
+    // Exercise & Verify: the queue carries on
+    REQUIRE(test_subject.Submit(ToDevice(0x20), record));
+    bus.Finish();
+    CHECK(std::vector<uint8_t>{ 0x10, 0x20 } == bus.started);
+    CHECK(std::vector<Status>{ Status::kSuccess } == completed);
+  }
+
+  SetUptimeFunction(DefaultUptime);
+}
+}  // namespace sjsu
@@ -0,0 +1,411 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include "L3_Application/key_value_store.hpp"
+#include "L4_Testing/testing_frameworks.hpp"
+
+namespace sjsu
+{
+namespace
+{
+/// In-memory storage that counts the number of writes and erases performed.
+///
+/// When `flash_like` is true, the storage behaves like NOR flash, where erasing
+/// sets all bits to 1 and writes can only clear bits. Otherwise it behaves like
+/// an EEPROM, where writes overwrite memory and erase does nothing.
+template <size_t kSize>
+class MemoryStorage : public Storage
+{
+ public:
+  static constexpr size_t kSectorSize = 256;
+
+  explicit MemoryStorage(bool flash_like) : flash_like_(flash_like)
+  {
+    // Fill memory with garbage to mimic storage that was never erased.
+    for (size_t i = 0; i < memory.size(); i++)
+    {
+      memory[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+  }
+
+  Type GetMemoryType() override
+  {
+    return (flash_like_) ? Type::kNor : Type::kEeprom;
+  }
+  Returns<void> Initialize() override
+  {
+    return {};
+  }
+  Returns<void> Enable() override
+  {
+    return {};
+  }
+  bool IsMediaPresent() override
+  {
+    return true;
+  }
+  bool IsReadOnly() override
+  {
+    return false;
+  }
+  units::data::byte_t GetCapacity() override
+  {
+    return units::data::byte_t{ kSize };
+  }
+  units::data::byte_t GetBlockSize() override
+  {
+    return 4_B;
+  }
+  Returns<void> Disable() override
+  {
+    return {};
+  }
+
+  Returns<void> Erase(uint32_t address, size_t size) override
+  {
+    CHECK(address + size <= kSize);
+    erase_count[address / kSectorSize]++;
+    if (flash_like_)
+    {
+      std::fill_n(&memory[address], size, 0xFF);
+    }
+    return {};
+  }
+
+  Returns<void> Write(uint32_t address, const void * data, size_t size) override
+  {
+    CHECK(address % 4 == 0);
+    CHECK(size % 4 == 0);
+    CHECK(address + size <= kSize);
+
+    write_count++;
+
+    if (write_budget < size)
+    {
+      // Simulate a power loss in the middle of the write.
+      size         = write_budget;
+      write_budget = 0;
+      Commit(address, data, size);
+      return Error(Status::kBusError, "Power lost!");
+    }
+
+    write_budget -= size;
+    Commit(address, data, size);
+    return {};
+  }
+
+  Returns<void> Read(uint32_t address, void * data, size_t size) override
+  {
+    CHECK(address % 4 == 0);
+    CHECK(size % 4 == 0);
+    CHECK(address + size <= kSize);
+    memcpy(data, &memory[address], size);
+    return {};
+  }
+
+  std::array<uint8_t, kSize> memory;
+  std::array<uint32_t, kSize / kSectorSize> erase_count = {};
+  uint32_t write_count  = 0;
+  size_t write_budget   = SIZE_MAX;
+
+ private:
+  void Commit(uint32_t address, const void * data, size_t size)
+  {
+    const uint8_t * bytes = reinterpret_cast<const uint8_t *>(data);
+    for (size_t i = 0; i < size; i++)
+    {
+      if (flash_like_)
+      {
+        memory[address + i] &= bytes[i];
+      }
+      else
+      {
+        memory[address + i] = bytes[i];
+      }
+    }
+  }
+
+  bool flash_like_;
+};
+
+constexpr uint32_t kSectorSize  = 256;
+constexpr uint32_t kSectorCount = 4;
+using TestStore                 = KeyValueStore<16, 64>;
+using TestStorage = MemoryStorage<kSectorSize * kSectorCount>;
+
+uint32_t ReadValue(TestStore & store, uint16_t key)
+{
+  uint32_t value = 0;
+  auto result    = store.Get(key, &value, sizeof(value));
+  CHECK(result);
+  if (result)
+  {
+    CHECK(sizeof(value) == result.value());
+  }
+  return value;
+}
+
+void TestKeyValueStore(bool flash_like)
+{
+  TestStorage storage(flash_like);
+  TestStore store(storage, 0, kSectorSize, kSectorCount);
+
+  REQUIRE(store.Initialize());
+  CHECK(0 == store.GetKeyCount());
+
+  SECTION("Staged values are written with a single write on Commit()")
+  {
+    // Setup
+    uint32_t value_a = 0xAAAA'AAAA;
+    uint32_t value_b = 0xBBBB'BBBB;
+    uint32_t value_c = 0xCCCC'CCCC;
+
+    // Exercise
+    CHECK(store.Set(1, &value_a, sizeof(value_a)));
+    CHECK(store.Set(2, &value_b, sizeof(value_b)));
+    CHECK(store.Set(3, &value_c, sizeof(value_c)));
+
+    // Verify: Nothing is visible or written before commit
+    CHECK(!store.Contains(1));
+    CHECK(0 == storage.write_count);
+
+    // Exercise
+    CHECK(store.Commit());
+
+    // Verify: The first commit opens sector 0 which costs a header write and
+    // the sector's commit record write. The batch itself is a single write.
+    CHECK(3 == storage.write_count);
+    CHECK(3 == store.GetKeyCount());
+    CHECK(value_a == ReadValue(store, 1));
+    CHECK(value_b == ReadValue(store, 2));
+    CHECK(value_c == ReadValue(store, 3));
+  }
+
+  SECTION("Values survive a reboot")
+  {
+    // Setup
+    uint32_t value = 0x1234'5678;
+    std::array<uint8_t, 7> odd_value = { 1, 2, 3, 4, 5, 6, 7 };
+    CHECK(store.Set(10, &value, sizeof(value)));
+    CHECK(store.Set(11, odd_value.data(), odd_value.size()));
+    CHECK(store.Commit());
+
+    // Exercise
+    TestStore rebooted_store(storage, 0, kSectorSize, kSectorCount);
+    CHECK(rebooted_store.Initialize());
+
+    // Verify
+    std::array<uint8_t, 7> read_value = {};
+    CHECK(2 == rebooted_store.GetKeyCount());
+    CHECK(value == ReadValue(rebooted_store, 10));
+    auto length =
+        rebooted_store.Get(11, read_value.data(), read_value.size());
+    REQUIRE(length);
+    CHECK(odd_value.size() == length.value());
+    CHECK(odd_value == read_value);
+  }
+
+  SECTION("Overwrite and remove")
+  {
+    // Setup
+    uint32_t value = 1;
+    CHECK(store.Set(5, &value, sizeof(value)));
+    CHECK(store.Set(6, &value, sizeof(value)));
+    CHECK(store.Commit());
+
+    // Exercise
+    value = 2;
+    CHECK(store.Set(5, &value, sizeof(value)));
+    CHECK(store.Remove(6));
+    CHECK(store.Commit());
+
+    // Verify
+    CHECK(2 == ReadValue(store, 5));
+    CHECK(!store.Contains(6));
+    CHECK(!store.Get(6, &value, sizeof(value)));
+    CHECK(1 == store.GetKeyCount());
+
+    // Verify: After a reboot
+    TestStore rebooted_store(storage, 0, kSectorSize, kSectorCount);
+    CHECK(rebooted_store.Initialize());
+    CHECK(2 == ReadValue(rebooted_store, 5));
+    CHECK(!rebooted_store.Contains(6));
+    CHECK(1 == rebooted_store.GetKeyCount());
+  }
+
+  SECTION("Erases are spread evenly across all sectors")
+  {
+    // Setup: A handful of keys that are written once and never again must
+    // survive being moved around as sectors are recycled.
+    for (uint16_t key = 100; key < 104; key++)
+    {
+      uint32_t value = key * 3;
+      CHECK(store.Set(key, &value, sizeof(value)));
+    }
+    CHECK(store.Commit());
+
+    // Exercise
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+      CHECK(store.Set(1, &i, sizeof(i)));
+      CHECK(store.Commit());
+    }
+
+    // Verify
+    auto [min, max] = std::minmax_element(storage.erase_count.begin(),
+                                          storage.erase_count.end());
+    CHECK(*min > 10);
+    CHECK(*max - *min <= 1);
+    CHECK(999 == ReadValue(store, 1));
+    for (uint16_t key = 100; key < 104; key++)
+    {
+      CHECK(key * 3 == ReadValue(store, key));
+    }
+
+    // Verify: After a reboot
+    TestStore rebooted_store(storage, 0, kSectorSize, kSectorCount);
+    CHECK(rebooted_store.Initialize());
+    CHECK(5 == rebooted_store.GetKeyCount());
+    CHECK(999 == ReadValue(rebooted_store, 1));
+    for (uint16_t key = 100; key < 104; key++)
+    {
+      CHECK(key * 3 == ReadValue(rebooted_store, key));
+    }
+  }
+
+  SECTION("Power loss during a commit keeps the previous values")
+  {
+    // Setup
+    uint32_t value_a = 0x1111'1111;
+    uint32_t value_b = 0x2222'2222;
+    CHECK(store.Set(1, &value_a, sizeof(value_a)));
+    CHECK(store.Set(2, &value_b, sizeof(value_b)));
+    CHECK(store.Commit());
+
+    // Setup: Only the first record of the next batch reaches storage.
+    storage.write_budget = 12;
+    uint32_t new_value   = 0x3333'3333;
+    CHECK(store.Set(1, &new_value, sizeof(new_value)));
+    CHECK(store.Set(2, &new_value, sizeof(new_value)));
+
+    // Exercise
+    CHECK(!store.Commit());
+    storage.write_budget = SIZE_MAX;
+    TestStore rebooted_store(storage, 0, kSectorSize, kSectorCount);
+    CHECK(rebooted_store.Initialize());
+
+    // Verify
+    CHECK(value_a == ReadValue(rebooted_store, 1));
+    CHECK(value_b == ReadValue(rebooted_store, 2));
+
+    // Verify: The store can still be written to and read back.
+    CHECK(rebooted_store.Set(2, &new_value, sizeof(new_value)));
+    CHECK(rebooted_store.Commit());
+    TestStore second_reboot(storage, 0, kSectorSize, kSectorCount);
+    CHECK(second_reboot.Initialize());
+    CHECK(value_a == ReadValue(second_reboot, 1));
+    CHECK(new_value == ReadValue(second_reboot, 2));
+  }
+
+  SECTION("Power loss while opening a sector keeps every value")
+  {
+    // Setup: Key 7 is written once to sector 0, then key 1 is updated until
+    // sector 2 is active. Sector 0, holding key 7, is then the oldest sector
+    // and will have its live records moved when sector 3 is opened.
+    uint32_t constant = 0xC0FF'EE00;
+    CHECK(store.Set(7, &constant, sizeof(constant)));
+    CHECK(store.Commit());
+    uint32_t i = 0;
+    while (store.GetActiveSector() != kSectorCount - 2)
+    {
+      i++;
+      CHECK(store.Set(1, &i, sizeof(i)));
+      CHECK(store.Commit());
+    }
+
+    // Setup: Find the last commit that fits within sector 2, and keep a copy
+    // of storage just before the commit that opens sector 3.
+    auto snapshot = storage.memory;
+    while (true)
+    {
+      snapshot = storage.memory;
+      CHECK(store.Set(1, &++i, sizeof(i)));
+      CHECK(store.Commit());
+      if (store.GetActiveSector() != kSectorCount - 2)
+      {
+        break;
+      }
+    }
+    storage.memory        = snapshot;
+    uint32_t last_value   = i - 1;
+    uint32_t new_value    = i;
+
+    // Setup: Lose power right after the new sector's header has been written.
+    TestStore interrupted_store(storage, 0, kSectorSize, kSectorCount);
+    CHECK(interrupted_store.Initialize());
+    CHECK(interrupted_store.Set(1, &new_value, sizeof(new_value)));
+    storage.write_budget = sizeof(TestStore::SectorHeader_t);
+    CHECK(!interrupted_store.Commit());
+    storage.write_budget = SIZE_MAX;
+
+    // Exercise
+    TestStore rebooted_store(storage, 0, kSectorSize, kSectorCount);
+    CHECK(rebooted_store.Initialize());
+
+    // Verify
+    CHECK(constant == ReadValue(rebooted_store, 7));
+    CHECK(last_value == ReadValue(rebooted_store, 1));
+    CHECK(kSectorCount - 1 == rebooted_store.GetActiveSector());
+
+    // Verify: Recycle every sector, key 7 must still be around
+    for (uint32_t j = 0; j < 200; j++)
+    {
+      CHECK(rebooted_store.Set(1, &j, sizeof(j)));
+      CHECK(rebooted_store.Commit());
+    }
+    CHECK(constant == ReadValue(rebooted_store, 7));
+    CHECK(199 == ReadValue(rebooted_store, 1));
+  }
+
+  SECTION("Invalid parameters")
+  {
+    std::array<uint8_t, TestStore::kMaxValueSize + 1> too_big = {};
+    uint32_t value = 0;
+    CHECK(!store.Set(TestStore::kInvalidKey, &value, sizeof(value)));
+    CHECK(!store.Set(1, too_big.data(), too_big.size()));
+    CHECK(!store.Get(1, &value, sizeof(value)));
+  }
+
+  SECTION("Index full")
+  {
+    // Setup
+    uint32_t value = 0;
+    for (uint16_t key = 0; key < 16; key++)
+    {
+      CHECK(store.Set(key, &value, sizeof(value)));
+    }
+
+    // Exercise + Verify
+    CHECK(!store.Set(16, &value, sizeof(value)));
+    CHECK(store.Commit());
+    CHECK(16 == store.GetKeyCount());
+    CHECK(store.Set(3, &value, sizeof(value)));
+  }
+}
+}  // namespace
+
+TEST_CASE("Testing KeyValueStore")
+{
+  SECTION("EEPROM")
+  {
+    TestKeyValueStore(false);
+  }
+
+  SECTION("NOR Flash")
+  {
+    TestKeyValueStore(true);
+  }
+}
+}  // namespace sjsu
@@ -4,11 +4,42 @@
 #include "L3_Application/test/task_scheduler_test.cpp"      // NOLINT
 #include "L3_Application/test/periodic_scheduler_test.cpp"  // NOLINT
 
+// =============================================================================
+// Deferred Work
+// =============================================================================
+#include "L3_Application/test/deferred_work_test.cpp"  // NOLINT
+
+// =============================================================================
+// CAN Router
+// =============================================================================
+#include "L3_Application/test/can_router_test.cpp"  // NOLINT
+
+// =============================================================================
+// I2C Bus Manager
+// =============================================================================
+#include "L3_Application/test/i2c_bus_manager_test.cpp"  // NOLINT
+
 // =============================================================================
 // FILE I/O
 // =============================================================================
 #include "L3_Application/test/fatfs_test.cpp"             // NOLINT
 #include "third_party/fatfs/source/sjsu-dev2/diskio.cpp"  // NOLINT
+#include "third_party/fatfs/source/ff.c"                  // NOLINT
+
+// =============================================================================
+// Key/Value Store
+// =============================================================================
+#include "L3_Application/test/key_value_store_test.cpp"  // NOLINT
+
+// =============================================================================
+// Async Storage
+// =============================================================================
+#include "L3_Application/test/async_storage_test.cpp"  // NOLINT
+
+// =============================================================================
+// Data Logger
+// =============================================================================
+#include "L3_Application/test/data_logger_test.cpp"  // NOLINT
 
 // =============================================================================
 // Graphics
@@ -23,4 +54,9 @@
 #include "L3_Application/commands/test/rtos_command_test.cpp"        // NOLINT
 #include "L3_Application/commands/test/i2c_command_test.cpp"         // NOLINT
 #include "L3_Application/commands/test/common_test.cpp"              // NOLINT
+#include "L3_Application/commands/test/latency_command_test.cpp"     // NOLINT
+#include "L3_Application/commands/test/can_command_test.cpp"         // NOLINT
+#include "L3_Application/commands/test/irq_command_test.cpp"         // NOLINT
+#include "L3_Application/commands/test/trace_command_test.cpp"       // NOLINT
+#include "L3_Application/commands/test/profile_command_test.cpp"     // NOLINT
 #include "L3_Application/test/commandline_test.cpp"                  // NOLINT
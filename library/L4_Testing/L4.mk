@@ -1,2 +1,4 @@
 TESTS += $(LIBRARY_DIR)/L4_Testing/main_test.cpp
 TESTS += $(LIBRARY_DIR)/newlib/stdio.cpp
+BENCHMARKS += $(LIBRARY_DIR)/L4_Testing/benchmark_main.cpp
+BENCHMARKS += $(LIBRARY_DIR)/newlib/stdio.cpp
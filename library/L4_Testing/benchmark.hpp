@@ -0,0 +1,494 @@
+// Microbenchmark harness for measuring the performance of library code on the
+// host, on linux and on target hardware.
+//
+// Usage:
+//
+//    #include "L4_Testing/benchmark.hpp"
+//
+//    BENCHMARK("memcpy() 1kB")
+//    {
+//      std::array<uint8_t, 1024> source      = {};
+//      std::array<uint8_t, 1024> destination = {};
+//      state.SetBytesPerIteration(source.size());
+//
+//      for (auto _ : state)
+//      {
+//        memcpy(destination.data(), source.data(), source.size());
+//        sjsu::benchmark::ClobberMemory();
+//      }
+//    }
+//
+// Benchmarks placed in *_benchmark.cpp files are built and run on the host with
+// `make benchmark`. On target, include the benchmark files in the application
+// and call sjsu::benchmark::RunAll() from main().
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "utility/time.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+#include "L1_Peripheral/cortex/system_timer.hpp"
+#endif
+
+namespace sjsu
+{
+namespace benchmark
+{
+/// Prevent the compiler from optimizing away the computation of `value`.
+///
+/// @param value - result of the code being benchmarked.
+template <typename T>
+inline void DoNotOptimize(const T & value)
+{
+  asm volatile("" : : "r,m"(value) : "memory");  // NOLINT
+}
+
+/// Prevent the compiler from optimizing away the computation of `value` and
+/// from assuming that `value` is unchanged afterwards.
+///
+/// @param value - result of the code being benchmarked.
+template <typename T>
+inline void DoNotOptimize(T & value)
+{
+#if defined(__clang__)
+  asm volatile("" : "+r,m"(value) : : "memory");  // NOLINT
+#else
+  asm volatile("" : "+m,r"(value) : : "memory");  // NOLINT
+#endif
+}
+
+/// Force the compiler to perform all pending writes to memory and to assume
+/// that any memory may have been read or modified.
+inline void ClobberMemory()
+{
+  asm volatile("" : : : "memory");  // NOLINT
+}
+
+/// @return the current value of the highest resolution cycle counter available
+///         on this platform: the time stamp counter on x86, the DWT cycle
+///         counter on ARM Cortex-M, and nanoseconds of uptime otherwise.
+inline uint64_t CycleCount()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+  return cortex::SystemTimer::GetCycleCount();
+#else
+  return static_cast<uint64_t>(Uptime().count());
+#endif
+}
+
+/// Output formats for the results of the benchmarks.
+enum class Format
+{
+  kConsole,
+  kCsv,
+  kJson,
+};
+
+/// Settings used when running the benchmarks.
+struct Settings_t
+{
+  /// Format to print the results in.
+  Format format = Format::kConsole;
+  /// Only run benchmarks whose name contains this string. Set to nullptr to
+  /// run every benchmark.
+  const char * filter = nullptr;
+  /// The number of iterations is increased until a single run of the
+  /// benchmark takes at least this long. Runs made while finding the number of
+  /// iterations also serve to warm up caches and branch predictors, and are
+  /// not reported.
+  std::chrono::nanoseconds min_time = 100ms;
+  /// Upper limit to the number of iterations in a run.
+  uint64_t max_iterations = 1'000'000'000;
+};
+
+/// Measurements from the final run of a benchmark.
+struct Result_t
+{
+  /// Name of the benchmark.
+  const char * name;
+  /// Number of iterations that were measured.
+  uint64_t iterations;
+  /// Time spent in the timed portion of all iterations.
+  std::chrono::nanoseconds time;
+  /// Cycles counted by CycleCount() during the timed portion of all iterations.
+  uint64_t cycles;
+  /// Bytes processed by each iteration, 0 if not set by the benchmark.
+  uint64_t bytes_per_iteration;
+
+  /// @return the average time of each iteration in nanoseconds.
+  double GetTimePerIteration() const
+  {
+    return static_cast<double>(time.count()) / static_cast<double>(iterations);
+  }
+
+  /// @return the average number of cycles of each iteration.
+  double GetCyclesPerIteration() const
+  {
+    return static_cast<double>(cycles) / static_cast<double>(iterations);
+  }
+
+  /// @return the number of bytes processed per second, or 0 if the benchmark
+  ///         did not set the number of bytes per iteration.
+  double GetBytesPerSecond() const
+  {
+    if (time == 0ns)
+    {
+      return 0;
+    }
+    return static_cast<double>(bytes_per_iteration * iterations) /
+           (static_cast<double>(time.count()) / 1e9);
+  }
+};
+
+/// Passed to every benchmark to control the measured loop.
+class State
+{
+ public:
+  /// Iterator that counts down the iterations of the measured loop. Timing
+  /// stops once the iterator reaches the end.
+  class Iterator
+  {
+   public:
+    /// Value produced by each iteration, which is not meant to be used.
+    struct [[maybe_unused]] Value_t
+    {
+    };
+
+    /// @param state - state that owns the iterations.
+    /// @param remaining - number of iterations left to run.
+    constexpr Iterator(State * state, uint64_t remaining)
+        : state_(state), remaining_(remaining)
+    {
+    }
+
+    /// @return an unused value.
+    Value_t operator*() const
+    {
+      return {};
+    }
+
+    /// Advance to the next iteration.
+    Iterator & operator++()
+    {
+      remaining_--;
+      return *this;
+    }
+
+    /// Stops timing once all iterations have run.
+    ///
+    /// @return true if there are iterations left to run.
+    bool operator!=(const Iterator &)
+    {
+      if (remaining_ != 0)
+      {
+        return true;
+      }
+      state_->PauseTiming();
+      return false;
+    }
+
+   private:
+    State * state_;
+    uint64_t remaining_;
+  };
+
+  /// @param iterations - number of times the measured loop will run.
+  explicit State(uint64_t iterations) : iterations_(iterations) {}
+
+  /// Start timing and begin the measured loop.
+  Iterator begin()  // NOLINT
+  {
+    ResumeTiming();
+    return Iterator(this, iterations_);
+  }
+
+  /// @return the end of the measured loop.
+  Iterator end()  // NOLINT
+  {
+    return Iterator(this, 0);
+  }
+
+  /// Stop timing, for example to exclude per iteration setup work.
+  void PauseTiming()
+  {
+    if (is_timing_)
+    {
+      uint64_t end_cycles = CycleCount();
+      auto end_time       = Uptime();
+      time_ += end_time - start_time_;
+      cycles_ += end_cycles - start_cycles_;
+      is_timing_ = false;
+    }
+  }
+
+  /// Resume timing after PauseTiming().
+  void ResumeTiming()
+  {
+    if (!is_timing_)
+    {
+      is_timing_    = true;
+      start_time_   = Uptime();
+      start_cycles_ = CycleCount();
+    }
+  }
+
+  /// Set the number of bytes processed by each iteration, so that the
+  /// throughput can be reported.
+  void SetBytesPerIteration(uint64_t bytes)
+  {
+    bytes_per_iteration_ = bytes;
+  }
+
+  /// @return the number of times the measured loop will run.
+  uint64_t GetIterations() const
+  {
+    return iterations_;
+  }
+
+  /// @return the amount of time spent timing.
+  std::chrono::nanoseconds GetTime() const
+  {
+    return time_;
+  }
+
+  /// @return the number of cycles counted while timing.
+  uint64_t GetCycles() const
+  {
+    return cycles_;
+  }
+
+  /// @return the number of bytes processed by each iteration.
+  uint64_t GetBytesPerIteration() const
+  {
+    return bytes_per_iteration_;
+  }
+
+ private:
+  uint64_t iterations_;
+  uint64_t bytes_per_iteration_        = 0;
+  bool is_timing_                      = false;
+  std::chrono::nanoseconds start_time_ = 0ns;
+  std::chrono::nanoseconds time_       = 0ns;
+  uint64_t start_cycles_               = 0;
+  uint64_t cycles_                     = 0;
+};
+
+/// Signature of a benchmark function.
+using BenchmarkFunction = void (*)(State & state);
+
+/// A registered benchmark. Benchmarks form a linked list in the order that
+/// they were registered, so registration does not need any dynamic memory.
+class Benchmark
+{
+ public:
+  /// Register a benchmark. Use the BENCHMARK() macro rather than constructing
+  /// these directly.
+  ///
+  /// @param name - name of the benchmark.
+  /// @param function - function that runs the benchmark.
+  Benchmark(const char * name, BenchmarkFunction function)
+      : name_(name), function_(function)
+  {
+    if (Last() == nullptr)
+    {
+      First() = this;
+    }
+    else
+    {
+      Last()->next_ = this;
+    }
+    Last() = this;
+  }
+
+  /// @return the first registered benchmark, or nullptr if there are none.
+  static Benchmark *& First()
+  {
+    static Benchmark * first = nullptr;
+    return first;
+  }
+
+  /// @return the benchmark registered after this one.
+  Benchmark * Next() const
+  {
+    return next_;
+  }
+
+  /// @return the name of the benchmark.
+  const char * GetName() const
+  {
+    return name_;
+  }
+
+  /// Run the benchmark, growing the number of iterations until a run takes at
+  /// least settings.min_time.
+  ///
+  /// @param settings - settings controlling the length of the run.
+  /// @return the measurements from the final run.
+  Result_t Run(const Settings_t & settings) const
+  {
+    uint64_t iterations = 1;
+    while (true)
+    {
+      State state(iterations);
+      function_(state);
+      state.PauseTiming();
+
+      if (state.GetTime() >= settings.min_time ||
+          iterations >= settings.max_iterations)
+      {
+        return Result_t{
+          .name                = name_,
+          .iterations          = iterations,
+          .time                = state.GetTime(),
+          .cycles              = state.GetCycles(),
+          .bytes_per_iteration = state.GetBytesPerIteration(),
+        };
+      }
+
+      iterations = NextIterationCount(iterations, state.GetTime(), settings);
+    }
+  }
+
+ private:
+  static Benchmark *& Last()
+  {
+    static Benchmark * last = nullptr;
+    return last;
+  }
+
+  static uint64_t NextIterationCount(uint64_t iterations,
+                                     std::chrono::nanoseconds time,
+                                     const Settings_t & settings)
+  {
+    // Aim 40% past the minimum time, as short runs are noisy, but grow by at
+    // most 10x per run in case the previous run was unusually fast.
+    uint64_t next = iterations * 10;
+    if (time > 0ns)
+    {
+      double scale = 1.4 * static_cast<double>(settings.min_time.count()) /
+                     static_cast<double>(time.count());
+      next = std::min(next, static_cast<uint64_t>(
+                                static_cast<double>(iterations) * scale));
+    }
+    return std::clamp<uint64_t>(next, iterations + 1, settings.max_iterations);
+  }
+
+  const char * name_;
+  BenchmarkFunction function_;
+  Benchmark * next_ = nullptr;
+};
+
+/// Print the results of a benchmark in the given format.
+///
+/// @param result - benchmark results.
+/// @param format - format to print the results in.
+/// @param is_first - true if this is the first result being printed.
+inline void PrintResult(const Result_t & result, Format format, bool is_first)
+{
+  switch (format)
+  {
+    case Format::kConsole:
+      printf("%-40.40s %12" PRIu64 " %14.2f %14.2f %12.2f\n", result.name,
+             result.iterations, result.GetTimePerIteration(),
+             result.GetCyclesPerIteration(),
+             result.GetBytesPerSecond() / 1'000'000.0);
+      break;
+    case Format::kCsv:
+      printf("\"%s\",%" PRIu64 ",%.3f,%.3f,%.0f\n", result.name,
+             result.iterations, result.GetTimePerIteration(),
+             result.GetCyclesPerIteration(), result.GetBytesPerSecond());
+      break;
+    case Format::kJson:
+      printf("%s\n    {\n", is_first ? "" : ",");
+      printf("      \"name\": \"");
+      for (const char * c = result.name; *c != '\0'; c++)
+      {
+        if (*c == '"' || *c == '\\')
+        {
+          putchar('\\');
+        }
+        putchar(*c);
+      }
+      printf("\",\n");
+      printf("      \"iterations\": %" PRIu64 ",\n", result.iterations);
+      printf("      \"ns_per_iteration\": %.3f,\n",
+             result.GetTimePerIteration());
+      printf("      \"cycles_per_iteration\": %.3f,\n",
+             result.GetCyclesPerIteration());
+      printf("      \"bytes_per_second\": %.0f\n    }",
+             result.GetBytesPerSecond());
+      break;
+  }
+}
+
+/// Run every registered benchmark that matches the settings' filter and print
+/// the results.
+///
+/// @param settings - settings for the run.
+/// @return the number of benchmarks that were run.
+inline int RunAll(const Settings_t & settings = {})
+{
+  switch (settings.format)
+  {
+    case Format::kConsole:
+      printf("%-40s %12s %14s %14s %12s\n", "Benchmark", "Iterations",
+             "ns/iteration", "cycles/iter", "MB/s");
+      break;
+    case Format::kCsv:
+      printf("name,iterations,ns_per_iteration,cycles_per_iteration,"
+             "bytes_per_second\n");
+      break;
+    case Format::kJson: printf("{\n  \"benchmarks\": ["); break;
+  }
+
+  int count = 0;
+  for (const Benchmark * benchmark = Benchmark::First(); benchmark != nullptr;
+       benchmark                   = benchmark->Next())
+  {
+    if (settings.filter != nullptr &&
+        strstr(benchmark->GetName(), settings.filter) == nullptr)
+    {
+      continue;
+    }
+
+    PrintResult(benchmark->Run(settings), settings.format, count == 0);
+    count++;
+  }
+
+  if (settings.format == Format::kJson)
+  {
+    printf("\n  ]\n}\n");
+  }
+
+  return count;
+}
+}  // namespace benchmark
+}  // namespace sjsu
+
+#define SJ2_BENCHMARK_CONCAT_INNER(a, b) a##b
+#define SJ2_BENCHMARK_CONCAT(a, b) SJ2_BENCHMARK_CONCAT_INNER(a, b)
+#define SJ2_BENCHMARK_IMPL(name, function)                                 \
+  static void function(::sjsu::benchmark::State & state);                  \
+  static ::sjsu::benchmark::Benchmark SJ2_BENCHMARK_CONCAT(function,       \
+                                                           _registration)( \
+      name, function);                                                     \
+  static void function([[maybe_unused]] ::sjsu::benchmark::State & state)
+
+/// Define and register a benchmark. The body of the benchmark has access to a
+/// sjsu::benchmark::State object named `state`, and must run the code being
+/// measured inside of a `for (auto _ : state)` loop.
+///
+/// @param name - string name of the benchmark.
+#define BENCHMARK(name) \
+  SJ2_BENCHMARK_IMPL(name, SJ2_BENCHMARK_CONCAT(sj2_benchmark_, __LINE__))
@@ -0,0 +1,72 @@
+// Entry point for the host benchmark executable built by `make benchmark`.
+//
+// Options:
+//
+//    --format=console|csv|json   output format, console by default
+//    --filter=<text>             only run benchmarks whose name contains text
+//    --min-time=<milliseconds>   minimum duration of each measured run
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+#include "L4_Testing/benchmark.hpp"
+#include "utility/log.hpp"
+#include "utility/time.hpp"
+
+namespace
+{
+std::chrono::nanoseconds HostUptime()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch());
+}
+
+/// @return the value of the option if `argument` is `option=value`, otherwise
+///         nullptr.
+const char * OptionValue(const char * argument, const char * option)
+{
+  const size_t kLength = strlen(option);
+  if (strncmp(argument, option, kLength) == 0 && argument[kLength] == '=')
+  {
+    return &argument[kLength + 1];
+  }
+  return nullptr;
+}
+}  // namespace
+
+int main(int argc, char * argv[])
+{
+  sjsu::SetUptimeFunction(HostUptime);
+
+  sjsu::benchmark::Settings_t settings;
+  for (int i = 1; i < argc; i++)
+  {
+    if (const char * format = OptionValue(argv[i], "--format"))
+    {
+      if (strcmp(format, "csv") == 0)
+      {
+        settings.format = sjsu::benchmark::Format::kCsv;
+      }
+      else if (strcmp(format, "json") == 0)
+      {
+        settings.format = sjsu::benchmark::Format::kJson;
+      }
+    }
+    else if (const char * filter = OptionValue(argv[i], "--filter"))
+    {
+      settings.filter = filter;
+    }
+    else if (const char * min_time = OptionValue(argv[i], "--min-time"))
+    {
+      settings.min_time = std::chrono::milliseconds(atoi(min_time));
+    }
+    else
+    {
+      sjsu::LogError("Unknown benchmark option: %s", argv[i]);
+      return 1;
+    }
+  }
+
+  sjsu::benchmark::RunAll(settings);
+  return 0;
+}
@@ -25,6 +25,8 @@ DEFINE_FAKE_VOID_FUNC(vApplicationGetIdleTaskMemory,
                       uint32_t *);
 
 DEFINE_FAKE_VALUE_FUNC(TickType_t, xTaskGetTickCount);
+DEFINE_FAKE_VOID_FUNC(vTaskNotifyGiveFromISR, TaskHandle_t, BaseType_t *);
+DEFINE_FAKE_VALUE_FUNC(uint32_t, ulTaskNotifyTake, BaseType_t, TickType_t);
 DEFINE_FAKE_VALUE_FUNC(TaskHandle_t,
                        xTaskCreateStatic,
                        TaskFunction_t,
@@ -58,6 +60,11 @@ DEFINE_FAKE_VALUE_FUNC(BaseType_t,
                        const void *,
                        TickType_t,
                        BaseType_t);
+DEFINE_FAKE_VALUE_FUNC(BaseType_t,
+                       xQueueReceive,
+                       QueueHandle_t,
+                       void *,
+                       TickType_t);
 DEFINE_FAKE_VALUE_FUNC(BaseType_t,
                        xQueueSemaphoreTake,
                        QueueHandle_t,
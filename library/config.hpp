@@ -222,6 +222,49 @@ static_assert(1 <= kFatDriveCount && kFatDriveCount <= 10,
 /// Delcare Constant STORE_ERROR_MESSAGE
 SJ2_DECLARE_CONSTANT(STORE_ERROR_MESSAGE, bool, kStoreErrorMessages);
 
+/// If true, task switches, interrupts and SJ2_TRACE_SCOPE() spans are recorded
+/// into the trace recorder's ring buffer while it is running. Setting this to
+/// false removes every trace hook from the binary.
+#if !defined(SJ2_ENABLE_TRACE)
+#define SJ2_ENABLE_TRACE false
+#endif  // !defined(SJ2_ENABLE_TRACE)
+/// Delcare Constant ENABLE_TRACE
+SJ2_DECLARE_CONSTANT(ENABLE_TRACE, bool, kEnableTrace);
+
+/// Defines the number of events the trace recorder's ring buffer holds. Must be
+/// a power of two. Each event takes 16 bytes on 32-bit platforms.
+#if !defined(SJ2_TRACE_BUFFER_SIZE)
+#define SJ2_TRACE_BUFFER_SIZE 512
+#endif  // !defined(SJ2_TRACE_BUFFER_SIZE)
+/// Delcare Constant TRACE_BUFFER_SIZE
+SJ2_DECLARE_CONSTANT(TRACE_BUFFER_SIZE, size_t, kTraceBufferSize);
+static_assert((kTraceBufferSize & (kTraceBufferSize - 1)) == 0,
+              "SJ2_TRACE_BUFFER_SIZE must be a power of two.");
+
+/// Defines the number of unique addresses the sampling profiler can count. Must
+/// be a power of two. Each address takes 8 bytes on 32-bit platforms.
+#if !defined(SJ2_SAMPLING_PROFILER_SIZE)
+#define SJ2_SAMPLING_PROFILER_SIZE 256
+#endif  // !defined(SJ2_SAMPLING_PROFILER_SIZE)
+/// Delcare Constant SAMPLING_PROFILER_SIZE
+SJ2_DECLARE_CONSTANT(SAMPLING_PROFILER_SIZE, size_t, kSamplingProfilerSize);
+
+/// Defines the number of received CAN messages that an interrupt driven CAN
+/// driver can hold before Receive() is called. Must be a power of two.
+#if !defined(SJ2_CAN_RECEIVE_QUEUE_SIZE)
+#define SJ2_CAN_RECEIVE_QUEUE_SIZE 32
+#endif  // !defined(SJ2_CAN_RECEIVE_QUEUE_SIZE)
+/// Delcare Constant CAN_RECEIVE_QUEUE_SIZE
+SJ2_DECLARE_CONSTANT(CAN_RECEIVE_QUEUE_SIZE, size_t, kCanReceiveQueueSize);
+
+/// Defines the number of CAN messages that an interrupt driven CAN driver can
+/// hold in its transmit priority queue. Must be a power of two.
+#if !defined(SJ2_CAN_TRANSMIT_QUEUE_SIZE)
+#define SJ2_CAN_TRANSMIT_QUEUE_SIZE 16
+#endif  // !defined(SJ2_CAN_TRANSMIT_QUEUE_SIZE)
+/// Delcare Constant CAN_TRANSMIT_QUEUE_SIZE
+SJ2_DECLARE_CONSTANT(CAN_TRANSMIT_QUEUE_SIZE, size_t, kCanTransmitQueueSize);
+
 /// Enable or disable float support in printf statements. Setting to false will
 /// reduce binary size.
 #if !defined(SJ2_PRINTF_BUFFER_SIZE)
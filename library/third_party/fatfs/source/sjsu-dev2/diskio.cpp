@@ -2,6 +2,7 @@
 #include <ff.h>
 #include <ffconf.h>
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <tuple>
@@ -190,9 +191,41 @@ extern "C" DRESULT disk_write(BYTE drive_number,
 }
 
 // NOLINTNEXTLINE
-extern "C" DRESULT disk_ioctl([[maybe_unused]] BYTE drive_number,
-                              [[maybe_unused]] BYTE command,
-                              [[maybe_unused]] void * buffer)
+extern "C" DRESULT disk_ioctl(BYTE drive_number, BYTE command, void * buffer)
 {
-  return RES_PARERR;
+  if (drive_number >= drive.size())
+  {
+    return RES_PARERR;
+  }
+
+  // Get a reference for the storage drive
+  auto & storage = drive[drive_number];
+
+  switch (command)
+  {
+    // Storage::Write() does not return until the data has been written to the
+    // media, thus there is never any cached data to flush.
+    case CTRL_SYNC: return RES_OK;
+    // Used by f_mkfs() to determine the size of the volume.
+    case GET_SECTOR_COUNT:
+    {
+      auto capacity = storage.media->GetCapacity().to<uint64_t>();
+      *reinterpret_cast<DWORD *>(buffer) =
+          static_cast<DWORD>(capacity / FF_MIN_SS);
+      return RES_OK;
+    }
+    case GET_SECTOR_SIZE:
+      *reinterpret_cast<WORD *>(buffer) = FF_MIN_SS;
+      return RES_OK;
+    // Used by f_mkfs() to align the data area to the erase block size of the
+    // media, in units of sectors.
+    case GET_BLOCK_SIZE:
+    {
+      auto block_size = storage.media->GetBlockSize().to<uint32_t>();
+      *reinterpret_cast<DWORD *>(buffer) =
+          std::max<DWORD>(1, block_size / FF_MIN_SS);
+      return RES_OK;
+    }
+    default: return RES_PARERR;
+  }
 }
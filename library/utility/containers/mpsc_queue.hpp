@@ -0,0 +1,145 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace sjsu
+{
+/// A bounded, lock-free, multiple producer single consumer queue.
+///
+/// Any number of interrupt service routines and tasks may Push() concurrently,
+/// including interrupts that preempt each other, while a single task or main
+/// loop calls Pop(). Neither operation disables interrupts or blocks.
+///
+/// Each slot holds a sequence number that tells producers and the consumer
+/// whether the slot is free or full, so a producer only needs a single
+/// compare-and-swap to claim a slot. A producer that is preempted between
+/// claiming a slot and filling it hides the items queued after it from the
+/// consumer until it resumes. For interrupt producers this is never longer
+/// than the preempting interrupt.
+///
+/// @tparam T - type of the items to queue. Must be copy assignable.
+/// @tparam kCapacity - maximum number of items in the queue. Must be a power
+///         of two.
+template <typename T, size_t kCapacity>
+class MpscQueue
+{
+ public:
+  static_assert(kCapacity >= 2 && (kCapacity & (kCapacity - 1)) == 0,
+                "MpscQueue capacity must be a power of two.");
+  static_assert(std::atomic<uint32_t>::is_always_lock_free,
+                "MpscQueue requires lock-free 32-bit atomics.");
+
+  MpscQueue()
+  {
+    for (uint32_t i = 0; i < kCapacity; i++)
+    {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  /// Add an item to the back of the queue. Safe to call from any interrupt or
+  /// task.
+  ///
+  /// @param item - item to copy into the queue.
+  /// @return false if the queue is full and the item was not added.
+  bool Push(const T & item)
+  {
+    Cell_t * cell     = nullptr;
+    uint32_t position = enqueue_position_.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+      cell               = &cells_[position & kMask];
+      uint32_t sequence  = cell->sequence.load(std::memory_order_acquire);
+      int32_t difference = static_cast<int32_t>(sequence - position);
+
+      if (difference == 0)
+      {
+        // The slot is free, attempt to claim it. On failure, position is
+        // updated with the latest enqueue position.
+        if (enqueue_position_.compare_exchange_weak(
+                position, position + 1, std::memory_order_relaxed))
+        {
+          break;
+        }
+      }
+      else if (difference < 0)
+      {
+        // The consumer has not yet emptied this slot, so the queue is full.
+        return false;
+      }
+      else
+      {
+        // Another producer claimed this slot first.
+        position = enqueue_position_.load(std::memory_order_relaxed);
+      }
+    }
+
+    cell->item = item;
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Remove the item at the front of the queue. Must only be called by the
+  /// single consumer.
+  ///
+  /// @param item - item to copy the front of the queue into.
+  /// @return false if the queue is empty and item was not modified.
+  bool Pop(T & item)
+  {
+    uint32_t position = dequeue_position_.load(std::memory_order_relaxed);
+    Cell_t & cell     = cells_[position & kMask];
+    uint32_t sequence = cell.sequence.load(std::memory_order_acquire);
+
+    if (static_cast<int32_t>(sequence - (position + 1)) < 0)
+    {
+      return false;
+    }
+
+    item = cell.item;
+    cell.sequence.store(position + kCapacity, std::memory_order_release);
+    dequeue_position_.store(position + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /// @return the number of items in the queue. Only a snapshot, as producers
+  ///         and the consumer may change it at any time.
+  size_t Size() const
+  {
+    // Read the consumer's position first, as it can never pass the producers'.
+    uint32_t dequeue = dequeue_position_.load(std::memory_order_relaxed);
+    uint32_t enqueue = enqueue_position_.load(std::memory_order_relaxed);
+    return enqueue - dequeue;
+  }
+
+  /// @return true if the queue holds no items.
+  bool IsEmpty() const
+  {
+    return Size() == 0;
+  }
+
+  /// @return the maximum number of items the queue can hold.
+  static constexpr size_t Capacity()
+  {
+    return kCapacity;
+  }
+
+ private:
+  static constexpr uint32_t kMask = kCapacity - 1;
+
+  /// A slot of the queue. The sequence number is equal to the slot's position
+  /// when it is free, and one more than its position once an item is in it.
+  struct Cell_t
+  {
+    std::atomic<uint32_t> sequence;
+    T item;
+  };
+
+  std::array<Cell_t, kCapacity> cells_;
+  std::atomic<uint32_t> enqueue_position_ = 0;
+  std::atomic<uint32_t> dequeue_position_ = 0;
+};
+}  // namespace sjsu
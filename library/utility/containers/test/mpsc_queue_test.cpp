@@ -0,0 +1,89 @@
+#include <cstdint>
+
+#include "L4_Testing/testing_frameworks.hpp"
+#include "utility/containers/mpsc_queue.hpp"
+
+namespace sjsu
+{
+TEST_CASE("Testing MpscQueue")
+{
+  MpscQueue<uint32_t, 4> test_subject;
+
+  SECTION("Starts empty")
+  {
+    // Setup
+    uint32_t item = 0xDEAD;
+
+    // Exercise & Verify
+    CHECK(test_subject.IsEmpty());
+    CHECK(0 == test_subject.Size());
+    CHECK(4 == test_subject.Capacity());
+    CHECK(!test_subject.Pop(item));
+    CHECK(0xDEAD == item);
+  }
+
+  SECTION("Pops items in the order they were pushed")
+  {
+    // Setup
+    uint32_t item = 0;
+
+    // Exercise
+    CHECK(test_subject.Push(1));
+    CHECK(test_subject.Push(2));
+    CHECK(test_subject.Push(3));
+
+    // Verify
+    CHECK(3 == test_subject.Size());
+    CHECK(test_subject.Pop(item));
+    CHECK(1 == item);
+    CHECK(test_subject.Pop(item));
+    CHECK(2 == item);
+    CHECK(test_subject.Pop(item));
+    CHECK(3 == item);
+    CHECK(test_subject.IsEmpty());
+  }
+
+  SECTION("Rejects items when full")
+  {
+    // Setup
+    uint32_t item = 0;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+      CHECK(test_subject.Push(i));
+    }
+
+    // Exercise & Verify
+    CHECK(!test_subject.Push(4));
+    CHECK(4 == test_subject.Size());
+
+    CHECK(test_subject.Pop(item));
+    CHECK(0 == item);
+    CHECK(test_subject.Push(4));
+  }
+
+  SECTION("Wraps around many times")
+  {
+    // Setup
+    uint32_t item     = 0;
+    uint32_t expected = 0;
+
+    // Exercise & Verify
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+      CHECK(test_subject.Push(i));
+      if (i % 3 == 2)
+      {
+        while (test_subject.Pop(item))
+        {
+          CHECK(expected++ == item);
+        }
+      }
+    }
+    while (test_subject.Pop(item))
+    {
+      CHECK(expected++ == item);
+    }
+    CHECK(1000 == expected);
+  }
+}
+}  // namespace sjsu
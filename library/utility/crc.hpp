@@ -37,7 +37,7 @@ constexpr static CrcTableConfig_t<T> GenerateCrc7Table()
   CrcTableConfig_t<T> crc_table = CrcTableConfig_t<T>();
   size_t i = 0, j = 0;
   // generate a table value for all 256 possible byte values
-  for (i = 0; i < 0xFF; i++)
+  for (i = 0; i < crc_table.kTableSize; i++)
   {
     bool most_significant_bit_set = static_cast<bool>(i & 0x80);
     uint8_t polynomial_compare = static_cast<uint8_t>(i) ^ crc_table.kPoly8bit;
@@ -0,0 +1,164 @@
+// Usage:
+//
+//    sjsu::Delegate<void()> callback = [this]() { counter_++; };
+//    callback();
+//
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__cpp_exceptions)
+#include <functional>
+#endif
+
+namespace sjsu
+{
+/// Primary template of Delegate. Only the function signature specialization
+/// below is defined.
+template <typename Signature, size_t kCapacity = 2 * sizeof(void *)>
+class Delegate;
+
+/// A fixed size, non-allocating replacement for std::function that is safe to
+/// construct, copy and call from within an interrupt service routine.
+///
+/// The callable is stored inside of the delegate along with a pointer to a
+/// function that knows how to call it. Calling a delegate is a single indirect
+/// call and copying one is a memcpy of a few words. In order to make this
+/// possible, callables must:
+///
+///   1. Fit within kCapacity bytes. By default this is enough for a function
+///      pointer, or a lambda that captures `this` and one more pointer or
+///      reference.
+///   2. Be trivially copyable. Lambdas that only capture pointers, references
+///      and integers are trivially copyable. Lambdas that capture a
+///      std::function or other owning objects by value are not.
+///
+/// Both rules are checked at compile time.
+///
+/// @tparam ReturnType - return type of the callable.
+/// @tparam Args - argument types of the callable.
+/// @tparam kCapacity - number of bytes reserved to store the callable.
+template <typename ReturnType, typename... Args, size_t kCapacity>
+class Delegate<ReturnType(Args...), kCapacity>
+{
+ public:
+  /// Construct an empty delegate. Calling an empty delegate throws
+  /// std::bad_function_call on the host and aborts on targets without
+  /// exceptions.
+  constexpr Delegate() = default;
+
+  /// Construct an empty delegate. Allows delegates to be set to nullptr.
+  constexpr Delegate(std::nullptr_t) {}  // NOLINT
+
+  /// Construct a delegate that calls a copy of `callable`.
+  ///
+  /// @param callable - function pointer, lambda or function object to store.
+  template <typename Callable,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<Callable>, Delegate> &&
+                std::is_invocable_r_v<ReturnType, Callable &, Args...>>>
+  Delegate(Callable callable)  // NOLINT
+  {
+    static_assert(sizeof(Callable) <= kCapacity,
+                  "Callable is too large to be stored in this Delegate. "
+                  "Capture fewer variables, capture a pointer to a structure "
+                  "holding them, or increase the Delegate's capacity.");
+    static_assert(alignof(Callable) <= alignof(void *),
+                  "Callable requires a stricter alignment than this Delegate "
+                  "provides.");
+    static_assert(std::is_trivially_copyable_v<Callable>,
+                  "Delegates are copied with memcpy so their callables must "
+                  "be trivially copyable. Capture by reference or pointer "
+                  "instead of by value.");
+
+    new (storage_.data()) Callable(callable);
+    invoker_ = &Invoke<Callable>;
+  }
+
+  /// Call the stored callable.
+  ReturnType operator()(Args... args) const
+  {
+    return invoker_(storage_.data(), std::forward<Args>(args)...);
+  }
+
+  /// @return true if this delegate holds a callable.
+  explicit operator bool() const
+  {
+    return invoker_ != &InvokeEmpty;
+  }
+
+  /// @tparam Callable - the type of callable that is expected to be stored.
+  /// @return a pointer to the stored callable if it is of type `Callable`,
+  ///         otherwise nullptr. Unlike std::function::target(), this does not
+  ///         require RTTI.
+  template <typename Callable>
+  const Callable * Target() const
+  {
+    if (invoker_ != &Invoke<Callable>)
+    {
+      return nullptr;
+    }
+    return std::launder(reinterpret_cast<const Callable *>(storage_.data()));
+  }
+
+  /// @return true if `delegate` is empty.
+  friend bool operator==(const Delegate & delegate, std::nullptr_t)
+  {
+    return !delegate;
+  }
+
+  /// @return true if `delegate` is empty.
+  friend bool operator==(std::nullptr_t, const Delegate & delegate)
+  {
+    return !delegate;
+  }
+
+  /// @return true if `delegate` holds a callable.
+  friend bool operator!=(const Delegate & delegate, std::nullptr_t)
+  {
+    return static_cast<bool>(delegate);
+  }
+
+  /// @return true if `delegate` holds a callable.
+  friend bool operator!=(std::nullptr_t, const Delegate & delegate)
+  {
+    return static_cast<bool>(delegate);
+  }
+
+ private:
+  using Invoker = ReturnType (*)(std::byte * storage, Args... args);
+
+  template <typename Callable>
+  static ReturnType Invoke(std::byte * storage, Args... args)
+  {
+    Callable & callable = *std::launder(reinterpret_cast<Callable *>(storage));
+    if constexpr (std::is_void_v<ReturnType>)
+    {
+      callable(std::forward<Args>(args)...);
+    }
+    else
+    {
+      return callable(std::forward<Args>(args)...);
+    }
+  }
+
+  [[noreturn]] static ReturnType InvokeEmpty(std::byte *, Args...)
+  {
+#if defined(__cpp_exceptions)
+    throw std::bad_function_call();
+#else
+    std::abort();
+#endif
+  }
+
+  /// Function that casts storage_ back into the stored callable and calls it.
+  Invoker invoker_ = &InvokeEmpty;
+  /// Holds a copy of the callable.
+  alignas(void *) mutable std::array<std::byte, kCapacity> storage_ = {};
+};
+}  // namespace sjsu
@@ -0,0 +1,274 @@
+// Usage:
+//
+//    sjsu::LatencyRecorder spi_latency("spi");
+//    spi_latency.Calibrate();
+//
+//    for (int i = 0; i < 1000; i++)
+//    {
+//      spi_latency.Start();
+//      spi.Transfer(0xAA);
+//      spi_latency.Stop();
+//    }
+//
+//    spi_latency.Print();
+//
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+
+#include "utility/stopwatch.hpp"
+#include "utility/time.hpp"
+
+namespace sjsu
+{
+/// Records a distribution of durations, such as the latency of a driver call,
+/// in a fixed amount of memory and answers min, max, mean and percentile
+/// queries about it.
+///
+/// Durations are counted in a log-linear histogram (like HdrHistogram): each
+/// power of two range of nanoseconds is split into kSubBuckets equally sized
+/// buckets. This keeps the relative error of every reported value below
+/// 1/kSubBuckets while using the same amount of memory to track 1us as it does
+/// to track 1s. Durations shorter than 2 * kSubBuckets nanoseconds are counted
+/// exactly. Durations longer than kMaxTrackable are counted in the last bucket,
+/// but are still reported exactly by GetMax().
+///
+/// Recording is not thread safe. Give each task its own recorder and Merge()
+/// them when reporting.
+class LatencyRecorder
+{
+ public:
+  /// Number of bits of each duration that are kept in its bucket index.
+  static constexpr uint32_t kSubBucketBits = 4;
+  /// Number of buckets each power of two range of durations is split into.
+  static constexpr uint32_t kSubBuckets = 1 << kSubBucketBits;
+  /// Longest duration that is counted in its own bucket, ~4.3 seconds.
+  static constexpr std::chrono::nanoseconds kMaxTrackable =
+      std::chrono::nanoseconds(std::numeric_limits<uint32_t>::max());
+  /// Total number of buckets needed to cover 0ns to kMaxTrackable.
+  static constexpr size_t kBucketCount =
+      (32 - kSubBucketBits + 1) * kSubBuckets;
+
+  /// @param name - name used to identify this recorder when it is printed.
+  explicit constexpr LatencyRecorder(const char * name) : name_(name) {}
+
+  /// @return the name of this recorder.
+  const char * GetName() const
+  {
+    return name_;
+  }
+
+  /// Calibrates the underlying stopwatch, so that the time it takes to call
+  /// Start() and Stop() is not recorded. See StopWatch::Calibrate().
+  void Calibrate()
+  {
+    stopwatch_.Calibrate();
+  }
+
+  /// Start timing a new event.
+  void Start()
+  {
+    stopwatch_.Start();
+  }
+
+  /// Stop timing the event started by Start() and record its duration.
+  ///
+  /// @return the duration of the event.
+  std::chrono::nanoseconds Stop()
+  {
+    auto duration = stopwatch_.Stop();
+    Record(duration);
+    return duration;
+  }
+
+  /// Record a duration that was measured elsewhere. Negative durations, which
+  /// can occur after calibration, are recorded as 0ns.
+  void Record(std::chrono::nanoseconds duration)
+  {
+    uint64_t nanoseconds =
+        static_cast<uint64_t>(std::max(duration, 0ns).count());
+
+    buckets_[BucketIndex(nanoseconds)]++;
+    count_++;
+    sum_ += nanoseconds;
+    min_ = std::min(min_, nanoseconds);
+    max_ = std::max(max_, nanoseconds);
+  }
+
+  /// Add all of the durations recorded by another recorder to this one.
+  void Merge(const LatencyRecorder & other)
+  {
+    for (size_t i = 0; i < buckets_.size(); i++)
+    {
+      buckets_[i] += other.buckets_[i];
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+  }
+
+  /// Clear all recorded durations.
+  void Reset()
+  {
+    buckets_.fill(0);
+    count_ = 0;
+    sum_   = 0;
+    min_   = std::numeric_limits<uint64_t>::max();
+    max_   = 0;
+  }
+
+  /// @return the number of durations recorded.
+  uint32_t GetCount() const
+  {
+    return count_;
+  }
+
+  /// @return the shortest recorded duration, or 0ns if nothing was recorded.
+  std::chrono::nanoseconds GetMin() const
+  {
+    return (count_ == 0) ? 0ns : std::chrono::nanoseconds(min_);
+  }
+
+  /// @return the longest recorded duration, or 0ns if nothing was recorded.
+  std::chrono::nanoseconds GetMax() const
+  {
+    return std::chrono::nanoseconds(max_);
+  }
+
+  /// @return the mean of the recorded durations, or 0ns if nothing was
+  ///         recorded.
+  std::chrono::nanoseconds GetMean() const
+  {
+    return (count_ == 0) ? 0ns : std::chrono::nanoseconds(sum_ / count_);
+  }
+
+  /// @param percentile - percentage of durations, from 0 to 100, that should
+  ///        be less than or equal to the returned value. For example, 99.9
+  ///        returns the 99.9th percentile.
+  /// @return the duration at the given percentile, rounded up to the end of
+  ///         its bucket, or 0ns if nothing was recorded.
+  std::chrono::nanoseconds GetPercentile(float percentile) const
+  {
+    if (count_ == 0)
+    {
+      return 0ns;
+    }
+
+    percentile = std::clamp(percentile, 0.0f, 100.0f);
+    uint32_t target = static_cast<uint32_t>(
+        std::ceil((percentile / 100.0f) * static_cast<float>(count_)));
+    target = std::clamp<uint32_t>(target, 1, count_);
+
+    // The first and last ranks are known exactly.
+    if (target == 1)
+    {
+      return GetMin();
+    }
+    if (target == count_)
+    {
+      return GetMax();
+    }
+
+    uint32_t cumulative = 0;
+    size_t index        = 0;
+    for (; index < buckets_.size(); index++)
+    {
+      cumulative += buckets_[index];
+      if (cumulative >= target)
+      {
+        break;
+      }
+    }
+
+    uint64_t highest = BucketLowerBound(index) + BucketWidth(index) - 1;
+    return std::chrono::nanoseconds(std::clamp(highest, min_, max_));
+  }
+
+  /// @return the number of durations counted in each bucket.
+  const std::array<uint32_t, kBucketCount> & GetBuckets() const
+  {
+    return buckets_;
+  }
+
+  /// @return the bucket that a duration of `nanoseconds` is counted in.
+  static constexpr size_t BucketIndex(uint64_t nanoseconds)
+  {
+    uint32_t value = static_cast<uint32_t>(
+        std::min<uint64_t>(nanoseconds, kMaxTrackable.count()));
+
+    if (value < kSubBuckets)
+    {
+      return value;
+    }
+
+    uint32_t magnitude = 31 - __builtin_clz(value);
+    uint32_t shift     = magnitude - kSubBucketBits;
+    uint32_t sub_index = (value >> shift) & (kSubBuckets - 1);
+    return ((shift + 1) * kSubBuckets) + sub_index;
+  }
+
+  /// @return the shortest duration in nanoseconds counted in bucket `index`.
+  static constexpr uint64_t BucketLowerBound(size_t index)
+  {
+    if (index < kSubBuckets)
+    {
+      return index;
+    }
+
+    uint64_t shift     = (index / kSubBuckets) - 1;
+    uint64_t sub_index = index % kSubBuckets;
+    return (kSubBuckets + sub_index) << shift;
+  }
+
+  /// @return the number of distinct nanosecond durations counted in bucket
+  ///         `index`.
+  static constexpr uint64_t BucketWidth(size_t index)
+  {
+    if (index < kSubBuckets)
+    {
+      return 1;
+    }
+    return uint64_t{ 1 } << ((index / kSubBuckets) - 1);
+  }
+
+  /// Print a table header that lines up with the output of Print().
+  static void PrintHeader()
+  {
+    printf("%-16s %10s %10s %10s %10s %10s %10s %10s\n", "name", "count",
+           "min(us)", "mean(us)", "p50(us)", "p99(us)", "p99.9(us)",
+           "max(us)");
+  }
+
+  /// Print a one line summary of the recorded durations in microseconds.
+  void Print() const
+  {
+    printf("%-16.16s %10" PRIu32 " %10.3f %10.3f %10.3f %10.3f %10.3f %10.3f\n",
+           name_, count_, ToMicroseconds(GetMin()), ToMicroseconds(GetMean()),
+           ToMicroseconds(GetPercentile(50)), ToMicroseconds(GetPercentile(99)),
+           ToMicroseconds(GetPercentile(99.9f)), ToMicroseconds(GetMax()));
+  }
+
+ private:
+  static double ToMicroseconds(std::chrono::nanoseconds duration)
+  {
+    return static_cast<double>(duration.count()) / 1000.0;
+  }
+
+  const char * name_;
+  StopWatch stopwatch_;
+  std::array<uint32_t, kBucketCount> buckets_ = {};
+  uint32_t count_                             = 0;
+  uint64_t sum_                               = 0;
+  uint64_t min_ = std::numeric_limits<uint64_t>::max();
+  uint64_t max_ = 0;
+};
+}  // namespace sjsu
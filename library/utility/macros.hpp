@@ -28,6 +28,13 @@
 #define SJ2_STRINGIFY(s) SJ2_STRINGIFY2(s)
 /// Helper macro for stringifying an expression
 #define SJ2_STRINGIFY2(s) #s
+/// Concatenate two tokens after expanding them. For example:
+///
+///      SJ2_CONCAT(variable_, __LINE__) => variable_42
+///
+#define SJ2_CONCAT(a, b) SJ2_CONCAT2(a, b)
+/// Helper macro for concatenating tokens
+#define SJ2_CONCAT2(a, b) a##b
 /// SJ2_PACKED give a specified type a packed attribute
 #define SJ2_PACKED(type) type [[gnu::packed]]
 /// Set a function as a "weak" function. This means that if there is another
@@ -23,6 +23,8 @@ DECLARE_FAKE_VOID_FUNC(vApplicationGetIdleTaskMemory,
                        uint32_t *);
 
 DECLARE_FAKE_VALUE_FUNC(TickType_t, xTaskGetTickCount);
+DECLARE_FAKE_VOID_FUNC(vTaskNotifyGiveFromISR, TaskHandle_t, BaseType_t *);
+DECLARE_FAKE_VALUE_FUNC(uint32_t, ulTaskNotifyTake, BaseType_t, TickType_t);
 DECLARE_FAKE_VALUE_FUNC(TaskHandle_t,
                         xTaskCreateStatic,
                         TaskFunction_t,
@@ -56,6 +58,11 @@ DECLARE_FAKE_VALUE_FUNC(BaseType_t,
                         const void *,
                         TickType_t,
                         BaseType_t);
+DECLARE_FAKE_VALUE_FUNC(BaseType_t,
+                        xQueueReceive,
+                        QueueHandle_t,
+                        void *,
+                        TickType_t);
 DECLARE_FAKE_VALUE_FUNC(BaseType_t,
                         xQueueSemaphoreTake,
                         QueueHandle_t,
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <array>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include "utility/ansi_terminal_codes.hpp"
+
+namespace sjsu
+{
+/// Counts how many times each address was sampled, in a fixed size hash table.
+/// Used by sampling profilers to find the instructions a program spends the
+/// most time in.
+///
+/// Record() is meant to be called by a single interrupt or signal handler and
+/// never allocates, blocks or loops more than kMaxProbes times. Samples of new
+/// addresses that do not fit in the table are counted as dropped.
+///
+/// @tparam kCapacity - maximum number of unique addresses. Must be a power of
+///         two.
+template <size_t kCapacity>
+class SampleTable
+{
+ public:
+  static_assert(kCapacity >= 2 && (kCapacity & (kCapacity - 1)) == 0,
+                "SampleTable capacity must be a power of two.");
+
+  /// Most slots searched for an address before its sample is dropped.
+  static constexpr size_t kMaxProbes = (kCapacity < 16) ? kCapacity : 16;
+
+  /// A sampled address and the number of times it was sampled.
+  struct Entry_t
+  {
+    /// Sampled address.
+    uintptr_t address = 0;
+    /// Number of samples of the address. Zero if the slot is unused.
+    uint32_t count = 0;
+  };
+
+  /// Count a sample of an address.
+  ///
+  /// @param address - sampled address, such as an interrupted program counter.
+  /// @return false if the table is too full to hold the address and the sample
+  ///         was dropped.
+  bool Record(uintptr_t address)
+  {
+    total_++;
+
+    size_t slot = Hash(address);
+    for (size_t probe = 0; probe < kMaxProbes; probe++)
+    {
+      Entry_t & entry = entries_[slot];
+      if (entry.count == 0)
+      {
+        entry.address = address;
+        entry.count   = 1;
+        unique_++;
+        return true;
+      }
+      if (entry.address == address)
+      {
+        entry.count++;
+        return true;
+      }
+      slot = (slot + 1) & kMask;
+    }
+
+    dropped_++;
+    return false;
+  }
+
+  /// Discard every sample.
+  void Clear()
+  {
+    entries_ = {};
+    total_   = 0;
+    dropped_ = 0;
+    unique_  = 0;
+  }
+
+  /// @return the number of samples recorded, including dropped samples.
+  uint32_t GetTotal() const
+  {
+    return total_;
+  }
+
+  /// @return the number of samples dropped because the table was full.
+  uint32_t GetDropped() const
+  {
+    return dropped_;
+  }
+
+  /// @return the number of unique addresses in the table.
+  size_t GetUniqueCount() const
+  {
+    return unique_;
+  }
+
+  /// @param address - address to look up.
+  /// @return the number of samples of the address.
+  uint32_t GetCount(uintptr_t address) const
+  {
+    size_t slot = Hash(address);
+    for (size_t probe = 0; probe < kMaxProbes; probe++)
+    {
+      const Entry_t & entry = entries_[slot];
+      if (entry.count == 0)
+      {
+        break;
+      }
+      if (entry.address == address)
+      {
+        return entry.count;
+      }
+      slot = (slot + 1) & kMask;
+    }
+    return 0;
+  }
+
+  /// Find the most sampled addresses, ordered by number of samples.
+  ///
+  /// @param rank - position in the ranking, where 0 is the most sampled.
+  /// @return the entry at that rank, or an entry with a count of zero if there
+  ///         are not that many unique addresses.
+  Entry_t GetTop(size_t rank) const
+  {
+    Entry_t previous = { .address = 0, .count = UINT32_MAX };
+    Entry_t best     = {};
+
+    for (size_t i = 0; i <= rank; i++)
+    {
+      best = {};
+      for (const Entry_t & entry : entries_)
+      {
+        if (IsRankedBefore(entry, best) && IsRankedBefore(previous, entry))
+        {
+          best = entry;
+        }
+      }
+      if (best.count == 0)
+      {
+        break;
+      }
+      previous = best;
+    }
+
+    return best;
+  }
+
+  /// Print the most sampled addresses and the command that translates them
+  /// into function names and line numbers with the firmware's ELF file.
+  ///
+  /// @param top - number of addresses to print.
+  void Print(size_t top = 20) const
+  {
+    printf("Samples: %" PRIu32 ", dropped: %" PRIu32 ", unique: %zu\n", total_,
+           dropped_, unique_);
+    printf("%5s %10s %10s %8s\n", "rank", "address", "samples", "percent");
+
+    for (size_t rank = 0; rank < top; rank++)
+    {
+      Entry_t entry = GetTop(rank);
+      if (entry.count == 0)
+      {
+        break;
+      }
+      uint32_t permille = static_cast<uint32_t>(
+          (uint64_t{ entry.count } * 1000) / total_);
+      printf("%5zu 0x%08" PRIXPTR " %10" PRIu32 " %5" PRIu32 ".%" PRIu32
+             "%%\n",
+             rank + 1, entry.address, entry.count, permille / 10,
+             permille % 10);
+    }
+
+    if (unique_ == 0)
+    {
+      return;
+    }
+
+    printf("\nRun: the following command in your project directory");
+    printf("\n\n  " SJ2_BOLD_WHITE "make stacktrace TRACES=\"");
+    for (size_t rank = 0; rank < top; rank++)
+    {
+      Entry_t entry = GetTop(rank);
+      if (entry.count == 0)
+      {
+        break;
+      }
+      printf("0x%08" PRIXPTR " ", entry.address);
+    }
+    printf("\"\n\n" SJ2_COLOR_RESET);
+    printf("This will report the function and line number of each address.\n");
+  }
+
+ private:
+  static constexpr size_t kMask = kCapacity - 1;
+  static constexpr uint32_t kHashShift =
+      32 - static_cast<uint32_t>(__builtin_ctzll(kCapacity));
+
+  static size_t Hash(uintptr_t address)
+  {
+    // Instructions are at least 2 byte aligned, so drop the lowest bit, then
+    // spread neighbouring addresses across the table with Knuth's
+    // multiplicative hash, which keeps its best mixed bits at the top.
+    uint32_t key = static_cast<uint32_t>(address >> 1);
+    return static_cast<size_t>((key * 2654435761U) >> kHashShift);
+  }
+
+  /// @return true if a is ranked before b: more samples first, then lower
+  ///         addresses first.
+  static bool IsRankedBefore(const Entry_t & a, const Entry_t & b)
+  {
+    if (a.count != b.count)
+    {
+      return a.count > b.count;
+    }
+    return a.address < b.address;
+  }
+
+  std::array<Entry_t, kCapacity> entries_ = {};
+  uint32_t total_                         = 0;
+  uint32_t dropped_                       = 0;
+  size_t unique_                          = 0;
+};
+}  // namespace sjsu
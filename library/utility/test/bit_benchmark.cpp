@@ -0,0 +1,48 @@
+#include <array>
+#include <cstdint>
+
+#include "L4_Testing/benchmark.hpp"
+#include "utility/bit.hpp"
+
+namespace sjsu
+{
+BENCHMARK("bit::Extract() 32-bit")
+{
+  uint32_t register_value = 0xDEAD'BEEF;
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(register_value);
+    benchmark::DoNotOptimize(bit::Extract(register_value, 4, 12));
+  }
+}
+
+BENCHMARK("bit::Insert() 32-bit")
+{
+  uint32_t register_value = 0;
+  uint32_t field          = 0xABC;
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(field);
+    register_value = bit::Insert(register_value, field, 8, 12);
+    benchmark::DoNotOptimize(register_value);
+  }
+}
+
+BENCHMARK("bit::StreamExtract() 1kB")
+{
+  std::array<uint8_t, 1024> stream = {};
+  state.SetBytesPerIteration(stream.size());
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(stream);
+    for (uint32_t i = 0; i < stream.size() * 8; i += 32)
+    {
+      benchmark::DoNotOptimize(bit::StreamExtract<uint32_t>(
+          stream.data(), stream.size(), bit::MaskFromRange(i, i + 31)));
+    }
+  }
+}
+}  // namespace sjsu
@@ -0,0 +1,146 @@
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+
+#include "L4_Testing/testing_frameworks.hpp"
+#include "utility/delegate.hpp"
+
+namespace sjsu
+{
+namespace
+{
+int free_function_calls = 0;
+
+void FreeFunction()
+{
+  free_function_calls++;
+}
+
+int Add(int a, int b)
+{
+  return a + b;
+}
+}  // namespace
+
+TEST_CASE("Testing Delegate")
+{
+  SECTION("Is trivially copyable and no larger than needed")
+  {
+    // Verify
+    static_assert(std::is_trivially_copyable_v<Delegate<void()>>);
+    static_assert(std::is_trivially_destructible_v<Delegate<void()>>);
+    static_assert(sizeof(Delegate<void()>) == 3 * sizeof(void *));
+  }
+
+  SECTION("Default and nullptr construction are empty")
+  {
+    // Setup
+    Delegate<void()> default_constructed;
+    Delegate<void()> null_constructed = nullptr;
+
+    // Verify
+    CHECK(!default_constructed);
+    CHECK(default_constructed == nullptr);
+    CHECK(nullptr == null_constructed);
+    CHECK_THROWS_AS(default_constructed(), std::bad_function_call);
+  }
+
+  SECTION("Calls a free function")
+  {
+    // Setup
+    free_function_calls           = 0;
+    Delegate<void()> test_subject = FreeFunction;
+
+    // Exercise
+    test_subject();
+    test_subject();
+
+    // Verify
+    CHECK(test_subject != nullptr);
+    CHECK(2 == free_function_calls);
+  }
+
+  SECTION("Passes arguments and returns values")
+  {
+    // Setup
+    Delegate<int(int, int)> test_subject = Add;
+
+    // Exercise & Verify
+    CHECK(5 == test_subject(2, 3));
+  }
+
+  SECTION("Calls a capturing lambda")
+  {
+    // Setup
+    int calls                     = 0;
+    int * calls_pointer           = &calls;
+    Delegate<void()> test_subject = [&calls, calls_pointer]() {
+      calls++;
+      (*calls_pointer)++;
+    };
+
+    // Exercise
+    test_subject();
+
+    // Verify
+    CHECK(2 == calls);
+  }
+
+  SECTION("Mutable lambdas keep their state between calls")
+  {
+    // Setup
+    Delegate<int()> test_subject = [count = 0]() mutable { return ++count; };
+
+    // Exercise & Verify
+    CHECK(1 == test_subject());
+    CHECK(2 == test_subject());
+    CHECK(3 == test_subject());
+  }
+
+  SECTION("Copies are independent")
+  {
+    // Setup
+    Delegate<int()> original = [count = 0]() mutable { return ++count; };
+    original();
+
+    // Exercise
+    Delegate<int()> copy = original;
+    original             = nullptr;
+
+    // Verify
+    CHECK(!original);
+    CHECK(2 == copy());
+  }
+
+  SECTION("Larger capacity holds a nested delegate")
+  {
+    // Setup
+    using LargeDelegate = Delegate<void(), 4 * sizeof(void *)>;
+
+    int calls                  = 0;
+    Delegate<void()> inner     = [&calls]() { calls++; };
+    LargeDelegate test_subject = [inner]() { inner(); };
+
+    // Exercise
+    test_subject();
+
+    // Verify
+    CHECK(1 == calls);
+  }
+
+  SECTION("Target()")
+  {
+    // Setup
+    Delegate<void()> test_subject = FreeFunction;
+
+    // Exercise
+    auto * function_pointer = test_subject.Target<void (*)()>();
+    auto * wrong_type       = test_subject.Target<int (*)()>();
+
+    // Verify
+    REQUIRE(function_pointer != nullptr);
+    CHECK(&FreeFunction == *function_pointer);
+    CHECK(wrong_type == nullptr);
+  }
+}
+}  // namespace sjsu
@@ -0,0 +1,37 @@
+#include <chrono>
+#include <cstdint>
+
+#include "L4_Testing/benchmark.hpp"
+#include "utility/latency_recorder.hpp"
+
+namespace sjsu
+{
+BENCHMARK("LatencyRecorder::Record()")
+{
+  static LatencyRecorder recorder("benchmark");
+  uint64_t duration = 1;
+
+  for (auto _ : state)
+  {
+    // Spread durations over many buckets with a cheap pseudo random sequence.
+    duration = (duration * 6364136223846793005ULL) + 1442695040888963407ULL;
+    recorder.Record(std::chrono::nanoseconds(duration >> 40));
+  }
+
+  benchmark::DoNotOptimize(recorder.GetCount());
+}
+
+BENCHMARK("LatencyRecorder::GetPercentile()")
+{
+  static LatencyRecorder recorder("benchmark");
+  for (uint32_t i = 0; i < 10'000; i++)
+  {
+    recorder.Record(std::chrono::nanoseconds(i * 1'000));
+  }
+
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(recorder.GetPercentile(99.9f));
+  }
+}
+}  // namespace sjsu
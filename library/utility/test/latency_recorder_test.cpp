@@ -0,0 +1,168 @@
+#include <cstdint>
+#include <cstring>
+
+#include "L4_Testing/testing_frameworks.hpp"
+#include "utility/latency_recorder.hpp"
+
+namespace sjsu
+{
+TEST_CASE("Testing LatencyRecorder")
+{
+  LatencyRecorder test_subject("test");
+
+  SECTION("Empty recorder")
+  {
+    // Verify
+    CHECK(0 == strcmp(test_subject.GetName(), "test"));
+    CHECK(0 == test_subject.GetCount());
+    CHECK(0ns == test_subject.GetMin());
+    CHECK(0ns == test_subject.GetMax());
+    CHECK(0ns == test_subject.GetMean());
+    CHECK(0ns == test_subject.GetPercentile(50));
+  }
+
+  SECTION("Bucket boundaries")
+  {
+    // Verify: Small durations each have their own bucket
+    for (uint64_t i = 0; i < 2 * LatencyRecorder::kSubBuckets; i++)
+    {
+      CHECK(i == LatencyRecorder::BucketIndex(i));
+      CHECK(i == LatencyRecorder::BucketLowerBound(i));
+      CHECK(1 == LatencyRecorder::BucketWidth(i));
+    }
+
+    // Verify: Buckets are contiguous and every duration falls in its bucket
+    for (size_t i = 1; i < LatencyRecorder::kBucketCount; i++)
+    {
+      uint64_t lower = LatencyRecorder::BucketLowerBound(i);
+      uint64_t upper = lower + LatencyRecorder::BucketWidth(i) - 1;
+      CHECK(lower == LatencyRecorder::BucketLowerBound(i - 1) +
+                         LatencyRecorder::BucketWidth(i - 1));
+      CHECK(i == LatencyRecorder::BucketIndex(lower));
+      CHECK(i == LatencyRecorder::BucketIndex(upper));
+    }
+
+    // Verify: Relative error of each bucket is bounded
+    for (size_t i = LatencyRecorder::kSubBuckets;
+         i < LatencyRecorder::kBucketCount; i++)
+    {
+      CHECK(LatencyRecorder::BucketWidth(i) * LatencyRecorder::kSubBuckets <=
+            LatencyRecorder::BucketLowerBound(i));
+    }
+
+    // Verify: Durations beyond the trackable range share the last bucket
+    CHECK(LatencyRecorder::kBucketCount - 1 ==
+          LatencyRecorder::BucketIndex(LatencyRecorder::kMaxTrackable.count()));
+    CHECK(LatencyRecorder::kBucketCount - 1 ==
+          LatencyRecorder::BucketIndex(UINT64_MAX));
+  }
+
+  SECTION("Statistics")
+  {
+    // Exercise: Record 1us to 1000us
+    for (int i = 1; i <= 1000; i++)
+    {
+      test_subject.Record(std::chrono::microseconds(i));
+    }
+
+    // Verify
+    CHECK(1000 == test_subject.GetCount());
+    CHECK(1us == test_subject.GetMin());
+    CHECK(1000us == test_subject.GetMax());
+    CHECK(500'500ns == test_subject.GetMean());
+
+    // Verify: Percentiles are within the bucket precision of the exact value
+    constexpr double kPrecision = 1.0 / LatencyRecorder::kSubBuckets;
+    auto p50                    = test_subject.GetPercentile(50);
+    auto p99                    = test_subject.GetPercentile(99);
+    auto p999                   = test_subject.GetPercentile(99.9f);
+    CHECK(500us <= p50);
+    CHECK(p50.count() <= 500'000 * (1 + kPrecision));
+    CHECK(990us <= p99);
+    CHECK(p99 <= 1000us);
+    CHECK(999us <= p999);
+    CHECK(p999 <= 1000us);
+    CHECK(1000us == test_subject.GetPercentile(100));
+    CHECK(1us == test_subject.GetPercentile(0));
+  }
+
+  SECTION("Exact values below the sub bucket count")
+  {
+    // Exercise
+    test_subject.Record(3ns);
+    test_subject.Record(5ns);
+    test_subject.Record(7ns);
+    test_subject.Record(-10ns);
+
+    // Verify
+    CHECK(0ns == test_subject.GetMin());
+    CHECK(3ns == test_subject.GetPercentile(50));
+    CHECK(7ns == test_subject.GetPercentile(100));
+    CHECK(1 == test_subject.GetBuckets()[0]);
+    CHECK(1 == test_subject.GetBuckets()[5]);
+  }
+
+  SECTION("Durations beyond the trackable range")
+  {
+    // Exercise
+    test_subject.Record(10s);
+
+    // Verify
+    CHECK(10s == test_subject.GetMax());
+    CHECK(10s == test_subject.GetPercentile(100));
+    CHECK(1 == test_subject.GetBuckets().back());
+  }
+
+  SECTION("Merge")
+  {
+    // Setup
+    LatencyRecorder other("other");
+    test_subject.Record(10us);
+    test_subject.Record(20us);
+    other.Record(5us);
+    other.Record(40us);
+
+    // Exercise
+    test_subject.Merge(other);
+
+    // Verify
+    CHECK(4 == test_subject.GetCount());
+    CHECK(5us == test_subject.GetMin());
+    CHECK(40us == test_subject.GetMax());
+    CHECK(18'750ns == test_subject.GetMean());
+    CHECK(2 == other.GetCount());
+  }
+
+  SECTION("Reset")
+  {
+    // Setup
+    test_subject.Record(10us);
+
+    // Exercise
+    test_subject.Reset();
+
+    // Verify
+    CHECK(0 == test_subject.GetCount());
+    CHECK(0ns == test_subject.GetMax());
+    CHECK(0ns == test_subject.GetMin());
+    CHECK(0 == test_subject.GetBuckets()[LatencyRecorder::BucketIndex(10'000)]);
+  }
+
+  SECTION("Start() and Stop() record the time between them")
+  {
+    // Setup
+    SetUptimeFunction(DefaultUptime);
+    test_subject.Calibrate();
+
+    // Exercise
+    test_subject.Start();
+    Delay(100us);
+    auto duration = test_subject.Stop();
+
+    // Verify
+    CHECK(100us == duration);
+    CHECK(1 == test_subject.GetCount());
+    CHECK(100us == test_subject.GetMax());
+  }
+}
+}  // namespace sjsu
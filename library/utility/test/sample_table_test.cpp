@@ -0,0 +1,85 @@
+#include "utility/sample_table.hpp"
+#include "L4_Testing/testing_frameworks.hpp"
+
+namespace sjsu
+{
+TEST_CASE("Testing SampleTable")
+{
+  SampleTable<16> test_subject;
+
+  SECTION("Counts samples of each address")
+  {
+    // Exercise
+    test_subject.Record(0x1000);
+    test_subject.Record(0x2000);
+    test_subject.Record(0x1000);
+
+    // Verify
+    CHECK(3 == test_subject.GetTotal());
+    CHECK(0 == test_subject.GetDropped());
+    CHECK(2 == test_subject.GetUniqueCount());
+    CHECK(2 == test_subject.GetCount(0x1000));
+    CHECK(1 == test_subject.GetCount(0x2000));
+    CHECK(0 == test_subject.GetCount(0x3000));
+  }
+
+  SECTION("GetTop() ranks by count, then by address")
+  {
+    // Setup
+    for (int i = 0; i < 3; i++)
+    {
+      test_subject.Record(0x3000);
+    }
+    test_subject.Record(0x2000);
+    test_subject.Record(0x1000);
+
+    // Exercise & Verify
+    CHECK(0x3000 == test_subject.GetTop(0).address);
+    CHECK(3 == test_subject.GetTop(0).count);
+    CHECK(0x1000 == test_subject.GetTop(1).address);
+    CHECK(0x2000 == test_subject.GetTop(2).address);
+    CHECK(0 == test_subject.GetTop(3).count);
+  }
+
+  SECTION("Drops samples of new addresses when full")
+  {
+    // Setup
+    for (uintptr_t address = 0; address < 16; address++)
+    {
+      REQUIRE(test_subject.Record(0x1000 + (address * 2)));
+    }
+
+    // Exercise & Verify
+    CHECK(!test_subject.Record(0x8000));
+    CHECK(test_subject.Record(0x1000));
+    CHECK(16 == test_subject.GetUniqueCount());
+    CHECK(18 == test_subject.GetTotal());
+    CHECK(1 == test_subject.GetDropped());
+    CHECK(2 == test_subject.GetCount(0x1000));
+  }
+
+  SECTION("Clear()")
+  {
+    // Setup
+    test_subject.Record(0x1000);
+
+    // Exercise
+    test_subject.Clear();
+
+    // Verify
+    CHECK(0 == test_subject.GetTotal());
+    CHECK(0 == test_subject.GetUniqueCount());
+    CHECK(0 == test_subject.GetCount(0x1000));
+    CHECK(0 == test_subject.GetTop(0).count);
+  }
+
+  SECTION("Print()")
+  {
+    // Setup
+    test_subject.Record(0x1000);
+
+    // Exercise & Verify
+    test_subject.Print();
+  }
+}
+}  // namespace sjsu
@@ -1,4 +1,5 @@
 #include <cstdint>
+#include <functional>
 #include <limits>
 
 #include "L4_Testing/testing_frameworks.hpp"
@@ -26,11 +27,11 @@ TEST_CASE("Testing Time Utility")
   SECTION("SetUptimeFunction()")
   {
     // Setup
-    bool uptime_was_set        = false;
-    const auto kExpectedUptime = 11984us;
+    static bool uptime_was_set            = false;
+    static constexpr auto kExpectedUptime = 11984us;
 
     // Exercise
-    SetUptimeFunction([&uptime_was_set, kExpectedUptime]() {
+    SetUptimeFunction([]() -> std::chrono::nanoseconds {
       uptime_was_set = true;
       return kExpectedUptime;
     });
@@ -98,6 +99,29 @@ TEST_CASE("Testing Time Utility")
     CHECK((current_timestamp + 4us + timeout_time) != final_uptime);
   }
 
+  SECTION("Wait() accepts any callable")
+  {
+    // Setup
+    SetUptimeFunction(DefaultUptime);
+    struct CountDown
+    {
+      bool operator()()
+      {
+        return --remaining == 0;
+      }
+      int remaining;
+    };
+    std::function<bool()> type_erased = []() { return true; };
+
+    // Exercise
+    Status functor_status     = Wait(500us, CountDown{ .remaining = 3 });
+    Status type_erased_status = Wait(500us, type_erased);
+
+    // Verify
+    CHECK(functor_status == Status::kSuccess);
+    CHECK(type_erased_status == Status::kSuccess);
+  }
+
   SECTION("Wait() max time")
   {
     // Setup
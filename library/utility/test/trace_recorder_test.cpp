@@ -0,0 +1,118 @@
+#include <cstdint>
+
+#include "L4_Testing/testing_frameworks.hpp"
+#include "utility/trace_recorder.hpp"
+
+namespace sjsu::trace
+{
+TEST_CASE("Testing trace Recorder")
+{
+  Recorder<4> test_subject;
+
+  SECTION("Does not record until started")
+  {
+    // Exercise
+    test_subject.Record(Type::kBegin, 1);
+
+    // Verify
+    CHECK(!test_subject.IsRunning());
+    CHECK(0 == test_subject.Size());
+  }
+
+  SECTION("Records events in order with increasing timestamps")
+  {
+    // Setup
+    test_subject.Start();
+
+    // Exercise
+    test_subject.Record(Type::kInterruptEnter, 5);
+    test_subject.Record(Type::kInterruptExit, 5);
+    test_subject.Stop();
+    test_subject.Record(Type::kBegin, 1);
+
+    // Verify
+    REQUIRE(2 == test_subject.Size());
+    CHECK(0 == test_subject.GetOverwritten());
+    CHECK(Type::kInterruptEnter == test_subject.GetEvent(0).type);
+    CHECK(5 == test_subject.GetEvent(0).argument);
+    CHECK(Type::kInterruptExit == test_subject.GetEvent(1).type);
+    CHECK(test_subject.GetEvent(0).timestamp <
+          test_subject.GetEvent(1).timestamp);
+  }
+
+  SECTION("Overwrites the oldest events when full")
+  {
+    // Setup
+    test_subject.Start();
+
+    // Exercise
+    for (uintptr_t i = 0; i < 6; i++)
+    {
+      test_subject.Record(Type::kBegin, i);
+    }
+
+    // Verify
+    REQUIRE(4 == test_subject.Size());
+    CHECK(2 == test_subject.GetOverwritten());
+    CHECK(2 == test_subject.GetEvent(0).argument);
+    CHECK(3 == test_subject.GetEvent(1).argument);
+    CHECK(4 == test_subject.GetEvent(2).argument);
+    CHECK(5 == test_subject.GetEvent(3).argument);
+  }
+
+  SECTION("Clear()")
+  {
+    // Setup
+    test_subject.Start();
+    test_subject.Record(Type::kBegin, 1);
+
+    // Exercise
+    test_subject.Clear();
+
+    // Verify
+    CHECK(0 == test_subject.Size());
+    CHECK(0 == test_subject.GetOverwritten());
+    CHECK(test_subject.IsRunning());
+  }
+
+  SECTION("Dump()")
+  {
+    // Setup
+    test_subject.Start();
+    test_subject.Record(Type::kTaskSwitch, reinterpret_cast<uintptr_t>("main"));
+    test_subject.Record(Type::kInterruptEnter, static_cast<uintptr_t>(-1));
+    test_subject.Record(Type::kInterruptExit, static_cast<uintptr_t>(-1));
+    test_subject.Stop();
+
+    // Exercise & Verify
+    test_subject.Dump();
+  }
+}
+
+TEST_CASE("Testing SJ2_TRACE_SCOPE")
+{
+  // Setup
+  const char * const kName = "scope";
+  recorder.Clear();
+  recorder.Start();
+
+  // Exercise
+  {
+    SJ2_TRACE_SCOPE(kName);
+    Record(Type::kInterruptEnter, -1);
+  }
+  recorder.Stop();
+
+  // Verify
+  REQUIRE(3 == recorder.Size());
+  CHECK(Type::kBegin == recorder.GetEvent(0).type);
+  CHECK(reinterpret_cast<uintptr_t>(kName) == recorder.GetEvent(0).argument);
+  CHECK(Type::kInterruptEnter == recorder.GetEvent(1).type);
+  CHECK(-1 == static_cast<intptr_t>(recorder.GetEvent(1).argument));
+  CHECK(Type::kEnd == recorder.GetEvent(2).type);
+  CHECK(reinterpret_cast<uintptr_t>(kName) == recorder.GetEvent(2).argument);
+
+  // Cleanup
+  recorder.Clear();
+}
+}  // namespace sjsu::trace
@@ -8,14 +8,18 @@
 #include "utility/test/build_info_test.cpp"           // NOLINT
 #include "utility/test/constexpr_test.cpp"            // NOLINT
 #include "utility/test/crc_test.cpp"                  // NOLINT
+#include "utility/test/delegate_test.cpp"             // NOLINT
 #include "utility/test/enum_test.cpp"                 // NOLINT
 #include "utility/test/infrared_algorithms_test.cpp"  // NOLINT
+#include "utility/test/latency_recorder_test.cpp"     // NOLINT
 #include "utility/test/map_test.cpp"                  // NOLINT
 #include "utility/test/rtos_test.cpp"                 // NOLINT
+#include "utility/test/sample_table_test.cpp"         // NOLINT
 #include "utility/test/status_test.cpp"               // NOLINT
 #include "utility/test/stopwatch_test.cpp"            // NOLINT
 #include "utility/test/time_test.cpp"                 // NOLINT
 #include "utility/test/timeout_timer_test.cpp"        // NOLINT
+#include "utility/test/trace_recorder_test.cpp"       // NOLINT
 // TODO(#1277): Add debug test back
 // #include "utility/test/debug_test.cpp"  // NOLINT
 
@@ -31,4 +35,5 @@
 #include "utility/containers/test/string_test.cpp"  // NOLINT
 #include "utility/containers/test/vector_test.cpp"  // NOLINT
 #include "utility/containers/test/list_test.cpp"    // NOLINT
-#include "utility/containers/test/deque_test.cpp"   // NOLINT
\ No newline at end of file
+#include "utility/containers/test/deque_test.cpp"   // NOLINT
+#include "utility/containers/test/mpsc_queue_test.cpp"  // NOLINT
\ No newline at end of file
@@ -2,7 +2,7 @@
 
 #include <cstdint>
 #include <cinttypes>
-#include <functional>
+#include <chrono>
 #include <cstdio>
 
 #include "utility/macros.hpp"
@@ -12,8 +12,10 @@
 
 namespace sjsu
 {
-/// Definition of an UptimeFunction
-using UptimeFunction = std::function<std::chrono::nanoseconds(void)>;
+/// Definition of an UptimeFunction. A plain function pointer is used, rather
+/// than std::function, so that reading the uptime is a single indirect call
+/// that never allocates.
+using UptimeFunction = std::chrono::nanoseconds (*)();
 
 /// A default uptime function that is used for testing or platforms without a
 /// means to keep time. It should not be used in production.
@@ -27,17 +29,28 @@ inline std::chrono::nanoseconds DefaultUptime()
   return default_uptime;
 }
 
-/// Global Uptime function, preset to DefaultUptime() for testing purposes.
-/// In general, this function is overwritten by
-inline UptimeFunction Uptime = DefaultUptime;  // NOLINT
+namespace internal
+{
+/// The current system wide uptime function. Preset to DefaultUptime() for
+/// testing purposes and overwritten by the platform's startup code. Use
+/// SetUptimeFunction() to change it.
+inline UptimeFunction uptime_function = DefaultUptime;  // NOLINT
+}  // namespace internal
+
+/// @return the system uptime in nanoseconds.
+inline std::chrono::nanoseconds Uptime()
+{
+  return internal::uptime_function();
+}
 
-/// Returns the system uptime in nanoseconds, do not use this function directly
+/// Set the system wide uptime function used by Uptime().
 ///
 /// @param uptime_function - new system wide uptime function to override the
-///        previous one.
+///        previous one. Lambdas without captures are implicitly converted to
+///        UptimeFunction.
 inline void SetUptimeFunction(UptimeFunction uptime_function)
 {
-  Uptime = uptime_function;
+  internal::uptime_function = uptime_function;
 }
 
 /// Wait will until the is_done parameter returns true
@@ -45,9 +58,11 @@ inline void SetUptimeFunction(UptimeFunction uptime_function)
 /// @param timeout the maximum amount of time to wait for the is_done to
 ///        return true.
 /// @param is_done will be run in a tight loop until it returns true or the
-///        timeout time has elapsed.
-inline Status Wait(std::chrono::nanoseconds timeout,
-                   std::function<bool()> is_done)
+///        timeout time has elapsed. Any callable returning bool may be used.
+///        It is taken by value so that it can be inlined into the loop rather
+///        than being called through a type erased wrapper.
+template <typename IsDone>
+inline Status Wait(std::chrono::nanoseconds timeout, IsDone is_done)
 {
   std::chrono::nanoseconds timeout_time;
   if (timeout == std::chrono::nanoseconds::max())
@@ -0,0 +1,260 @@
+// Usage:
+//
+//    // In project_config.hpp
+//    #define SJ2_ENABLE_TRACE true
+//
+//    void ReadSensors()
+//    {
+//      SJ2_TRACE_SCOPE("ReadSensors");
+//      ...
+//    }
+//
+//    sjsu::trace::recorder.Start();
+//    ...
+//    sjsu::trace::recorder.Stop();
+//    sjsu::trace::recorder.Dump();
+//
+// Task switches and interrupts are recorded automatically. Convert the dump,
+// from a UART log or the output of a linux build, into a Chrome trace with:
+//
+//    python3 tools/trace/trace_to_chrome.py uart.log -o trace.json
+//
+// Then open trace.json in chrome://tracing or https://ui.perfetto.dev.
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#include "config.hpp"
+#include "utility/macros.hpp"
+#include "utility/time.hpp"
+
+namespace sjsu
+{
+/// Timeline tracing of task switches, interrupts and user defined spans.
+namespace trace
+{
+/// Kinds of events that can be recorded.
+enum class Type : uint8_t
+{
+  /// A task started running. The argument is the task's name.
+  kTaskSwitch,
+  /// An interrupt handler started. The argument is the interrupt's number.
+  kInterruptEnter,
+  /// An interrupt handler returned. The argument is the interrupt's number.
+  kInterruptExit,
+  /// A span started. The argument is the span's name.
+  kBegin,
+  /// A span ended. The argument is the span's name.
+  kEnd,
+};
+
+/// A single recorded event.
+struct Event_t
+{
+  /// Uptime in nanoseconds when the event was recorded.
+  uint64_t timestamp;
+  /// Name or interrupt number, depending on the type of the event. Names must
+  /// point to strings that outlive the recorder, such as string literals.
+  uintptr_t argument;
+  /// Kind of event.
+  Type type;
+};
+
+/// Records events into a fixed size ring buffer. When the buffer is full, the
+/// oldest events are overwritten, so the buffer always holds the most recent
+/// kCapacity events.
+///
+/// Record() may be called from any task or interrupt, including nested
+/// interrupts. Each call claims its slot with a single atomic increment and
+/// never blocks or disables interrupts.
+///
+/// @tparam kCapacity - number of events the buffer holds. Must be a power of
+///         two.
+template <size_t kCapacity>
+class Recorder
+{
+ public:
+  static_assert(kCapacity >= 2 && (kCapacity & (kCapacity - 1)) == 0,
+                "Recorder capacity must be a power of two.");
+
+  /// Start recording events.
+  void Start()
+  {
+    running_.store(true, std::memory_order_relaxed);
+  }
+
+  /// Stop recording events. The recorded events are kept.
+  void Stop()
+  {
+    running_.store(false, std::memory_order_relaxed);
+  }
+
+  /// @return true if events are being recorded.
+  bool IsRunning() const
+  {
+    return running_.load(std::memory_order_relaxed);
+  }
+
+  /// Discard every recorded event.
+  void Clear()
+  {
+    head_.store(0, std::memory_order_relaxed);
+  }
+
+  /// Record an event, stamped with the current uptime, if the recorder is
+  /// running.
+  ///
+  /// @param type - kind of event.
+  /// @param argument - name or interrupt number of the event.
+  void Record(Type type, uintptr_t argument)
+  {
+    if (!IsRunning())
+    {
+      return;
+    }
+
+    uint32_t index  = head_.fetch_add(1, std::memory_order_relaxed);
+    Event_t & event = events_[index & kMask];
+    event.timestamp = static_cast<uint64_t>(Uptime().count());
+    event.argument  = argument;
+    event.type      = type;
+  }
+
+  /// @return the number of events held in the buffer.
+  size_t Size() const
+  {
+    uint32_t head = head_.load(std::memory_order_relaxed);
+    return (head < kCapacity) ? head : kCapacity;
+  }
+
+  /// @return the number of events that were overwritten because the buffer
+  ///         was full.
+  size_t GetOverwritten() const
+  {
+    return head_.load(std::memory_order_relaxed) - Size();
+  }
+
+  /// @param position - position of the event, where 0 is the oldest event
+  ///        in the buffer. Must be less than Size().
+  /// @return the event at that position.
+  const Event_t & GetEvent(size_t position) const
+  {
+    uint32_t oldest = head_.load(std::memory_order_relaxed) -
+                      static_cast<uint32_t>(Size());
+    return events_[(oldest + position) & kMask];
+  }
+
+  /// Print every event in the buffer, oldest first, in the text format read by
+  /// tools/trace/trace_to_chrome.py. Stop() the recorder first, otherwise
+  /// events recorded during the dump may overwrite the ones being printed.
+  void Dump() const
+  {
+    printf("--- sjsu-trace begin ---\n");
+    for (size_t i = 0; i < Size(); i++)
+    {
+      const Event_t & event = GetEvent(i);
+      switch (event.type)
+      {
+        case Type::kTaskSwitch: PrintName(event, 'S'); break;
+        case Type::kInterruptEnter: PrintNumber(event, 'I'); break;
+        case Type::kInterruptExit: PrintNumber(event, 'i'); break;
+        case Type::kBegin: PrintName(event, 'B'); break;
+        case Type::kEnd: PrintName(event, 'E'); break;
+      }
+    }
+    printf("--- sjsu-trace end ---\n");
+  }
+
+ private:
+  static constexpr uint32_t kMask = kCapacity - 1;
+
+  static void PrintName(const Event_t & event, char code)
+  {
+    const char * name = reinterpret_cast<const char *>(event.argument);
+    printf("%" PRIu64 " %c %s\n", event.timestamp, code, name);
+  }
+
+  static void PrintNumber(const Event_t & event, char code)
+  {
+    int number = static_cast<int>(static_cast<intptr_t>(event.argument));
+    printf("%" PRIu64 " %c %d\n", event.timestamp, code, number);
+  }
+
+  std::array<Event_t, kCapacity> events_ = {};
+  std::atomic<uint32_t> head_            = 0;
+  std::atomic<bool> running_             = false;
+};
+
+/// Type of the recorder that the trace hooks record into.
+using SystemRecorder = Recorder<config::kTraceBufferSize>;
+
+/// The recorder that task switches, interrupts and SJ2_TRACE_SCOPE() spans are
+/// recorded into.
+inline SystemRecorder recorder;  // NOLINT
+
+/// Record an event into the system recorder. Compiles to nothing if
+/// SJ2_ENABLE_TRACE is false.
+///
+/// @param type - kind of event.
+/// @param argument - name or interrupt number of the event.
+inline void Record(Type type, uintptr_t argument)
+{
+  if constexpr (config::kEnableTrace)
+  {
+    recorder.Record(type, argument);
+  }
+}
+
+/// Record an event with a name into the system recorder.
+///
+/// @param type - kind of event.
+/// @param name - name of the event. Must outlive the recorder.
+inline void Record(Type type, const char * name)
+{
+  Record(type, reinterpret_cast<uintptr_t>(name));
+}
+
+/// Record an event with an interrupt number into the system recorder.
+///
+/// @param type - kind of event.
+/// @param interrupt_request_number - interrupt number of the event.
+inline void Record(Type type, int interrupt_request_number)
+{
+  Record(type, static_cast<uintptr_t>(interrupt_request_number));
+}
+
+/// Records a span covering the lifetime of this object. Use SJ2_TRACE_SCOPE()
+/// rather than constructing one directly.
+class Scope
+{
+ public:
+  /// @param name - name of the span. Must outlive the recorder, such as a
+  ///        string literal.
+  explicit Scope(const char * name) : name_(name)
+  {
+    Record(Type::kBegin, name_);
+  }
+
+  ~Scope()
+  {
+    Record(Type::kEnd, name_);
+  }
+
+  Scope(const Scope &) = delete;
+  Scope & operator=(const Scope &) = delete;
+
+ private:
+  const char * name_;
+};
+}  // namespace trace
+}  // namespace sjsu
+
+/// Record a span named `name` from this line to the end of the enclosing scope.
+/// Compiles to nothing if SJ2_ENABLE_TRACE is false.
+#define SJ2_TRACE_SCOPE(name) \
+  const sjsu::trace::Scope SJ2_CONCAT(sj2_trace_scope_, __LINE__)(name)
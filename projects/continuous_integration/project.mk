@@ -9,3 +9,10 @@ TESTS += $(LIBRARY_DIR)/L1_Peripheral/test/unity_test.cpp
 TESTS += $(LIBRARY_DIR)/L2_HAL/test/unity_test.cpp
 TESTS += $(LIBRARY_DIR)/L3_Application/test/unity_test.cpp
 TESTS += $(LIBRARY_DIR)/utility/test/unity_test.cpp
+
+# ==============================================================================
+# BENCHMARKS
+# ==============================================================================
+
+BENCHMARKS += $(shell find $(LIBRARY_DIR) -name "*_benchmark.cpp" \
+                -not -path "*/third_party/*")
@@ -5,5 +5,6 @@
 
 #define SJ2_LOG_LEVEL SJ2_LOG_LEVEL_ERROR
 #define SJ2_AUTOMATICALLY_PRINT_ON_ERROR false
+#define SJ2_ENABLE_TRACE true
 
 #include "config.hpp"
@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+"""Convert an SJSU-Dev2 trace dump into the Chrome trace event format.
+
+A dump is the text printed by sjsu::trace::Recorder::Dump(), or by the "trace
+dump" command, between the "--- sjsu-trace begin ---" and
+"--- sjsu-trace end ---" lines. Anything outside of those lines, such as the
+rest of a UART log, is ignored. If the input holds more than one dump, the last
+one is converted.
+
+Open the resulting JSON file in chrome://tracing or https://ui.perfetto.dev.
+
+Usage:
+
+    python3 tools/trace/trace_to_chrome.py uart.log -o trace.json
+    ./build/application.elf | python3 tools/trace/trace_to_chrome.py > trace.json
+"""
+
+import argparse
+import json
+import sys
+
+BEGIN_MARKER = "--- sjsu-trace begin ---"
+END_MARKER = "--- sjsu-trace end ---"
+
+PROCESS_ID = 0
+# Track showing which task is running.
+CPU_TRACK = 0
+# Track holding interrupt handlers and the spans recorded inside of them.
+INTERRUPT_TRACK = 1
+# Track for work done before the scheduler starts, or without an RTOS.
+MAIN_TRACK = 2
+
+
+def extract_dump(lines):
+    """Return the event lines of the last complete dump in lines."""
+    dump = None
+    current = None
+    for line in lines:
+        line = line.strip()
+        if line == BEGIN_MARKER:
+            current = []
+        elif line == END_MARKER and current is not None:
+            dump = current
+            current = None
+        elif current is not None and line:
+            current.append(line)
+    if dump is None:
+        raise ValueError("no complete sjsu-trace dump found in the input")
+    return dump
+
+
+def parse_event(line):
+    """Split an event line into (timestamp_ns, code, argument)."""
+    fields = line.split(" ", 2)
+    if len(fields) != 3:
+        raise ValueError("malformed trace event: '%s'" % line)
+    return int(fields[0]), fields[1], fields[2]
+
+
+class Converter:
+    """Builds a list of Chrome trace events from sjsu-trace events."""
+
+    def __init__(self):
+        self.events = []
+        self.tracks = {}
+        self.start_ns = None
+        self.current_track = MAIN_TRACK
+        self.running_task = None
+        self.running_since = 0.0
+        self.interrupt_depth = 0
+        self.name_track(CPU_TRACK, "CPU")
+        self.name_track(INTERRUPT_TRACK, "Interrupts")
+        self.name_track(MAIN_TRACK, "(no task)")
+
+    def name_track(self, track, name):
+        self.events.append({
+            "name": "thread_name",
+            "ph": "M",
+            "pid": PROCESS_ID,
+            "tid": track,
+            "args": {"name": name},
+        })
+        self.events.append({
+            "name": "thread_sort_index",
+            "ph": "M",
+            "pid": PROCESS_ID,
+            "tid": track,
+            "args": {"sort_index": track},
+        })
+
+    def task_track(self, name):
+        if name not in self.tracks:
+            track = MAIN_TRACK + 1 + len(self.tracks)
+            self.tracks[name] = track
+            self.name_track(track, name)
+        return self.tracks[name]
+
+    def context_track(self):
+        if self.interrupt_depth > 0:
+            return INTERRUPT_TRACK
+        return self.current_track
+
+    def add(self, phase, name, timestamp, track, **extra):
+        event = {
+            "name": name,
+            "ph": phase,
+            "ts": timestamp,
+            "pid": PROCESS_ID,
+            "tid": track,
+        }
+        event.update(extra)
+        self.events.append(event)
+
+    def end_running_task(self, timestamp):
+        if self.running_task is not None:
+            self.add("X", self.running_task, self.running_since, CPU_TRACK,
+                     dur=timestamp - self.running_since)
+
+    def convert(self, timestamp_ns, code, argument):
+        if self.start_ns is None:
+            self.start_ns = timestamp_ns
+        # Chrome trace timestamps are in microseconds.
+        timestamp = (timestamp_ns - self.start_ns) / 1000.0
+
+        if code == "S":
+            self.end_running_task(timestamp)
+            self.running_task = argument
+            self.running_since = timestamp
+            self.current_track = self.task_track(argument)
+        elif code == "I":
+            self.interrupt_depth += 1
+            self.add("B", "IRQ " + argument, timestamp, INTERRUPT_TRACK)
+        elif code == "i":
+            # Events before the start of the buffer may have been overwritten,
+            # so an exit can arrive without its entry.
+            if self.interrupt_depth > 0:
+                self.interrupt_depth -= 1
+                self.add("E", "IRQ " + argument, timestamp, INTERRUPT_TRACK)
+        elif code == "B":
+            self.add("B", argument, timestamp, self.context_track())
+        elif code == "E":
+            self.add("E", argument, timestamp, self.context_track())
+        else:
+            raise ValueError("unknown trace event code '%s'" % code)
+
+    def finish(self, timestamp_ns):
+        if self.start_ns is not None:
+            self.end_running_task((timestamp_ns - self.start_ns) / 1000.0)
+        return {"traceEvents": self.events, "displayTimeUnit": "ns"}
+
+
+def convert(lines):
+    """Convert the lines of a log holding a dump into a Chrome trace."""
+    converter = Converter()
+    last_timestamp = 0
+    for line in extract_dump(lines):
+        timestamp_ns, code, argument = parse_event(line)
+        converter.convert(timestamp_ns, code, argument)
+        last_timestamp = timestamp_ns
+    return converter.finish(last_timestamp)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Convert an SJSU-Dev2 trace dump into a Chrome trace.")
+    parser.add_argument("input", nargs="?", type=argparse.FileType("r"),
+                        default=sys.stdin,
+                        help="log holding the dump (default: stdin)")
+    parser.add_argument("-o", "--output", type=argparse.FileType("w"),
+                        default=sys.stdout,
+                        help="Chrome trace JSON file (default: stdout)")
+    arguments = parser.parse_args()
+
+    try:
+        trace = convert(arguments.input)
+    except ValueError as error:
+        sys.exit("error: %s" % error)
+
+    json.dump(trace, arguments.output)
+
+
+if __name__ == "__main__":
+    main()